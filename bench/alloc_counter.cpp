@@ -0,0 +1,67 @@
+// Replaces the global allocation functions so the harness can report heap
+// allocations per operation. Only linked into the benchmark executables.
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "bench_harness.h"
+
+namespace
+{
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> bytes{0};
+
+    void *countedAlloc(std::size_t size)
+    {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        bytes.fetch_add(size, std::memory_order_relaxed);
+        void *p = std::malloc(size == 0 ? 1 : size);
+        if (!p)
+        {
+            throw std::bad_alloc();
+        }
+        return p;
+    }
+
+    void *countedAlignedAlloc(std::size_t size, std::align_val_t align)
+    {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        bytes.fetch_add(size, std::memory_order_relaxed);
+        std::size_t alignment = static_cast<std::size_t>(align);
+        std::size_t rounded = (size + alignment - 1) / alignment * alignment;
+        void *p = std::aligned_alloc(alignment, rounded == 0 ? alignment : rounded);
+        if (!p)
+        {
+            throw std::bad_alloc();
+        }
+        return p;
+    }
+}
+
+uint64_t bench::allocationCount() { return allocations.load(std::memory_order_relaxed); }
+uint64_t bench::allocatedBytes() { return bytes.load(std::memory_order_relaxed); }
+
+void *operator new(std::size_t size) { return countedAlloc(size); }
+void *operator new[](std::size_t size) { return countedAlloc(size); }
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    try
+    {
+        return countedAlloc(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+void *operator new[](std::size_t size, const std::nothrow_t &tag) noexcept { return operator new(size, tag); }
+void *operator new(std::size_t size, std::align_val_t align) { return countedAlignedAlloc(size, align); }
+void *operator new[](std::size_t size, std::align_val_t align) { return countedAlignedAlloc(size, align); }
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
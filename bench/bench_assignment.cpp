@@ -0,0 +1,141 @@
+// Weapon-target assignment: auction solver against the greedy baseline on the same cost matrix,
+// and the batched intercept solver that produces its costs
+#include <random>
+#include <cmath>
+#include <memory>
+#include "bench_harness.h"
+#include "weapon_target_assignment.h"
+#include "intercept_solver.h"
+
+namespace
+{
+    struct AssignmentFixture
+    {
+        WeaponTargetAssigner assigner;
+        std::vector<double> costs;
+        size_t rows = 0;
+        size_t cols = 0;
+    };
+
+    // n threats against n interceptors scattered over the theater, cost = time to intercept
+    std::shared_ptr<AssignmentFixture> makeAssignment(size_t n)
+    {
+        auto fixture = std::make_shared<AssignmentFixture>();
+        std::mt19937 rng(13);
+        std::uniform_real_distribution<double> coord(-5000.0, 5000.0);
+        std::uniform_real_distribution<double> speed(80.0, 120.0);
+
+        std::vector<double> tx(n), ty(n), ix(n), iy(n), is(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            tx[i] = coord(rng);
+            ty[i] = coord(rng);
+            ix[i] = coord(rng);
+            iy[i] = coord(rng);
+            is[i] = speed(rng);
+        }
+
+        fixture->rows = n;
+        fixture->cols = n;
+        fixture->costs.resize(n * n);
+        for (size_t row = 0; row < n; ++row)
+        {
+            for (size_t col = 0; col < n; ++col)
+            {
+                fixture->costs[row * n + col] = std::hypot(tx[row] - ix[col], ty[row] - iy[col]) / is[col];
+            }
+        }
+        return fixture;
+    }
+
+    const std::vector<size_t> assignmentSizes = {10, 100, 1000};
+
+    bench::Registrar auction({"weapon_target_assignment", "solver=auction", assignmentSizes, [](size_t n)
+                              {
+                                  auto fixture = makeAssignment(n);
+                                  bench::Operation op;
+                                  op.run = [fixture]()
+                                  {
+                                      // Generous budget: measure the full solve, not the cutoff
+                                      fixture->assigner.solve(fixture->costs.data(), fixture->rows, fixture->cols,
+                                                              std::chrono::seconds(10));
+                                      bench::doNotOptimize(fixture->assigner.getAssignments().data());
+                                  };
+                                  op.itemsPerOp = static_cast<double>(n);
+                                  op.fixture = fixture;
+                                  op.counters = {{"total_cost", [fixture]()
+                                                  { return fixture->assigner.getTotalCost(); }},
+                                                 {"bids", [fixture]()
+                                                  { return static_cast<double>(fixture->assigner.getBidCount()); }}};
+                                  return op;
+                              }});
+
+    bench::Registrar greedy({"weapon_target_assignment", "solver=greedy", assignmentSizes, [](size_t n)
+                             {
+                                 auto fixture = makeAssignment(n);
+                                 bench::Operation op;
+                                 op.run = [fixture]()
+                                 {
+                                     fixture->assigner.solveGreedy(fixture->costs.data(), fixture->rows, fixture->cols);
+                                     bench::doNotOptimize(fixture->assigner.getAssignments().data());
+                                 };
+                                 op.itemsPerOp = static_cast<double>(n);
+                                 op.fixture = fixture;
+                                 op.counters = {{"total_cost", [fixture]()
+                                                 { return fixture->assigner.getTotalCost(); }}};
+                                 return op;
+                             }});
+
+    struct InterceptFixture
+    {
+        InterceptSolver solver;
+        std::vector<Position> positions;
+        std::vector<Position> velocities;
+        std::vector<double> horizons;
+        std::vector<double> times;
+    };
+
+    const size_t interceptorColumns = 100;
+
+    // n inbound threats against a 100-interceptor magazine, one batch solve per op
+    bench::Operation makeInterceptSolve(size_t n, InterceptSolver::Kernel kernel)
+    {
+        auto fixture = std::make_shared<InterceptFixture>();
+        std::mt19937 rng(19);
+        std::uniform_real_distribution<double> coord(-5000.0, 5000.0);
+        std::uniform_real_distribution<double> speed(40.0, 120.0);
+
+        fixture->solver.setKernel(kernel);
+        for (size_t i = 0; i < interceptorColumns; ++i)
+        {
+            fixture->solver.addInterceptor({coord(rng), coord(rng), 0.0}, speed(rng) + 40.0);
+        }
+        for (size_t i = 0; i < n; ++i)
+        {
+            Position position = {coord(rng), coord(rng), 0.0};
+            double step = speed(rng) / std::max(std::hypot(position.x, position.y), 1.0);
+            fixture->positions.push_back(position);
+            fixture->velocities.push_back({-position.x * step, -position.y * step, 0.0});
+            fixture->horizons.push_back(1.0 / step); // Inbound at the origin
+        }
+        fixture->times.resize(n * interceptorColumns);
+
+        bench::Operation op;
+        op.run = [fixture]()
+        {
+            fixture->solver.solve(fixture->positions.data(), fixture->velocities.data(), fixture->horizons.data(),
+                                  fixture->positions.size(), fixture->times.data());
+            bench::doNotOptimize(fixture->times.data());
+        };
+        op.itemsPerOp = static_cast<double>(n * interceptorColumns);
+        op.fixture = fixture;
+        return op;
+    }
+
+    const std::vector<size_t> interceptSizes = {10, 100, 1000, 10000};
+
+    bench::Registrar interceptScalar({"intercept_time_to_go", "kernel=scalar", interceptSizes, [](size_t n)
+                                      { return makeInterceptSolve(n, InterceptSolver::Kernel::Scalar); }});
+    bench::Registrar interceptAuto({"intercept_time_to_go", "kernel=auto", interceptSizes, [](size_t n)
+                                    { return makeInterceptSolve(n, InterceptSolver::Kernel::Auto); }});
+}
@@ -0,0 +1,133 @@
+// MissileController hot paths: threat prioritization, auto-intercept, inventory lookup/removal
+// and the inventory copy every pipelined tick hands to the render stage
+#include <memory>
+#include <random>
+#include <climits>
+#include <algorithm>
+#include "bench_harness.h"
+#include "bench_fixtures.h"
+
+namespace
+{
+    struct EngagementFixture
+    {
+        MissileController controller;
+        std::vector<ThreatReport> threats;
+        std::vector<ThreatReport> working; // Sorted in place, refilled from `threats` each op
+    };
+
+    bench::Registrar prioritize({"prioritize_threats", "", bench::decades(), [](size_t n)
+                                 {
+                                     auto fixture = std::make_shared<EngagementFixture>();
+                                     fixture->threats = bench::makeThreats(n);
+                                     bench::Operation op;
+                                     op.run = [fixture]()
+                                     {
+                                         fixture->working.assign(fixture->threats.begin(), fixture->threats.end());
+                                         fixture->controller.prioritizeThreats(fixture->working);
+                                         bench::doNotOptimize(fixture->working.data());
+                                     };
+                                     op.itemsPerOp = static_cast<double>(n);
+                                     op.fixture = fixture;
+                                     return op;
+                                 }});
+
+    // Every call launches an interceptor, so the magazine bounds the iteration count
+    bench::Registrar autoIntercept({"auto_intercept_threats", "mode=greedy", bench::decades(), [](size_t n)
+                                    {
+                                        auto fixture = std::make_shared<EngagementFixture>();
+                                        fixture->threats = bench::makeThreats(n);
+                                        bench::fillMagazine(fixture->controller, n);
+                                        fixture->controller.setAssignmentMode(MissileController::AssignmentMode::Greedy);
+                                        fixture->controller.setAutoIntercept(true);
+                                        fixture->controller.setMaxAutoInterceptMissiles(INT_MAX);
+
+                                        bench::Operation op;
+                                        op.run = [fixture]()
+                                        {
+                                            fixture->working.assign(fixture->threats.begin(), fixture->threats.end());
+                                            const auto &engaged = fixture->controller.autoInterceptThreats(fixture->working);
+                                            bench::doNotOptimize(engaged.size());
+                                        };
+                                        op.itemsPerOp = static_cast<double>(n);
+                                        op.maxIterations = n;
+                                        op.fixture = fixture;
+                                        return op;
+                                    }});
+
+    struct LookupFixture
+    {
+        MissileController controller;
+        std::vector<int> ids;
+        size_t next = 0;
+    };
+
+    bench::Registrar lookup({"get_missile_by_id", "", bench::decades(), [](size_t n)
+                             {
+                                 auto fixture = std::make_shared<LookupFixture>();
+                                 bench::fillMagazine(fixture->controller, n);
+
+                                 // Look up IDs in a random order so the cost is the average, not the best case
+                                 std::mt19937 rng(11);
+                                 std::uniform_int_distribution<int> pick(1, static_cast<int>(n));
+                                 fixture->ids.resize(1024);
+                                 for (int &id : fixture->ids)
+                                 {
+                                     id = pick(rng);
+                                 }
+
+                                 bench::Operation op;
+                                 op.run = [fixture]()
+                                 {
+                                     int id = fixture->ids[fixture->next++ & 1023];
+                                     bench::doNotOptimize(fixture->controller.getMissileById(id));
+                                 };
+                                 op.fixture = fixture;
+                                 return op;
+                             }});
+
+    struct SnapshotFixture
+    {
+        MissileController controller;
+        std::vector<Missile> copy;
+    };
+
+    // What the engagement stage does for every world frame it publishes
+    bench::Registrar snapshot({"inventory_snapshot", "", bench::decades(), [](size_t n)
+                               {
+                                   auto fixture = std::make_shared<SnapshotFixture>();
+                                   bench::fillMagazine(fixture->controller, n);
+
+                                   bench::Operation op;
+                                   op.run = [fixture]()
+                                   {
+                                       fixture->copy = fixture->controller.getMissiles();
+                                       bench::doNotOptimize(fixture->copy.data());
+                                   };
+                                   op.itemsPerOp = static_cast<double>(n);
+                                   op.fixture = fixture;
+                                   return op;
+                               }});
+
+    // Removes the whole magazine in random order, one missile per op
+    bench::Registrar remove({"remove_missile_by_id", "", bench::decades(), [](size_t n)
+                             {
+                                 auto fixture = std::make_shared<LookupFixture>();
+                                 bench::fillMagazine(fixture->controller, n);
+                                 fixture->ids.resize(n);
+                                 for (size_t i = 0; i < n; ++i)
+                                 {
+                                     fixture->ids[i] = static_cast<int>(i + 1);
+                                 }
+                                 std::shuffle(fixture->ids.begin(), fixture->ids.end(), std::mt19937(17));
+
+                                 bench::Operation op;
+                                 op.run = [fixture]()
+                                 {
+                                     bench::doNotOptimize(fixture->controller.removeMissileById(fixture->ids[fixture->next++]));
+                                 };
+                                 op.maxIterations = n;
+                                 op.fixture = fixture;
+                                 return op;
+                             }});
+}
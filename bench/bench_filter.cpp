@@ -0,0 +1,86 @@
+// Batched Kalman filtering of noisy radar measurements
+#include <memory>
+#include <vector>
+#include "bench_harness.h"
+#include "measurement_noise.h"
+#include "scenario.h"
+#include "track_filter.h"
+#include "track_store.h"
+#include "detection_system.h"
+
+namespace
+{
+    // One scan's worth of measurements for n straight-line tracks, filtered
+    // over and over: measure every track, then one batch update
+    struct FilterFixture
+    {
+        TrackFilter filter;
+        std::vector<Position> measurements;
+        double time = 0.0;
+
+        FilterFixture(size_t n, TrackFilter::Kernel kernel) : filter(5.0), measurements(n)
+        {
+            filter.setKernel(kernel);
+            for (size_t i = 0; i < n; ++i)
+            {
+                measurements[i] = {static_cast<double>(i), 5.0 * uniformNoise(0, static_cast<int>(i), 0, 1), 0.0};
+            }
+            step();
+        }
+
+        void step()
+        {
+            for (size_t i = 0; i < measurements.size(); ++i)
+            {
+                filter.measure(static_cast<int>(i), measurements[i]);
+            }
+            filter.update(++time);
+        }
+    };
+
+    bench::Operation makeFilter(size_t n, TrackFilter::Kernel kernel)
+    {
+        auto fixture = std::make_shared<FilterFixture>(n, kernel);
+        bench::Operation op;
+        op.run = [fixture]() { fixture->step(); };
+        op.itemsPerOp = static_cast<double>(n);
+        op.fixture = fixture;
+        return op;
+    }
+
+    bench::Registrar filterScalar({"track_filter", "kernel=scalar", bench::decades(), [](size_t n)
+                                   { return makeFilter(n, TrackFilter::Kernel::Scalar); }});
+    bench::Registrar filterAuto({"track_filter", "kernel=auto", bench::decades(), [](size_t n)
+                                 { return makeFilter(n, TrackFilter::Kernel::Auto); }});
+
+    // The whole noisy scan: measurement noise, filtering and threat reports
+    struct NoisyScanFixture
+    {
+        Scenario scenario;
+        TrackStore enemies;
+        DetectionSystem radar;
+
+        explicit NoisyScanFixture(size_t n) : scenario(Scenario::makeSalvo(n, 0)), radar(enemies, scenario.targets)
+        {
+            for (const auto &enemy : scenario.enemies)
+            {
+                enemies.add(enemy);
+            }
+            radar.setMeasurementNoise(5.0);
+        }
+    };
+
+    bench::Registrar noisyScan({"detection_scan", "noise=5", bench::decades(), [](size_t n)
+                                {
+                                    auto fixture = std::make_shared<NoisyScanFixture>(n);
+                                    bench::Operation op;
+                                    op.run = [fixture]()
+                                    {
+                                        const auto &threats = fixture->radar.scanForThreats();
+                                        bench::doNotOptimize(threats.size());
+                                    };
+                                    op.itemsPerOp = static_cast<double>(n);
+                                    op.fixture = fixture;
+                                    return op;
+                                }});
+}
@@ -0,0 +1,56 @@
+#ifndef BENCH_FIXTURES_H
+#define BENCH_FIXTURES_H
+
+// Shared, deterministic test data for the benchmark cases
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include "scenario.h"
+#include "detection_system.h"
+#include "missile_controller.h"
+
+namespace bench
+{
+    // n synthetic threat reports, all inside the default auto-intercept threshold
+    inline std::vector<ThreatReport> makeThreats(size_t n, unsigned seed = 7)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> distance(0.0, 2000.0);
+        std::uniform_real_distribution<double> coord(-5000.0, 5000.0);
+
+        std::vector<ThreatReport> threats(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            ThreatReport &threat = threats[i];
+            threat.detectionId = static_cast<int>(i);
+            threat.enemyId = static_cast<int>(i);
+            threat.enemyNameId = 0;
+            threat.targetId = 1;
+            threat.distanceToTarget = distance(rng);
+            threat.calculatedSpeed = 60.0;
+            threat.enemyPosition = {coord(rng), coord(rng), 0.0};
+
+            // Inbound on the origin at the reported speed
+            double range = std::sqrt(threat.enemyPosition.x * threat.enemyPosition.x +
+                                     threat.enemyPosition.y * threat.enemyPosition.y);
+            double step = range > 0.0 ? threat.calculatedSpeed / range : 0.0;
+            threat.enemyVelocity = {-threat.enemyPosition.x * step, -threat.enemyPosition.y * step, 0.0};
+        }
+        return threats;
+    }
+
+    // A quiet controller holding n interceptors with IDs 1..n
+    inline void fillMagazine(MissileController &controller, size_t n)
+    {
+        Scenario scenario = Scenario::makeSalvo(0, n);
+        controller.setVerbose(false);
+        int missileId = 1;
+        for (const auto &config : scenario.interceptors)
+        {
+            controller.addMissile(Missile(missileId++, config.damage, config.name, config.speed, config.position));
+        }
+    }
+}
+
+#endif // BENCH_FIXTURES_H
@@ -0,0 +1,58 @@
+// Radar network: scanning with 50 sites and fusing their plots into system tracks
+#include <memory>
+#include "bench_harness.h"
+#include "scenario.h"
+#include "sensor_network.h"
+#include "track_store.h"
+
+namespace
+{
+    struct FusionFixture
+    {
+        Scenario scenario;
+        TrackStore enemies;
+        std::unique_ptr<SensorNetwork> network;
+        long tick = 0;
+
+        FusionFixture(size_t n, size_t radars) : scenario(Scenario::makeSalvo(n, 0))
+        {
+            // Wide enough to see the tracks where they spawn
+            scenario.addRadarNetwork(radars, 15000.0);
+            for (const auto &enemy : scenario.enemies)
+            {
+                enemies.add(enemy);
+            }
+            network = std::make_unique<SensorNetwork>(enemies, scenario.radars);
+            // Time steady tracking, not the first ticks that start every track
+            for (int warmup = 0; warmup < 3; ++warmup)
+            {
+                step();
+            }
+        }
+
+        size_t step()
+        {
+            enemies.moveAll();
+            return network->update(++tick).size();
+        }
+    };
+
+    bench::Registrar fusion({"track_fusion", "radars=50", {1000, 10000, 100000}, [](size_t n)
+                             {
+                                 auto fixture = std::make_shared<FusionFixture>(n, 50);
+                                 bench::Operation op;
+                                 op.run = [fixture]()
+                                 {
+                                     bench::doNotOptimize(fixture->step());
+                                 };
+                                 op.itemsPerOp = static_cast<double>(n);
+                                 // The salvo starts hitting its targets after about 50 ticks
+                                 op.maxIterations = 37;
+                                 op.fixture = fixture;
+                                 op.counters = {{"plots_per_op", [fixture]()
+                                                 { return static_cast<double>(fixture->network->getPlotCount()) / fixture->tick; }},
+                                                {"tag_switches", [fixture]()
+                                                 { return static_cast<double>(fixture->network->getFusion().getTagSwitches()); }}};
+                                 return op;
+                             }});
+}
@@ -0,0 +1,144 @@
+#include "bench_harness.h"
+#include <algorithm>
+#include <chrono>
+#include <ostream>
+#include <iomanip>
+
+namespace bench
+{
+    std::vector<size_t> decades(size_t maxSize)
+    {
+        std::vector<size_t> sizes;
+        for (size_t n = 10; n <= maxSize; n *= 10)
+        {
+            sizes.push_back(n);
+        }
+        return sizes;
+    }
+
+    std::vector<Case> &registry()
+    {
+        static std::vector<Case> cases;
+        return cases;
+    }
+
+    Registrar::Registrar(Case benchCase)
+    {
+        registry().push_back(std::move(benchCase));
+    }
+
+    Result runCase(const Case &benchCase, size_t n, double minSeconds)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        Operation op = benchCase.setup(n);
+
+        // One untimed call to warm caches and grow any reusable buffers
+        uint64_t budget = op.maxIterations;
+        if (budget > 1)
+        {
+            op.run();
+            --budget;
+        }
+
+        uint64_t allocsBefore = allocationCount();
+        uint64_t bytesBefore = allocatedBytes();
+        uint64_t iterations = 0;
+        double elapsed = 0.0;
+        auto start = Clock::now();
+
+        // Check the clock in growing batches so timing overhead stays out of fast operations
+        uint64_t batch = 1;
+        while (iterations < budget)
+        {
+            uint64_t thisBatch = std::min(batch, budget - iterations);
+            for (uint64_t i = 0; i < thisBatch; ++i)
+            {
+                op.run();
+            }
+            iterations += thisBatch;
+            elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+            if (elapsed >= minSeconds)
+            {
+                break;
+            }
+            batch *= 2;
+        }
+        uint64_t allocs = allocationCount() - allocsBefore;
+        uint64_t bytes = allocatedBytes() - bytesBefore;
+
+        Result result;
+        result.name = benchCase.name;
+        result.variant = benchCase.variant;
+        result.n = n;
+        result.iterations = iterations;
+        result.allocationFree = op.allocationFree;
+        if (iterations > 0 && elapsed > 0.0)
+        {
+            result.nsPerOp = elapsed * 1e9 / iterations;
+            result.opsPerSecond = iterations / elapsed;
+            result.itemsPerSecond = result.opsPerSecond * op.itemsPerOp;
+            result.allocsPerOp = static_cast<double>(allocs) / iterations;
+            result.bytesPerOp = static_cast<double>(bytes) / iterations;
+        }
+        for (const auto &counter : op.counters)
+        {
+            result.counters.emplace_back(counter.first, counter.second());
+        }
+        return result;
+    }
+
+    namespace
+    {
+        std::string escape(const std::string &text)
+        {
+            std::string out;
+            for (char c : text)
+            {
+                if (c == '"' || c == '\\')
+                {
+                    out += '\\';
+                }
+                out += c;
+            }
+            return out;
+        }
+    }
+
+    void writeJson(const std::vector<Result> &results, const std::vector<std::pair<std::string, std::string>> &context,
+                   std::ostream &out)
+    {
+        out << "{\n  \"context\": {";
+        for (size_t i = 0; i < context.size(); ++i)
+        {
+            out << (i == 0 ? "" : ", ") << "\"" << escape(context[i].first) << "\": \"" << escape(context[i].second) << "\"";
+        }
+        out << "},\n  \"results\": [";
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const Result &r = results[i];
+            out << (i == 0 ? "\n" : ",\n")
+                << "    {\"name\": \"" << escape(r.name) << "\""
+                << ", \"variant\": \"" << escape(r.variant) << "\""
+                << ", \"n\": " << r.n
+                << ", \"iterations\": " << r.iterations
+                << std::setprecision(6) << std::defaultfloat
+                << ", \"ns_per_op\": " << r.nsPerOp
+                << ", \"ops_per_sec\": " << r.opsPerSecond
+                << ", \"items_per_sec\": " << r.itemsPerSecond
+                << ", \"allocs_per_op\": " << r.allocsPerOp
+                << ", \"bytes_per_op\": " << r.bytesPerOp;
+            if (!r.counters.empty())
+            {
+                out << ", \"counters\": {";
+                for (size_t c = 0; c < r.counters.size(); ++c)
+                {
+                    out << (c == 0 ? "" : ", ") << "\"" << escape(r.counters[c].first) << "\": " << r.counters[c].second;
+                }
+                out << "}";
+            }
+            out << "}";
+        }
+        out << "\n  ]\n}\n";
+    }
+}
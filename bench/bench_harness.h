@@ -0,0 +1,81 @@
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+// Minimal benchmark harness: parameterized cases, wall-clock timing,
+// heap allocation counting and JSON output. No external dependencies.
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench
+{
+    // The timed operation for one (case, size) pair. `fixture` keeps the
+    // setup data alive for as long as `run` needs it.
+    struct Operation
+    {
+        std::function<void()> run;
+        double itemsPerOp = 1.0;                 // Entities processed by one call of run
+        uint64_t maxIterations = UINT64_MAX;     // For operations that consume their fixture
+        bool allocationFree = false;             // Timed calls must not touch the heap at all
+        std::shared_ptr<void> fixture;
+        // Extra named values read once after timing (solution quality, ...)
+        std::vector<std::pair<std::string, std::function<double()>>> counters;
+    };
+
+    struct Case
+    {
+        std::string name;
+        std::string variant;                     // Extra parameters, e.g. "threads=4"
+        std::vector<size_t> sizes;
+        std::function<Operation(size_t n)> setup;
+    };
+
+    struct Result
+    {
+        std::string name;
+        std::string variant;
+        size_t n = 0;
+        uint64_t iterations = 0;
+        double nsPerOp = 0.0;
+        double opsPerSecond = 0.0;
+        double itemsPerSecond = 0.0;
+        double allocsPerOp = 0.0;
+        double bytesPerOp = 0.0;
+        bool allocationFree = false;             // Copied from the operation, checked by the runner
+        std::vector<std::pair<std::string, double>> counters;
+    };
+
+    // 10, 100, ... up to maxSize
+    std::vector<size_t> decades(size_t maxSize = 1000000);
+
+    // Cases register themselves at static-initialization time
+    std::vector<Case> &registry();
+
+    struct Registrar
+    {
+        explicit Registrar(Case benchCase);
+    };
+
+    Result runCase(const Case &benchCase, size_t n, double minSeconds);
+    // `context` is written as string key/value pairs describing the run (build, CPU features, ...)
+    void writeJson(const std::vector<Result> &results, const std::vector<std::pair<std::string, std::string>> &context,
+                   std::ostream &out);
+
+    // Global heap allocation counters (maintained by alloc_counter.cpp)
+    uint64_t allocationCount();
+    uint64_t allocatedBytes();
+
+    // Stops the optimizer from discarding a computed value
+    template <typename T>
+    inline void doNotOptimize(const T &value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+}
+
+#endif // BENCH_HARNESS_H
@@ -0,0 +1,97 @@
+// Runs every registered benchmark case over its size sweep and writes JSON
+//
+//   norad_bench [--filter SUBSTRING] [--max-n N] [--min-time SECONDS] [--out FILE]
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "bench_harness.h"
+#include "track_store.h"
+
+int main(int argc, char *argv[])
+{
+    std::string filter;
+    std::string outPath;
+    size_t maxN = 1000000;
+    double minSeconds = 0.1;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--filter" && hasValue)
+        {
+            filter = argv[++i];
+        }
+        else if (arg == "--max-n" && hasValue)
+        {
+            maxN = std::stoul(argv[++i]);
+        }
+        else if (arg == "--min-time" && hasValue)
+        {
+            minSeconds = std::stod(argv[++i]);
+        }
+        else if (arg == "--out" && hasValue)
+        {
+            outPath = argv[++i];
+        }
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--filter SUBSTRING] [--max-n N] [--min-time SECONDS] [--out FILE]\n";
+            return 1;
+        }
+    }
+
+    std::vector<bench::Result> results;
+    int status = 0;
+    for (const auto &benchCase : bench::registry())
+    {
+        std::string fullName = benchCase.variant.empty() ? benchCase.name : benchCase.name + "/" + benchCase.variant;
+        if (!filter.empty() && fullName.find(filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        for (size_t n : benchCase.sizes)
+        {
+            if (n > maxN)
+            {
+                continue;
+            }
+            // Progress goes to stderr so stdout stays pure JSON
+            std::cerr << fullName << " n=" << n << " ... " << std::flush;
+            bench::Result result = bench::runCase(benchCase, n, minSeconds);
+            std::cerr << result.nsPerOp << " ns/op, " << result.allocsPerOp << " allocs/op\n";
+            if (result.allocationFree && result.allocsPerOp > 0.0)
+            {
+                std::cerr << "FAILED: " << fullName << " n=" << n << " must not allocate\n";
+                status = 1;
+            }
+            results.push_back(result);
+        }
+    }
+
+    std::vector<std::pair<std::string, std::string>> context = {
+#ifdef NDEBUG
+        {"build", "release"},
+#else
+        {"build", "debug"},
+#endif
+        {"avx2", TrackStore::avx2Available() ? "yes" : "no"},
+        {"min_time_s", std::to_string(minSeconds)}};
+
+    if (outPath.empty())
+    {
+        bench::writeJson(results, context, std::cout);
+    }
+    else
+    {
+        std::ofstream out(outPath);
+        if (!out)
+        {
+            std::cerr << "Cannot open " << outPath << "\n";
+            return 1;
+        }
+        bench::writeJson(results, context, out);
+    }
+    return status;
+}
@@ -0,0 +1,46 @@
+// Enemy track propagation: per-object EnemyMissile::move versus the SoA TrackStore kernels
+#include <memory>
+#include "bench_harness.h"
+#include "scenario.h"
+#include "track_store.h"
+
+namespace
+{
+    bench::Registrar enemyMove({"enemy_missile_move", "", bench::decades(), [](size_t n)
+                                {
+                                    auto enemies = std::make_shared<std::vector<EnemyMissile>>(Scenario::makeSalvo(n, 0).enemies);
+                                    bench::Operation op;
+                                    op.run = [enemies]()
+                                    {
+                                        for (auto &enemy : *enemies)
+                                        {
+                                            enemy.move();
+                                        }
+                                    };
+                                    op.itemsPerOp = static_cast<double>(n);
+                                    op.fixture = enemies;
+                                    return op;
+                                }});
+
+    bench::Operation makeTrackStoreMove(size_t n, TrackStore::MoveKernel kernel)
+    {
+        auto store = std::make_shared<TrackStore>();
+        for (const auto &enemy : Scenario::makeSalvo(n, 0).enemies)
+        {
+            store->add(enemy);
+        }
+        store->setMoveKernel(kernel);
+
+        bench::Operation op;
+        op.run = [store]() { store->moveAll(); };
+        op.itemsPerOp = static_cast<double>(n);
+        op.fixture = store;
+        return op;
+    }
+
+    bench::Registrar trackStoreScalar({"track_store_move", "kernel=scalar", bench::decades(), [](size_t n)
+                                       { return makeTrackStoreMove(n, TrackStore::MoveKernel::Scalar); }});
+
+    bench::Registrar trackStoreAuto({"track_store_move", "kernel=auto", bench::decades(), [](size_t n)
+                                     { return makeTrackStoreMove(n, TrackStore::MoveKernel::Auto); }});
+}
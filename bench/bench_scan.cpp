@@ -0,0 +1,86 @@
+// Radar scan cost as the number of enemy tracks grows
+#include <memory>
+#include "bench_harness.h"
+#include "scenario.h"
+#include "track_store.h"
+#include "detection_system.h"
+
+namespace
+{
+    struct ScanFixture
+    {
+        Scenario scenario;
+        TrackStore enemies;
+        DetectionSystem radar;
+
+        explicit ScanFixture(size_t n, size_t workers = 1)
+            : scenario(Scenario::makeSalvo(n, 0)), radar(enemies, scenario.targets)
+        {
+            for (const auto &enemy : scenario.enemies)
+            {
+                enemies.add(enemy);
+            }
+            radar.setWorkerCount(workers);
+        }
+    };
+
+    bench::Registrar scan({"detection_scan", "", bench::decades(), [](size_t n)
+                           {
+                               auto fixture = std::make_shared<ScanFixture>(n);
+                               bench::Operation op;
+                               op.run = [fixture]()
+                               {
+                                   const auto &threats = fixture->radar.scanForThreats();
+                                   bench::doNotOptimize(threats.size());
+                               };
+                               op.itemsPerOp = static_cast<double>(n);
+                               op.fixture = fixture;
+                               return op;
+                           }});
+
+    // The same scan with the range gate forced onto the scalar loop
+    bench::Registrar scanScalar({"detection_scan", "kernel=scalar", bench::decades(), [](size_t n)
+                                 {
+                                     auto fixture = std::make_shared<ScanFixture>(n);
+                                     fixture->radar.setKernel(DetectionSystem::Kernel::Scalar);
+                                     bench::Operation op;
+                                     op.run = [fixture]()
+                                     {
+                                         const auto &threats = fixture->radar.scanForThreats();
+                                         bench::doNotOptimize(threats.size());
+                                     };
+                                     op.itemsPerOp = static_cast<double>(n);
+                                     op.fixture = fixture;
+                                     return op;
+                                 }});
+
+    // Thread scaling of the partitioned scan, 1 to 32 workers
+    bench::Operation makeParallelScan(size_t n, size_t workers)
+    {
+        auto fixture = std::make_shared<ScanFixture>(n, workers);
+        bench::Operation op;
+        op.run = [fixture]()
+        {
+            const auto &threats = fixture->radar.scanForThreats();
+            bench::doNotOptimize(threats.size());
+        };
+        op.itemsPerOp = static_cast<double>(n);
+        op.fixture = fixture;
+        return op;
+    }
+
+    const std::vector<size_t> scalingSizes = {10000, 100000, 1000000};
+
+    bench::Registrar scan1({"detection_scan_parallel", "threads=1", scalingSizes, [](size_t n)
+                            { return makeParallelScan(n, 1); }});
+    bench::Registrar scan2({"detection_scan_parallel", "threads=2", scalingSizes, [](size_t n)
+                            { return makeParallelScan(n, 2); }});
+    bench::Registrar scan4({"detection_scan_parallel", "threads=4", scalingSizes, [](size_t n)
+                            { return makeParallelScan(n, 4); }});
+    bench::Registrar scan8({"detection_scan_parallel", "threads=8", scalingSizes, [](size_t n)
+                            { return makeParallelScan(n, 8); }});
+    bench::Registrar scan16({"detection_scan_parallel", "threads=16", scalingSizes, [](size_t n)
+                             { return makeParallelScan(n, 16); }});
+    bench::Registrar scan32({"detection_scan_parallel", "threads=32", scalingSizes, [](size_t n)
+                             { return makeParallelScan(n, 32); }});
+}
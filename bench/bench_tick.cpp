@@ -0,0 +1,56 @@
+// Whole-tick cost (move, flights, scan, auto-intercept) with the heap allocation
+// count per tick; steady state does not allocate at all, and the run fails if it does
+#include <memory>
+#include <climits>
+#include "bench_harness.h"
+#include "simulation.h"
+
+namespace
+{
+    // Interceptors thin the salvo out over time, keep the run near the initial track count
+    const uint64_t MAX_TICKS = 200;
+
+    std::shared_ptr<Simulation> makeSalvoSim(size_t n, size_t workers)
+    {
+        auto sim = std::make_shared<Simulation>(Scenario::makeSalvo(n, n));
+        MissileController &controller = sim->getController();
+        controller.setVerbose(false);
+        controller.setAutoIntercept(true);
+        controller.setMaxAutoInterceptMissiles(INT_MAX);
+        sim->getRadar().setWorkerCount(workers);
+        return sim;
+    }
+
+    // The engagement grows as the salvo closes in, and the scratch arena regrows
+    // each time it does. A twin run over the same ticks finds the peak, so the
+    // measured run starts at that size (with reset()'s half again of headroom)
+    size_t scratchPeak(size_t n, size_t workers)
+    {
+        std::shared_ptr<Simulation> twin = makeSalvoSim(n, workers);
+        for (uint64_t i = 0; i < MAX_TICKS; ++i)
+        {
+            twin->tick();
+        }
+        size_t peak = twin->getController().getScratchArena().getHighWater();
+        return peak + peak / 2;
+    }
+
+    bench::Operation makeTick(size_t n, size_t workers)
+    {
+        auto sim = makeSalvoSim(n, workers);
+        sim->getController().reserveScratch(scratchPeak(n, workers));
+
+        bench::Operation op;
+        op.run = [sim]() { sim->tick(); };
+        op.itemsPerOp = static_cast<double>(n);
+        op.maxIterations = MAX_TICKS;
+        op.allocationFree = true;
+        op.fixture = sim;
+        return op;
+    }
+
+    bench::Registrar tick({"simulation_tick", "threads=1", bench::decades(), [](size_t n)
+                           { return makeTick(n, 1); }});
+    bench::Registrar tickParallel({"simulation_tick", "threads=4", {10000, 100000, 1000000}, [](size_t n)
+                                   { return makeTick(n, 4); }});
+}
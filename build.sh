@@ -1,9 +1,9 @@
 #!/bin/bash
 
-SOURCE_FILES="src/main.cpp src/missile.cpp src/missile_controller.cpp src/enemy_missile.cpp src/detection_system.cpp"
+SOURCE_FILES="src/main.cpp src/missile.cpp src/missile_controller.cpp src/enemy_missile.cpp src/detection_system.cpp src/track_store.cpp src/scenario.cpp src/simulation.cpp src/thread_pool.cpp src/terminal_renderer.cpp src/name_table.cpp src/weapon_target_assignment.cpp src/scenario_file.cpp src/tick_recorder.cpp src/tick_profiler.cpp src/intercept_solver.cpp src/event_scheduler.cpp src/tick_pipeline.cpp src/tick_arena.cpp src/monte_carlo.cpp src/track_fusion.cpp src/sensor_network.cpp src/track_filter.cpp src/geodetic.cpp src/sharded_theater.cpp src/world_snapshot.cpp src/world_publisher.cpp src/command_channel.cpp src/interceptor_types.cpp"
 EXECUTABLE="main"
 
-clang++ -std=c++17 -Iinclude -o $EXECUTABLE $SOURCE_FILES
+clang++ -std=c++17 -pthread -DNORAD_TICK_PROFILING -Iinclude -o $EXECUTABLE $SOURCE_FILES
 
 if [ $? -ne 0 ]; then
     echo "Compilation failed."
@@ -0,0 +1,122 @@
+#ifndef COMMAND_CHANNEL_H
+#define COMMAND_CHANNEL_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include <termios.h>
+#include "position.h"
+#include "interceptor_types.h"
+
+// One operator command, parsed from a line of text. The same lines are typed
+// into the live view or sent to its control socket:
+//   launch M T          launch missile #M, or a ready one of class M (patriot,
+//                       tomahawk, stinger, javelin), at retaliation target number T
+//   intercept N         intercept threat #N with the best placed interceptor
+//   auto on|off|toggle  auto-intercept
+//   threshold D         auto-intercept threats within D metres
+//   max-auto N          auto-intercept launch budget
+//   assign greedy|global|toggle
+//   pause, resume, step (one tick while paused), status, help, quit
+struct OperatorCommand
+{
+    enum class Type
+    {
+        Launch,
+        Intercept,
+        AutoIntercept,
+        Threshold,
+        MaxAuto,
+        Assignment,
+        Pause,
+        Resume,
+        Step,
+        Status,
+        Help,
+        Quit
+    };
+    enum class Switch
+    {
+        On,
+        Off,
+        Toggle
+    };
+
+    Type type = Type::Status;
+    int id = -1;                     // Launch: missile ID, Intercept: threat number, MaxAuto: budget
+    InterceptorClass missileClass = InterceptorClass::Custom; // Launch: a ready one of this class instead, unless Custom
+    int target = -1;                 // Launch: retaliation target number, 1-based
+    double value = 0.0;              // Threshold: metres
+    Switch setting = Switch::Toggle; // AutoIntercept: on/off; Assignment: On = global, Off = greedy
+    Position aim = {};               // Launch: where target number `target` is, filled in by the caller
+    int client = 0;                  // Who gets the answer (CommandChannel::CONSOLE or a socket client)
+};
+
+// Throws std::invalid_argument, with a message fit to show the operator, on
+// anything that isn't one of the commands above
+OperatorCommand parseOperatorCommand(const std::string &line);
+const char *operatorCommandHelp();
+
+// Where operator commands come from while the world keeps ticking: a
+// Unix-domain control socket any number of clients can connect to, and the
+// terminal. Nothing here ever blocks: poll() takes whatever has arrived since
+// the last call, so the caller can check once per rendered frame. What a
+// command does, and when, is up to the caller; replies are one line each.
+class CommandChannel
+{
+public:
+    static const int CONSOLE = 0; // Client ID of the terminal
+    static const size_t MAX_LINE = 256;
+
+    CommandChannel() = default;
+    ~CommandChannel(); // Closes everything, removes the socket and restores the terminal
+    CommandChannel(const CommandChannel &) = delete;
+    CommandChannel &operator=(const CommandChannel &) = delete;
+
+    // Listens on a Unix-domain stream socket at `path`, replacing a stale
+    // socket file there. Throws std::runtime_error if it can't.
+    void listen(const std::string &path);
+    const std::string &getPath() const { return path; }
+
+    // Takes commands from stdin too. A terminal is switched to unbuffered
+    // input without echo (Ctrl+C still raises SIGINT) and the line typed so
+    // far is kept for the caller to draw; anything else is read line by line.
+    // releaseConsole() puts the terminal back the way it was.
+    void attachConsole();
+    void releaseConsole();
+    const std::string &getConsoleLine() const { return consoleLine; }
+    // Last reply to the terminal, for the caller to draw
+    const std::string &getConsoleReply() const { return consoleReply; }
+
+    // Appends every complete, valid command received since the last call to
+    // `commands`; malformed ones are answered here and dropped
+    void poll(std::vector<OperatorCommand> &commands);
+    // Best effort: a client that isn't reading, or has gone, loses the reply
+    void reply(int client, const std::string &text);
+    size_t getClientCount() const { return clients.size(); }
+
+private:
+    struct Client
+    {
+        int fd;
+        std::string pending; // Received after the last complete line
+    };
+
+    std::string path;
+    int listener = -1;
+    std::map<int, Client> clients;
+    int nextClient = CONSOLE + 1;
+
+    bool consoleAttached = false;
+    bool consoleIsTerminal = false;
+    termios savedTerminal;
+    std::string consoleLine;
+    std::string consoleReply;
+
+    void acceptClients();
+    bool readClient(Client &client, int id, std::vector<OperatorCommand> &commands); // False once it is gone
+    void readConsole(std::vector<OperatorCommand> &commands);
+    void submitLine(const std::string &line, int client, std::vector<OperatorCommand> &commands);
+};
+
+#endif // COMMAND_CHANNEL_H
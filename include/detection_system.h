@@ -4,31 +4,110 @@
 #include <vector>
 #include <string>
 #include <cmath>
+#include <memory>
 #include "position.h"
-#include "enemy_missile.h"
+#include "track_store.h"
 #include "target.h"
+#include "name_table.h"
 
+// Plain-old-data record: no owned strings, so report buffers can be reused
+// tick after tick without touching the heap
 struct ThreatReport
 {
-        int detectionId;
+        int detectionId; // System track ID when fed by a sensor network, else the enemy ID
         int enemyId;
-        std::string enemyName;
-        std::string targetName;
+        int enemyNameId; // Resolve with DetectionSystem::getName
+        int targetId;    // Resolve with DetectionSystem::getTargetName, -1 if unknown
         double distanceToTarget;
         double calculatedSpeed;
+        double timeToImpact;    // Ticks at the current closing speed, +infinity when not closing
         Position enemyPosition; //
+        Position enemyVelocity; // Per tick; the estimate when the radar is noisy, else straight toward the target
 };
 
+class ThreadPool;
+class TrackFilter;
+struct SystemTrack;
+
 class DetectionSystem
 {
 public:
-        DetectionSystem(const std::vector<EnemyMissile> &enemyMissiles, const std::vector<Target> &targets);
-        std::vector<ThreatReport> scanForThreats();
+        // Tracks closer than this to their target are reported as threats
+        static constexpr double THREAT_RANGE = 10000.0;
+
+        enum class Kernel
+        {
+                Auto,   // AVX2 range gate when the CPU supports it, scalar otherwise
+                Scalar,
+                Avx2
+        };
+
+        DetectionSystem(const TrackStore &enemyMissiles, const std::vector<Target> &targets);
+        ~DetectionSystem();
+
+        // Fills the radar's reusable report buffer and returns it. The buffer
+        // stays valid (and may be sorted in place) until the next scan.
+        std::vector<ThreatReport> &scanForThreats();
+        const std::vector<ThreatReport> &getLastThreats() const;
+        // Report for the track at `index` as if it were at `position`, for callers
+        // that predict positions instead of scanning (no range check)
+        ThreatReport reportAt(size_t index, const Position &position) const;
+        // Sensor network mode: reports fused tracks predicted to `tick` instead of
+        // the true ones. A track's truth tag still says which enemy an interceptor
+        // kills and what it is heading for; tags already gone are skipped, and
+        // every enemy is reported once, by its oldest system track.
+        std::vector<ThreatReport> &reportTracks(const std::vector<SystemTrack> &tracks, long tick);
+
+        // Position error of every measurement, 1 sigma per axis; 0 (the default)
+        // is a perfect radar. With noise every scan measures all tracks, runs
+        // them through a batch of Kalman filters (track_filter.h) and reports
+        // the estimates: position, velocity and speed. One scan is one tick.
+        // Throws std::invalid_argument for negative noise.
+        void setMeasurementNoise(double sigma);
+        double getMeasurementNoise() const;
+        const TrackFilter *getFilter() const { return filter.get(); } // Null for a perfect radar
+
+        // Number of threads used by scanForThreats (1 = serial). The enemy set is
+        // split into contiguous chunks, so the report order matches the serial scan.
+        void setWorkerCount(size_t workers);
+        size_t getWorkerCount() const;
+
+        // Range gate of a perfect radar's scan: squared distances four tracks
+        // at a time, square roots only for the tracks inside THREAT_RANGE
+        void setKernel(Kernel kernel) { this->kernel = kernel; }
+        static bool avx2Available();
+
+        // Target lookups through the precomputed ID index
+        const Target *getTarget(int targetId) const;
+        const std::string &getTargetName(int targetId) const;
+        const std::string &getName(int nameId) const;
 
 private:
-        const std::vector<EnemyMissile> &enemyMissiles;
+        const TrackStore &enemyMissiles;
         const std::vector<Target> &targets;
-        int detectionIdCounter;
+        std::vector<int> targetIndexById; // Dense target ID -> index into targets (-1 when absent)
+
+        NameTable names;
+        int unidentifiedNameId;
+        std::vector<ThreatReport> reports; // Reused by every scan
+        std::vector<uint8_t> reportedRows; // Track store rows already reported by reportTracks
+        Kernel kernel = Kernel::Auto;
+
+        // Noisy radar state
+        std::unique_ptr<TrackFilter> filter;
+        long scans = 0;
+
+        // Parallel scan state, only allocated when more than one worker is requested
+        std::unique_ptr<ThreadPool> pool;
+        std::vector<std::vector<ThreatReport>> chunkReports;
+        std::vector<size_t> chunkOffsets;
+
+        void scanRange(size_t begin, size_t end, std::vector<ThreatReport> &out) const;
+        void scanTruthScalar(size_t begin, size_t end, std::vector<ThreatReport> &out) const;
+        void scanTruthAvx2(size_t begin, size_t end, std::vector<ThreatReport> &out) const;
+        void reportIfInRange(size_t index, double distanceSquared, std::vector<ThreatReport> &out) const;
+        void measureAll();
+        ThreatReport makeReport(size_t index, const Position &position, const Position &velocity, double distance) const;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -5,18 +5,19 @@
 class EnemyMissile
 {
 public:
-    EnemyMissile(int id, const Position &start, const Position &target, double speed);
+    EnemyMissile(int id, const Position &start, const Position &target, double speed, int targetId = -1);
     void move(); // A method to move the missile
     const Position &getCurrentPosition() const;
     int getId() const;
     const Position &getTargetPosition() const;
     double getSpeed() const;
+    int getTargetId() const;
 
 private:
     int id;
     Position currentPosition;
     Position targetPosition;
     double speed;
-    Position startPosition;
+    int targetId; // ID of the Target being attacked, -1 if unknown
 };
 #endif // ENEMY_MISSILE_H <<< End of the gate
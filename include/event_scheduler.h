@@ -0,0 +1,43 @@
+#ifndef EVENT_SCHEDULER_H
+#define EVENT_SCHEDULER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Kinds of event driving the event-driven core. Events due on the same tick
+// pop in this order, so a tick is always handled the same way.
+enum class SimEventType : uint8_t
+{
+    InterceptorArrival,      // An interceptor reaches its aim point (id = enemy track, -1 for none)
+    EnterThreatRange,        // Track comes within DetectionSystem::THREAT_RANGE
+    CrossInterceptThreshold, // Track comes within the auto-intercept threshold
+    Impact,                  // Track reaches its target
+    EngagementRetry          // Eligible threats were left unengaged, try again
+};
+
+struct SimEvent
+{
+    long tick;
+    SimEventType type;
+    int id; // Enemy track ID
+};
+
+// Next-event queue: a binary min-heap on (tick, type, id)
+class EventScheduler
+{
+public:
+    void schedule(long tick, SimEventType type, int id = -1);
+    const SimEvent &next() const { return heap.front(); }
+    SimEvent pop();
+
+    bool empty() const { return heap.empty(); }
+    size_t size() const { return heap.size(); }
+    void clear() { heap.clear(); }
+    void reserve(size_t count) { heap.reserve(count); }
+
+private:
+    std::vector<SimEvent> heap;
+};
+
+#endif // EVENT_SCHEDULER_H
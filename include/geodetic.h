@@ -0,0 +1,61 @@
+#ifndef GEODETIC_H
+#define GEODETIC_H
+
+#include "position.h"
+
+// A point on or above the WGS-84 ellipsoid
+struct GeodeticPosition
+{
+    double latitude;  // Degrees, north positive
+    double longitude; // Degrees, east positive
+    double altitude;  // Metres above the ellipsoid
+};
+
+namespace wgs84
+{
+    constexpr double SEMI_MAJOR_AXIS = 6378137.0;
+    constexpr double FLATTENING = 1.0 / 298.257223563;
+    constexpr double ECCENTRICITY_SQUARED = FLATTENING * (2.0 - FLATTENING);
+}
+
+// Earth-centred, earth-fixed metres
+Position geodeticToEcef(const GeodeticPosition &location);
+GeodeticPosition ecefToGeodetic(const Position &ecef);
+
+// East-north-up metres around a fixed origin: the frame the simulation runs
+// in. The origin's ECEF position and the rotation are computed once, so
+// converting a point is one subtraction and a 3x3 product, and everything
+// after that (moving, ranging, intercept geometry) is plain Cartesian maths
+// with no trig. The frame is an exact rotation of ECEF, so straight-line
+// distances are true distances however far a point is from the origin; only
+// "up" drifts from the local vertical there (see axesAt).
+class LocalFrame
+{
+public:
+    LocalFrame() : LocalFrame(GeodeticPosition{0.0, 0.0, 0.0}) {}
+    explicit LocalFrame(const GeodeticPosition &origin);
+
+    const GeodeticPosition &getOrigin() const { return origin; }
+
+    Position fromEcef(const Position &ecef) const;
+    Position toEcef(const Position &local) const;
+    Position fromGeodetic(const GeodeticPosition &location) const { return fromEcef(geodeticToEcef(location)); }
+    GeodeticPosition toGeodetic(const Position &local) const { return ecefToGeodetic(toEcef(local)); }
+
+    // The east, north and up unit vectors at `location`, in this frame; for
+    // laying things out on the ground far from the origin
+    struct Axes
+    {
+        Position east;
+        Position north;
+        Position up;
+    };
+    Axes axesAt(const GeodeticPosition &location) const;
+
+private:
+    GeodeticPosition origin;
+    Position originEcef;
+    double rotation[3][3]; // Rows: east, north, up at the origin, in ECEF
+};
+
+#endif // GEODETIC_H
@@ -0,0 +1,68 @@
+#ifndef INTERCEPT_SOLVER_H
+#define INTERCEPT_SOLVER_H
+
+#include <cstddef>
+#include <limits>
+#include <memory_resource>
+#include <vector>
+#include "position.h"
+
+// Closed-form lead pursuit against a constant-velocity track.
+// An interceptor at P flying straight at speed s meets a target at E moving
+// with velocity v after t ticks where |E + v t - P| = s t, i.e.
+//     (v.v - s^2) t^2 + 2 (r.v) t + r.r = 0,   r = E - P.
+// The earliest non-negative root is the time to go, E + v t the aim point.
+// Pairs with no such root (a slower interceptor behind a receding target)
+// are unreachable and report infinity. The line only holds until the track
+// reaches its own target: a root at or past that horizon (its time to
+// impact) is unreachable too.
+struct InterceptSolution
+{
+    double timeToGo; // Ticks, +infinity when unreachable
+    Position point;  // Where to aim, the track's current position when unreachable
+
+    bool reachable() const;
+};
+
+InterceptSolution solveIntercept(const Position &interceptor, double speed,
+                                 const Position &target, const Position &velocity,
+                                 double horizon = std::numeric_limits<double>::infinity());
+
+// The same solve over every (threat, interceptor) pair of a tick.
+// Interceptors are stored as columns (structure of arrays); each threat row
+// is evaluated against all of them with an AVX2 kernel when available.
+// Column storage comes from `resource` (the heap by default).
+class InterceptSolver
+{
+public:
+    explicit InterceptSolver(std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        : xs(resource), ys(resource), zs(resource), speedsSquared(resource) {}
+
+    enum class Kernel
+    {
+        Auto,   // AVX2 when the CPU supports it, scalar otherwise
+        Scalar,
+        Avx2
+    };
+
+    void clearInterceptors();
+    void reserveInterceptors(size_t count);
+    void addInterceptor(const Position &position, double speed);
+    size_t interceptorCount() const { return xs.size(); }
+
+    // Row-major rows x interceptorCount() times to go, one row per target
+    // (positions, velocities and horizons in parallel arrays), written into
+    // `times`, which must have room for all of them
+    void solve(const Position *targets, const Position *velocities, const double *horizons, size_t rows,
+               double *times) const;
+
+    void setKernel(Kernel kernel) { this->kernel = kernel; }
+    static bool avx2Available();
+
+private:
+    std::pmr::vector<double> xs, ys, zs;
+    std::pmr::vector<double> speedsSquared;
+    Kernel kernel = Kernel::Auto;
+};
+
+#endif // INTERCEPT_SOLVER_H
@@ -0,0 +1,145 @@
+#ifndef INTERCEPTOR_TYPES_H
+#define INTERCEPTOR_TYPES_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+// The interceptor classes known at compile time. A class fixes the name,
+// warhead damage and speed, so code written against InterceptorTraits<C>
+// sees them as constants. A missile whose scenario row matches none of them
+// exactly (scenario files may define their own) is Custom and carries its
+// stats as plain data.
+enum class InterceptorClass : uint8_t
+{
+    Patriot,
+    Tomahawk,
+    Stinger,
+    Javelin,
+    Custom
+};
+constexpr size_t INTERCEPTOR_CLASS_COUNT = static_cast<size_t>(InterceptorClass::Custom) + 1;
+
+template <InterceptorClass C>
+struct InterceptorTraits; // None for Custom
+
+template <>
+struct InterceptorTraits<InterceptorClass::Patriot>
+{
+    static constexpr std::string_view name = "Patriot";
+    static constexpr int damage = 100;
+    static constexpr double speed = 80.0; // Metres per tick
+};
+
+template <>
+struct InterceptorTraits<InterceptorClass::Tomahawk>
+{
+    static constexpr std::string_view name = "Tomahawk";
+    static constexpr int damage = 200;
+    static constexpr double speed = 100.0;
+};
+
+template <>
+struct InterceptorTraits<InterceptorClass::Stinger>
+{
+    static constexpr std::string_view name = "Stinger";
+    static constexpr int damage = 50;
+    static constexpr double speed = 120.0;
+};
+
+template <>
+struct InterceptorTraits<InterceptorClass::Javelin>
+{
+    static constexpr std::string_view name = "Javelin";
+    static constexpr int damage = 150;
+    static constexpr double speed = 90.0;
+};
+
+// The traits as a runtime row, for code that only knows the class at run time
+struct InterceptorSpec
+{
+    InterceptorClass kind;
+    std::string_view name;
+    int damage;
+    double speed;
+};
+
+namespace interceptor_types
+{
+    template <InterceptorClass C>
+    constexpr InterceptorSpec specOf()
+    {
+        using Traits = InterceptorTraits<C>;
+        static_assert(Traits::damage > 0 && Traits::speed > 0.0,
+                      "interceptor traits must describe a missile that flies and hurts");
+        return {C, Traits::name, Traits::damage, Traits::speed};
+    }
+
+    // Indexed by class, Custom excluded
+    constexpr std::array<InterceptorSpec, INTERCEPTOR_CLASS_COUNT - 1> SPECS = {
+        specOf<InterceptorClass::Patriot>(), specOf<InterceptorClass::Tomahawk>(),
+        specOf<InterceptorClass::Stinger>(), specOf<InterceptorClass::Javelin>()};
+
+    constexpr bool sameLetters(std::string_view a, std::string_view b)
+    {
+        if (a.size() != b.size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            char x = a[i] >= 'A' && a[i] <= 'Z' ? static_cast<char>(a[i] - 'A' + 'a') : a[i];
+            char y = b[i] >= 'A' && b[i] <= 'Z' ? static_cast<char>(b[i] - 'A' + 'a') : b[i];
+            if (x != y)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+// Null for Custom
+constexpr const InterceptorSpec *interceptorSpec(InterceptorClass kind)
+{
+    return kind == InterceptorClass::Custom ? nullptr : &interceptor_types::SPECS[static_cast<size_t>(kind)];
+}
+
+// The class a scenario row is an instance of: the one whose traits it matches
+// exactly, Custom otherwise
+constexpr InterceptorClass classifyInterceptor(std::string_view name, int damage, double speed)
+{
+    for (const InterceptorSpec &spec : interceptor_types::SPECS)
+    {
+        if (spec.name == name && spec.damage == damage && spec.speed == speed)
+        {
+            return spec.kind;
+        }
+    }
+    return InterceptorClass::Custom;
+}
+
+// A known class by name, ignoring case ("patriot" is a Patriot)
+constexpr std::optional<InterceptorClass> interceptorClassNamed(std::string_view name)
+{
+    for (const InterceptorSpec &spec : interceptor_types::SPECS)
+    {
+        if (interceptor_types::sameLetters(spec.name, name))
+        {
+            return spec.kind;
+        }
+    }
+    return std::nullopt;
+}
+
+// A name that lives as long as the process: the class's own for the known
+// classes, an interned copy for custom ones (each distinct name is stored once)
+std::string_view interceptorName(InterceptorClass kind, std::string_view name);
+
+static_assert(classifyInterceptor("Stinger", 50, 120.0) == InterceptorClass::Stinger);
+static_assert(classifyInterceptor("Stinger", 50, 121.0) == InterceptorClass::Custom);
+static_assert(interceptorSpec(InterceptorClass::Javelin)->damage == InterceptorTraits<InterceptorClass::Javelin>::damage);
+
+#endif // INTERCEPTOR_TYPES_H
@@ -0,0 +1,27 @@
+#ifndef MEASUREMENT_NOISE_H
+#define MEASUREMENT_NOISE_H
+
+#include <cstdint>
+
+// Sensor noise as a pure function of who measured what, when and along which
+// axis, so the noise doesn't depend on which thread scanned or in what order.
+// `source` tells sensors apart (a radar site index, ...); axes 0-7 per source.
+
+inline uint64_t mixNoiseBits(uint64_t value)
+{
+    // splitmix64 finalizer
+    value += 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+// Uniform in [-1, 1); times sqrt(3) for unit variance
+inline double uniformNoise(uint64_t source, int id, long tick, uint64_t axis)
+{
+    uint64_t bits = mixNoiseBits(mixNoiseBits(mixNoiseBits(source * 8 + axis) ^ static_cast<uint32_t>(id)) ^
+                                 static_cast<uint64_t>(tick));
+    return static_cast<double>(bits >> 11) * (2.0 / 9007199254740992.0) - 1.0;
+}
+
+#endif // MEASUREMENT_NOISE_H
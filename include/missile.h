@@ -2,37 +2,74 @@
 #define MISSILE_H
 
 #include <string>
+#include <string_view>
 #include <iostream>
 #include "position.h"
+#include "interceptor_types.h"
 
 
 class Missile
 {
 public:
 
-    // Corrected constructor declaration
-    Missile(int id, int damage, std::string missileName, double missileSpeed, Position startPosition);
+    // The class is the one the name and stats match (interceptor_types.h),
+    // Custom if none does
+    Missile(int id, int damage, std::string_view missileName, double missileSpeed, Position startPosition);
     void move(double dx, double dy, double dz);
     bool hasHitTarget() const;
     void printStatus() const;
 
     // --- Add these public getter methods ---
     int getId() const;
-    std::string getName() const;
+    std::string_view getName() const; // Static storage, never a copy
+    InterceptorClass getClass() const { return kind; }
     double getSpeed() const;
     Position getCurrentPosition() const;
 
-    void triggerLaunch(const Position &target);
+    // Flight is a small state machine advanced once per simulation tick:
+    // launch() arms it, advanceFlight() moves along the parabolic path
+    // (one step, or several when the caller skips ticks) and returns true on
+    // the call that reaches the target. A flight lasts `flightSteps` ticks
+    // (intercepts pass their time to go).
+    bool launch(const Position &target, int targetEnemyId = -1, int flightSteps = FLIGHT_STEPS);
+    bool advanceFlight(int steps = 1);
+    bool isInFlight() const;
+    double getFlightProgress() const; // 0.0 at launch, 1.0 on arrival
+    int getTargetEnemyId() const;     // Enemy track this interceptor is aimed at, -1 for a ground target
+    int getFlightStep() const;        // Steps flown so far, 0..getFlightSteps()
+    int getFlightSteps() const;       // Length of the current flight in steps
+    int getDamage() const;
+    const Position &getLaunchPosition() const;
+    const Position &getFlightTarget() const;
+
+    // Optional view of the flight state: one progress bar line, no newline
+    void printFlightProgress() const;
+
+    static const int FLIGHT_STEPS = 20; // Default flight length, also the progress bar width
+    static constexpr double FLIGHT_APEX = 500.0; // Of the lofted flight path, metres, every class
 
 private:
+    enum class FlightState
+    {
+        Ready,
+        InFlight,
+        Arrived
+    };
+
     // Private member variables (now encapsulated)
     int id;
     int damageStrength;
-    std::string name;
+    InterceptorClass kind;
+    std::string_view name;
     double speed;
     Position currentPosition;
 
-    bool isLaunched;
+    FlightState flightState;
+    Position launchPosition;
+    Position flightTarget;
+    int flightStep;
+    int flightSteps;
+    int targetEnemyId;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -3,46 +3,170 @@
 
 #include <vector>
 #include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <utility>
 #include "missile.h"
+#include "slot_map.h"
 #include "detection_system.h"
+#include "weapon_target_assignment.h"
+#include "intercept_solver.h"
+#include "tick_arena.h"
 
 class MissileController
 {
 public:
-    void addMissile(const Missile &missile);
+    // How auto-intercept pairs interceptors with threats
+    enum class AssignmentMode
+    {
+        Greedy, // One threat per call, soonest impact first, interceptor with the shortest time to go
+        Global  // Every eligible threat per call, minimum total time to go
+    };
+
+    // Stable reference to an inventory missile; stops resolving once the
+    // missile is launched or removed, unaffected by other removals
+    using MissileHandle = SlotMap<Missile>::Handle;
+
+    // Missile IDs must be non-negative and unique (std::invalid_argument otherwise)
+    MissileHandle addMissile(const Missile &missile);
     void moveAllMissiles(double dx, double dy, double dz);
     void printAllStatuses() const;
-    void launchMissile(Missile &missile, const Position &target);
+    void launchMissile(Missile &missile, const Position &target, int targetEnemyId = -1,
+                       int flightSteps = Missile::FLIGHT_STEPS);
     Missile *getMissileById(int id);
     bool removeMissileById(int id);
+    Missile *getMissile(MissileHandle handle);
+    MissileHandle getMissileHandle(int id) const; // Null handle when not in the inventory
+    bool removeMissile(MissileHandle handle);
     void detectIncomingMissiles();
     int interceptThreat(const ThreatReport& threat);
+
+    // Interceptor flight: launched missiles leave the inventory and advance
+    // `steps` ticks per call to updateFlights(). The returned buffer holds
+    // the missiles that arrived and is reused on the next call.
+    const std::vector<Missile>& updateFlights(int steps = 1);
+    const std::vector<Missile>& getInFlightMissiles() const;
+    size_t getInFlightCount() const;
+    bool isEnemyEngaged(int enemyId) const;
+    void printFlightStatuses() const;
+    // Replay support: replaces the in-flight list with missiles already launched and advanced
+    void restoreFlights(const std::vector<Missile>& flights);
     
     // Auto-intercept functionality
     void setAutoIntercept(bool enabled);
     bool isAutoInterceptEnabled() const;
     void setAutoInterceptThreshold(double threshold);
+    double getAutoInterceptThreshold() const;
+    // Enabled, with missiles in the inventory and launch budget left
+    bool canAutoIntercept() const;
     void setMaxAutoInterceptMissiles(int maxMissiles);
-    std::vector<int> autoInterceptThreats(const std::vector<ThreatReport>& threats);
+    // Sorts `threats` in place by priority. The returned list of engaged enemy
+    // IDs lives in the scratch arena, valid until the next call.
+    const std::pmr::vector<int>& autoInterceptThreats(std::vector<ThreatReport>& threats);
     void printAutoInterceptStatus() const;
+
+    // Global assignment settings: one solve covers at most `maxPairs` threats
+    // and gives up on optimality (finishing greedily) after `budget`
+    void setAssignmentMode(AssignmentMode mode);
+    AssignmentMode getAssignmentMode() const;
+    void setAssignmentLimits(size_t maxPairs, std::chrono::microseconds budget);
+    size_t getMaxAssignmentPairs() const;
+    const WeaponTargetAssigner& getAssigner() const; // State of the last solve
+    // Per-tick working memory of auto-intercept and manual intercepts; its
+    // high-water mark says how big a tick's engagement gets
+    const TickArena& getScratchArena() const;
+    // Sizes that memory up front for engagements known to need `bytes` (a
+    // measured high-water mark), so none of their ticks touch the heap
+    void reserveScratch(size_t bytes);
+
+    // Quiet mode drops all console output and launch animations (headless runs)
+    void setVerbose(bool enabled);
+    bool isVerbose() const;
     
     // Utility methods for auto-intercept
     int getAvailableMissileCount() const;
+    // Inventory by interceptor class: how many are ready, and one of them
+    // (null when there are none), both O(1)
+    size_t getReadyCount(InterceptorClass kind) const;
+    Missile* getReadyMissile(InterceptorClass kind);
+    const std::vector<Missile>& getMissiles() const; // Storage order, reshuffled by removals
     bool hasAvailableMissiles() const;
+    void prioritizeThreats(std::vector<ThreatReport>& threats) const; // Soonest impact first, in place
 
 private:
-    std::vector<Missile> missiles;
+    SlotMap<Missile> missiles;
+    std::vector<MissileHandle> handleById; // Dense missile ID -> inventory handle (null when absent)
+    // Type-indexed inventory: the IDs of each class's ready missiles
+    // (unordered, swap-and-pop) and each missile's position in its list
+    std::array<std::vector<int>, INTERCEPTOR_CLASS_COUNT> readyByClass;
+    std::vector<uint32_t> classSlotById;
+    std::vector<Missile> inFlight;
+    std::vector<Missile> arrivals;
+    std::vector<int> engagedEnemyIds; // Sorted, enemies with an interceptor already on the way
     
     // Auto-intercept settings
     bool autoInterceptEnabled = false;
     double autoInterceptThreshold = 2000.0;  // Only auto-intercept if threat is within this distance (km)
     int maxAutoInterceptMissiles = 3;        // Maximum missiles to use for auto-intercept
     int usedAutoInterceptMissiles = 0;       // Track how many we've used this session
-    
+    bool verbose = true;
+
+    // Global weapon-target assignment settings
+    AssignmentMode assignmentMode = AssignmentMode::Global;
+    size_t maxAssignmentPairs = 1024;
+    std::chrono::microseconds assignmentBudget{2000};
+
+    struct InterceptorColumn
+    {
+        size_t missileIndex;
+        Position position;
+        double speed;
+    };
+
+    // Everything one engagement call builds and throws away, allocated from
+    // the arena. Each call starts by dropping the previous working set and
+    // rewinding the arena, so none of it is ever freed piece by piece.
+    struct WorkingSet
+    {
+        explicit WorkingSet(std::pmr::memory_resource *resource);
+
+        std::pmr::vector<int> engagedThisCall;              // Result of autoInterceptThreats
+        std::pmr::vector<size_t> candidateThreats;          // Indices into the threat list, priority order
+        std::pmr::vector<InterceptorColumn> inventoryColumns; // Whole inventory, grouped by pad and speed
+        std::pmr::vector<InterceptorColumn> assignmentColumns;
+        std::pmr::vector<double> assignmentCosts;
+        InterceptSolver interceptSolver;                    // Columns mirror the interceptors being considered
+        std::pmr::vector<Position> rowPositions;            // Threat rows fed to the solver
+        std::pmr::vector<Position> rowVelocities;
+        std::pmr::vector<double> rowHorizons;               // Each threat's time to impact
+        std::pmr::vector<double> timesToGo;                 // Solver output, rows x columns
+        std::pmr::vector<std::pair<MissileHandle, size_t>> pendingLaunches; // (interceptor, assignment index)
+        WeaponTargetAssigner assigner;
+    };
+    // On the heap so the controller stays movable with the working set still
+    // pointing at its own arena
+    struct Scratch
+    {
+        Scratch() { working.emplace(&arena); }
+        TickArena arena;
+        std::optional<WorkingSet> working;
+    };
+    std::unique_ptr<Scratch> scratch = std::make_unique<Scratch>();
+
     // Helper methods
-    std::vector<ThreatReport> prioritizeThreats(const std::vector<ThreatReport>& threats) const;
+    WorkingSet& beginScratch(); // Fresh working set, the previous one is gone
     bool shouldInterceptThreat(const ThreatReport& threat) const;
-    Missile* selectBestInterceptor(const ThreatReport& threat);
+    // Inventory missile with the shortest time to go against `threat` (written to
+    // `timeToGo`), nullptr when none can catch it
+    Missile* selectBestInterceptor(const ThreatReport& threat, double& timeToGo);
+    void interceptGreedy(const std::vector<ThreatReport>& threats);
+    void interceptGlobal(const std::vector<ThreatReport>& threats);
+    // Fires at the predicted intercept point, the flight lasting the time to go
+    void launchAutoInterceptor(Missile& interceptor, const ThreatReport& threat, double timeToGo);
 };
 
 #endif
\ No newline at end of file
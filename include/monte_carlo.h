@@ -0,0 +1,80 @@
+#ifndef MONTE_CARLO_H
+#define MONTE_CARLO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#include "scenario.h"
+#include "missile_controller.h"
+#include "tick_profiler.h"
+
+// Monte Carlo engagement analysis: thousands of independent replicates of one
+// scenario, each with every track's launch point, speed and launch time
+// perturbed, run headless across a thread pool. Used to tune the
+// auto-intercept threshold and launch budget against a spread of raids
+// instead of a single run.
+//
+// Replicate r draws from its own RNG stream seeded by (seed, r) and writes
+// only its own result slot; assignment runs without a time budget. The
+// report is therefore bit-identical for any worker count.
+struct MonteCarloConfig
+{
+    size_t replicates = 1000;
+    long ticks = 1000; // Horizon of every replicate
+    uint64_t seed = 1;
+    size_t workers = 1;
+
+    // Perturbation of every track, drawn independently per replicate
+    double launchJitter = 250.0; // Launch point moved up to this far, uniform over a disk
+    double speedJitter = 0.10;   // Speed scaled by a factor in [1 - x, 1 + x]
+    long maxLaunchDelay = 20;    // Launch held back 0..N ticks (the track starts further out)
+
+    // Engagement settings under test
+    int maxAutoIntercept = 3;
+    double autoInterceptThreshold = 2000.0;
+    MissileController::AssignmentMode assignmentMode = MissileController::AssignmentMode::Global;
+};
+
+struct ReplicateResult
+{
+    uint64_t leakers = 0;   // Tracks that reached their target
+    uint64_t expended = 0;  // Interceptors launched
+    uint64_t destroyed = 0;
+    uint64_t survivors = 0; // Tracks still inbound at the horizon
+    long ticks = 0;         // Fewer than the horizon if every track was gone
+};
+
+// Summary of a sample, nearest-rank percentiles
+struct SampleSummary
+{
+    double mean = 0.0;
+    double stddev = 0.0;
+    uint64_t min = 0;
+    uint64_t p50 = 0;
+    uint64_t p90 = 0;
+    uint64_t p99 = 0;
+    uint64_t max = 0;
+
+    static SampleSummary of(std::vector<uint64_t> values);
+};
+
+struct MonteCarloReport
+{
+    MonteCarloConfig config;
+    std::vector<ReplicateResult> replicates; // Replicate order
+    // Ticks from a track's first threat report to the launch at it, every
+    // engagement of every replicate
+    LatencyHistogram timeToEngage;
+    double elapsedSeconds = 0.0;
+
+    SampleSummary leakers() const;
+    SampleSummary expended() const;
+    double leakProbability() const; // Share of replicates with at least one leaker
+    void print(std::ostream &out) const;
+};
+
+// Throws std::invalid_argument without replicates
+MonteCarloReport runMonteCarlo(const Scenario &scenario, const MonteCarloConfig &config);
+
+#endif // MONTE_CARLO_H
@@ -0,0 +1,22 @@
+#ifndef NAME_TABLE_H
+#define NAME_TABLE_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Interns strings into small integer IDs so per-tick records can carry a name
+// without owning (and allocating) a std::string
+class NameTable
+{
+public:
+    int intern(const std::string &name);
+    const std::string &getName(int nameId) const;
+    size_t size() const { return names.size(); }
+
+private:
+    std::vector<std::string> names;
+    std::unordered_map<std::string, int> idsByName;
+};
+
+#endif // NAME_TABLE_H
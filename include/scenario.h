@@ -0,0 +1,90 @@
+#ifndef SCENARIO_H
+#define SCENARIO_H
+
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <memory>
+#include "position.h"
+#include "geodetic.h"
+#include "target.h"
+#include "enemy_missile.h"
+#include "sensor_network.h"
+
+class MappedScenarioFile;
+
+struct LaunchPad
+{
+    std::string name;
+    GeodeticPosition location; // WGS-84
+    Position position;         // In the scenario's local frame
+};
+
+// Configuration structure for missile initialization
+struct MissileConfig
+{
+    int damage;
+    std::string name;
+    double speed;
+    Position position;
+};
+
+// Everything needed to start a simulation: our interceptors, the sites we
+// protect, the incoming enemy tracks and, optionally, the radars watching them.
+// Pads and targets are located in WGS-84 and converted once, when added, into
+// `frame`, the east-north-up frame every position in the simulation is in.
+struct Scenario
+{
+    LocalFrame frame;
+    std::vector<LaunchPad> pads;
+    std::vector<MissileConfig> interceptors; // Positions are the pad positions
+    std::vector<Target> targets;
+    std::vector<EnemyMissile> enemies;
+    std::vector<RadarSite> radars; // Empty = one ideal sensor that sees every track
+    double radarNoise = 0.0;       // Measurement error of that sensor, 1 sigma per axis; 0 = perfect
+
+    // Tracks still in a binary scenario file, mapped straight into the track
+    // store instead of being copied into `enemies`
+    std::shared_ptr<const MappedScenarioFile> trackFile;
+
+    size_t trackCount() const;
+
+    // Moves the frame origin; call before adding anything located
+    void setOrigin(const GeodeticPosition &origin);
+    void addPad(const std::string &name, const GeodeticPosition &location);
+    void addTarget(int id, const std::string &name, const GeodeticPosition &location);
+
+    // The hand-built demo theater used by the interactive menu
+    static Scenario makeDefault();
+
+    // A synthetic saturation salvo against the default targets, deterministic for a given seed
+    static Scenario makeSalvo(size_t trackCount, size_t interceptorCount, unsigned seed = 1);
+
+    // `trackCount` synthetic tracks on a ring around this scenario's targets,
+    // level with each target
+    void addSalvo(size_t trackCount, unsigned seed = 1, int firstId = 1000);
+
+    // `count` radars shared out evenly between the targets and spread evenly
+    // over the disk of `coverRadius` around each, on its ground plane, ranges
+    // overlapping so most points are seen by about three of them
+    void addRadarNetwork(size_t count, double coverRadius = 10000.0);
+
+    // Text format, one entity per line (`#` starts a comment, names may be
+    // quoted). Locations are WGS-84 degrees and metres; the frame origin is
+    // the `origin` entry, or the first pad or target without one.
+    //   origin <lat> <lon> <alt>
+    //   pad "<name>" <lat> <lon> <alt>
+    //   interceptor "<name>" <damage> <speed> "<pad name>" [count]
+    //   target <id> "<name>" <lat> <lon> <alt>
+    //   track <id> <lat> <lon> <alt> <speed> <target id>
+    //   salvo <count> [seed]
+    // Throws std::runtime_error with the offending line on bad input.
+    static Scenario loadText(const std::string &path);
+
+    // Versioned binary format (scenario_file.h). Loading maps the file; the
+    // tracks are not read until the simulation touches them.
+    static Scenario loadBinary(const std::string &path);
+    void saveBinary(const std::string &path) const;
+};
+
+#endif // SCENARIO_H
@@ -0,0 +1,122 @@
+#ifndef SCENARIO_FILE_H
+#define SCENARIO_FILE_H
+
+// On-disk layout of binary scenario files (.nsc) and the mapped reader.
+//
+// A file is a fixed header, fixed-size records for launch pads, interceptors
+// and targets, a string table for their names, and a page-aligned track
+// section. The track section holds the TrackStore columns back to back (each
+// 64-byte aligned) exactly as the store uses them, including the dense
+// ID -> row index, so loading is a mapping rather than a parse. Pads and
+// targets are WGS-84 locations; track columns are in the local frame around
+// the header's origin (geodetic.h), ready to simulate. All values are stored
+// in host byte order; `byteOrder` catches files from the other kind.
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "track_store.h"
+
+namespace scenario_file
+{
+    const char MAGIC[8] = {'N', 'O', 'R', 'A', 'D', 'S', 'C', 'N'};
+    const uint32_t VERSION = 2;
+    const uint32_t BYTE_ORDER_MARK = 0x01020304;
+    const uint64_t COLUMN_ALIGNMENT = 64;
+
+    enum TrackColumnId
+    {
+        COLUMN_IDS,        // int32
+        COLUMN_X,          // double
+        COLUMN_Y,
+        COLUMN_Z,
+        COLUMN_TARGET_X,
+        COLUMN_TARGET_Y,
+        COLUMN_TARGET_Z,
+        COLUMN_SPEED,
+        COLUMN_TARGET_ID,  // int32
+        COLUMN_INDEX_BY_ID, // int32, trackIndexSize entries
+        TRACK_COLUMN_COUNT
+    };
+
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrder;
+        uint64_t headerSize;
+        uint64_t fileSize;
+
+        uint64_t padCount;
+        uint64_t padOffset;
+        uint64_t interceptorCount;
+        uint64_t interceptorOffset;
+        uint64_t targetCount;
+        uint64_t targetOffset;
+        uint64_t stringsSize;
+        uint64_t stringsOffset;
+
+        uint64_t trackCount;
+        uint64_t trackIndexSize;
+        uint64_t trackSectionOffset; // Page aligned so it can be mapped on its own
+        uint64_t trackSectionSize;
+        uint64_t columnOffsets[TRACK_COLUMN_COUNT]; // Relative to trackSectionOffset
+
+        double originLatitude; // Of the local frame, degrees and metres
+        double originLongitude;
+        double originAltitude;
+    };
+
+    struct PadRecord
+    {
+        uint32_t nameOffset;
+        uint32_t nameLength;
+        double latitude, longitude, altitude;
+    };
+
+    struct InterceptorRecord
+    {
+        int32_t damage;
+        uint32_t padIndex;
+        uint32_t nameOffset;
+        uint32_t nameLength;
+        double speed;
+    };
+
+    struct TargetRecord
+    {
+        int32_t id;
+        uint32_t nameOffset;
+        uint32_t nameLength;
+        uint32_t reserved;
+        double latitude, longitude, altitude;
+    };
+}
+
+// A validated, read-only mapping of a binary scenario file. Every call to
+// mapTracks() makes a fresh copy-on-write mapping of the track section, so
+// each simulation moves its own tracks while untouched pages stay shared.
+class MappedScenarioFile
+{
+public:
+    explicit MappedScenarioFile(const std::string &path); // Throws std::runtime_error
+    ~MappedScenarioFile();
+    MappedScenarioFile(const MappedScenarioFile &) = delete;
+    MappedScenarioFile &operator=(const MappedScenarioFile &) = delete;
+
+    const scenario_file::Header &header() const { return *reinterpret_cast<const scenario_file::Header *>(base); }
+    const unsigned char *bytes() const { return base; }
+    size_t trackCount() const { return header().trackCount; }
+    const std::string &getPath() const { return path; }
+
+    TrackStore::ExternalColumns mapTracks() const;
+
+private:
+    std::string path;
+    int fd = -1;
+    unsigned char *base = nullptr;
+    size_t size = 0;
+};
+
+#endif // SCENARIO_FILE_H
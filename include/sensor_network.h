@@ -0,0 +1,64 @@
+#ifndef SENSOR_NETWORK_H
+#define SENSOR_NETWORK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "position.h"
+#include "track_fusion.h"
+
+class TrackStore;
+class ThreadPool;
+
+struct RadarSite
+{
+    std::string name;
+    Position position;
+    double range = 10000.0;
+    int scanInterval = 1;       // Ticks between scans
+    double noise = 2.0;         // Position error, 1 sigma per axis
+    double velocityNoise = 1.0; // Velocity error, 1 sigma per axis and tick
+};
+
+// Radar sites watching the true tracks. Every tick the sites due for a scan
+// report a noisy plot (position and velocity) of each track within their
+// range; the plots go
+// through TrackFusion, which turns the duplicates into one system track per
+// object. Sites are staggered (site i scans when (tick + i) is a multiple of
+// its interval) and scan in parallel on up to `workers` threads, each into its
+// own buffer, so the result is the same for any worker count.
+class SensorNetwork
+{
+public:
+    // Throws std::invalid_argument for a site without range or scan interval,
+    // or with negative noise
+    SensorNetwork(const TrackStore &truth, std::vector<RadarSite> sites);
+    ~SensorNetwork();
+    SensorNetwork(const SensorNetwork &) = delete;
+    SensorNetwork &operator=(const SensorNetwork &) = delete;
+
+    // Scans and fuses tick `tick`, returns the system tracks (fusion order)
+    const std::vector<SystemTrack> &update(long tick);
+    const std::vector<SystemTrack> &getTracks() const { return fusion.getTracks(); }
+
+    void setWorkerCount(size_t workers);
+    const std::vector<RadarSite> &getSites() const { return sites; }
+    const TrackFusion &getFusion() const { return fusion; }
+    uint64_t getPlotCount() const { return plotCount; } // All scans so far
+
+private:
+    const TrackStore &truth;
+    std::vector<RadarSite> sites;
+    TrackFusion fusion;
+    std::unique_ptr<ThreadPool> pool;
+    std::vector<std::vector<Plot>> sitePlots; // Per site, reused
+    std::vector<size_t> dueSites;
+    std::vector<Plot> plots;                  // This tick's plots, grouped by site
+    uint64_t plotCount = 0;
+
+    void scanSite(size_t site, long tick, std::vector<Plot> &out) const;
+};
+
+#endif // SENSOR_NETWORK_H
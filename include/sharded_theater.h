@@ -0,0 +1,99 @@
+#ifndef SHARDED_THEATER_H
+#define SHARDED_THEATER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#include "position.h"
+#include "scenario.h"
+#include "simulation.h"
+#include "missile_controller.h"
+
+// Spatial partition of the theater into shards: a k-d tree of median cuts,
+// each on the widest axis of the points it splits, so every shard starts with
+// about the same number of tracks. Tracks converge radially on their targets
+// and the cuts through a ring of tracks pass near its centre, so most tracks
+// stay in one shard all the way in.
+class ShardMap
+{
+public:
+    ShardMap() = default; // One shard holding everything
+
+    // Throws std::invalid_argument for zero shards
+    static ShardMap balanced(std::vector<Position> points, size_t shards);
+
+    size_t size() const { return shardCount; }
+    size_t shardOf(const Position &position) const;
+
+private:
+    // Children >= 0 are nodes, < 0 are leaves holding shard ~child
+    struct Node
+    {
+        int axis;
+        double split; // Below goes low, the rest high
+        int32_t low;
+        int32_t high;
+    };
+
+    std::vector<Node> nodes;
+    size_t shardCount = 1;
+
+    int32_t build(Position *begin, Position *end, size_t firstShard, size_t shards);
+};
+
+// Multi-process theater simulation: the scenario is split into spatial shards
+// (ShardMap over the launch points) and every shard runs in its own forked
+// worker process, with its own track store, radar and the interceptors on
+// the pads inside it. The coordinator (the calling process) and the workers
+// meet at a tick barrier in shared memory, so every shard runs tick N before
+// any runs tick N + 1.
+//
+// After each tick a worker hands the tracks that left its region to their new
+// shard through a single-producer single-consumer ring in shared memory, one
+// per (from, to) pair; the receiver adds them before its next tick, exactly
+// when the single-process simulation would see them there. A full ring keeps
+// the track one more tick and retries. Engagement is shard-local: a shard
+// only engages the threats inside it, and an interceptor in flight at a track
+// that changes shard loses it.
+struct ShardedConfig
+{
+    size_t shards = 2;
+    long ticks = 1000;
+    size_t scanWorkers = 1;     // Radar scan threads inside each shard
+    size_t ringCapacity = 16384; // Handovers each ring holds, rounded up to a power of two
+
+    // Engagement settings of every shard
+    int maxAutoIntercept = 3;
+    double autoInterceptThreshold = 2000.0;
+    MissileController::AssignmentMode assignmentMode = MissileController::AssignmentMode::Global;
+};
+
+struct ShardResult
+{
+    SimulationStats stats;         // elapsedSeconds is the shard's own tick time, barrier waits excluded
+    uint64_t initialTracks = 0;
+    uint64_t interceptors = 0;
+    uint64_t handedOut = 0;        // Tracks sent to another shard
+    uint64_t handedIn = 0;
+    uint64_t handoverRetries = 0;  // Handovers held back a tick by a full ring
+    double barrierWaitSeconds = 0.0;
+};
+
+struct ShardedReport
+{
+    ShardedConfig config;
+    std::vector<ShardResult> shards; // Shard order
+    SimulationStats total;           // Summed over shards; elapsedSeconds is wall time of the ticks
+    double setupSeconds = 0.0;       // Fork to the first tick: partitioning and every shard's world
+
+    uint64_t handovers() const;
+    void print(std::ostream &out) const;
+};
+
+// Throws std::invalid_argument for zero shards or a scenario with radar sites
+// or a noisy radar (their sensor state is not handed over), and
+// std::runtime_error if shared memory can't be set up or a worker fails.
+ShardedReport runSharded(const Scenario &scenario, const ShardedConfig &config);
+
+#endif // SHARDED_THEATER_H
@@ -0,0 +1,132 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <vector>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "scenario.h"
+#include "track_store.h"
+#include "missile_controller.h"
+#include "detection_system.h"
+#include "tick_profiler.h"
+#include "event_scheduler.h"
+
+// Counters collected while the world is advanced
+struct SimulationStats
+{
+    long ticks = 0;
+    uint64_t trackSteps = 0;      // Sum of live tracks over all ticks
+    uint64_t threatReports = 0;   // Sum of threat reports over all ticks
+    uint64_t interceptsLaunched = 0;
+    uint64_t enemiesDestroyed = 0;
+    uint64_t impacts = 0;         // Tracks that reached their target
+    uint64_t eventsProcessed = 0; // Event-driven core only
+    double elapsedSeconds = 0.0;
+
+    double ticksPerSecond() const;
+    double tracksPerSecond() const;
+};
+
+class TickRecorder;
+class WorldPublisher;
+struct OperatorCommand;
+
+// Owns the whole simulated world: protected targets, enemy tracks, our
+// interceptors and the radar watching them. With radar sites in the scenario
+// threats come from their fused tracks (sensor_network.h) instead of the
+// ideal radar that sees every track as it is.
+class Simulation
+{
+public:
+    explicit Simulation(const Scenario &scenario);
+    Simulation(const Simulation &) = delete;
+    Simulation &operator=(const Simulation &) = delete;
+    ~Simulation();
+
+    // One fixed timestep: move enemies, advance interceptor flights, scan, auto-intercept
+    void tick();
+
+    // The two halves of tick() for the pipelined live view (tick_pipeline.h).
+    // They may run on different threads at once: sensing touches only the
+    // tracks, the radar and its own counters (ticks, track steps, threat
+    // reports, impacts, destroyed enemies), engaging only the controller and
+    // the launch counter.
+    // Removes `destroyedIds` (interceptor kills reported by engageTick), moves
+    // the tracks, scans and drops impacts; returns the radar's report buffer
+    std::vector<ThreatReport> &senseTick(const std::vector<int> &destroyedIds);
+    void removeDestroyed(const std::vector<int> &destroyedIds);
+    // Advances the flights `steps` ticks (more than one after skipped frames),
+    // appending the enemies hit by arrivals to `destroyedIds`, then
+    // auto-intercepts `threats` (sorted in place)
+    void engageTick(std::vector<ThreatReport> &threats, std::vector<int> &destroyedIds, int steps = 1);
+    // Engaging half too: carries out an operator's controller command
+    // (launch, intercept, the auto-intercept settings, status) against this
+    // tick's `threats` and returns what it did. Throws std::invalid_argument when the
+    // command can't be carried out, and for commands that aren't for the controller.
+    std::string applyCommand(const OperatorCommand &command, const std::vector<ThreatReport> &threats);
+
+    // Headless batch mode: run `ticks` steps as fast as possible with no
+    // terminal output and no sleeps (stops early if every track is gone).
+    // Auto-intercept is on for the run; verbosity and auto-intercept are
+    // restored afterwards
+    SimulationStats runHeadless(long ticks);
+
+    // Same world as runHeadless, but instead of stepping every tick the
+    // straight-line tracks are solved for the ticks they enter threat range,
+    // cross the auto-intercept threshold and impact. Those events (plus
+    // interceptor arrivals) sit in a priority queue and simulated time jumps
+    // from one to the next, so quiet stretches cost nothing. Positions are
+    // brought up to date once, at the end. Throws std::runtime_error while
+    // recording, the tick log needs every tick, and with radar sites or a
+    // noisy radar, whose measurements change every tick.
+    SimulationStats runEventDriven(long ticks);
+
+    // Streams every following tick to a log (see tick_recorder.h); throws
+    // std::runtime_error if the file can't be written or the threats come from
+    // radar sites or a noisy radar (replay re-runs the perfect one)
+    void startRecording(const std::string &path, int keyframeInterval = 100);
+    void stopRecording();
+    const TickRecorder *getRecorder() const { return recorder.get(); }
+    TickRecorder *getRecorder() { return recorder.get(); }
+
+    // Publishes every following tick's tracks, threats and interceptors to the
+    // POSIX shared-memory object `name` for external readers (world_snapshot.h),
+    // sized for the tracks and interceptors there are now. tick() and the
+    // pipelined live view publish; the event-driven core skips the ticks in
+    // between and doesn't. Throws std::runtime_error if the region can't be created.
+    void startPublishing(const std::string &name);
+    void stopPublishing();
+    const WorldPublisher *getPublisher() const { return publisher.get(); }
+    WorldPublisher *getPublisher() { return publisher.get(); }
+
+    MissileController &getController() { return controller; }
+    TrackStore &getEnemies() { return enemies; }
+    const std::vector<Target> &getTargets() const { return targets; }
+    DetectionSystem &getRadar() { return radar; }
+    SensorNetwork *getSensors() { return sensors.get(); } // Null without radar sites
+    const std::vector<ThreatReport> &getThreats() const { return radar.getLastThreats(); }
+    const SimulationStats &getStats() const { return stats; }
+    // Per-phase latency of every tick (empty unless built with NORAD_TICK_PROFILING)
+    TickProfiler &getProfiler() { return profiler; }
+
+private:
+    // Declaration order matters: the radar keeps references to targets and enemies
+    std::vector<Target> targets;
+    GeodeticPosition origin; // Of the scenario's local frame
+    TrackStore enemies;
+    MissileController controller;
+    DetectionSystem radar;
+    std::unique_ptr<SensorNetwork> sensors;
+    SimulationStats stats;
+    TickProfiler profiler;
+    std::unique_ptr<TickRecorder> recorder;
+    std::unique_ptr<WorldPublisher> publisher;
+    EventScheduler events;
+
+    SimulationStats statsSince(const SimulationStats &before) const;
+    std::vector<ThreatReport> &scan(); // Radar sites if there are any, the ideal radar otherwise
+    void removeImpacts(std::vector<ThreatReport> &threats);
+};
+
+#endif // SIMULATION_H
@@ -0,0 +1,121 @@
+#ifndef SLOT_MAP_H
+#define SLOT_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Dense storage with stable generational handles.
+// Values live contiguously (iteration order is unspecified); removal is
+// swap-and-pop. A handle names a slot plus the generation it was issued in,
+// so handles to removed values stop resolving instead of aliasing new ones.
+template <typename T>
+class SlotMap
+{
+public:
+    struct Handle
+    {
+        uint32_t slot = UINT32_MAX;
+        uint32_t generation = 0;
+
+        bool isNull() const { return slot == UINT32_MAX; }
+        bool operator==(const Handle &other) const { return slot == other.slot && generation == other.generation; }
+        bool operator!=(const Handle &other) const { return !(*this == other); }
+    };
+
+    Handle insert(T value)
+    {
+        uint32_t slot;
+        if (freeSlots.empty())
+        {
+            slot = static_cast<uint32_t>(slots.size());
+            slots.push_back({0, 0});
+            // Keep room to free every slot, so erase never allocates
+            if (freeSlots.capacity() < slots.capacity())
+            {
+                freeSlots.reserve(slots.capacity());
+            }
+        }
+        else
+        {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        }
+
+        slots[slot].denseIndex = static_cast<uint32_t>(values.size());
+        values.push_back(std::move(value));
+        denseToSlot.push_back(slot);
+        return {slot, slots[slot].generation};
+    }
+
+    bool erase(Handle handle)
+    {
+        if (!contains(handle))
+        {
+            return false;
+        }
+
+        // Move the last value into the hole and repoint its slot
+        uint32_t index = slots[handle.slot].denseIndex;
+        uint32_t last = static_cast<uint32_t>(values.size() - 1);
+        if (index != last)
+        {
+            values[index] = std::move(values[last]);
+            denseToSlot[index] = denseToSlot[last];
+            slots[denseToSlot[index]].denseIndex = index;
+        }
+        values.pop_back();
+        denseToSlot.pop_back();
+
+        // Retire the slot: outstanding handles to it no longer match
+        ++slots[handle.slot].generation;
+        freeSlots.push_back(handle.slot);
+        return true;
+    }
+
+    bool contains(Handle handle) const
+    {
+        // Freed slots bump their generation, so a matching one is always live
+        return handle.slot < slots.size() && slots[handle.slot].generation == handle.generation;
+    }
+
+    T *get(Handle handle) { return contains(handle) ? &values[slots[handle.slot].denseIndex] : nullptr; }
+    const T *get(Handle handle) const { return contains(handle) ? &values[slots[handle.slot].denseIndex] : nullptr; }
+
+    // Handle of the value at a dense position
+    Handle handleAt(size_t index) const
+    {
+        uint32_t slot = denseToSlot[index];
+        return {slot, slots[slot].generation};
+    }
+
+    void reserve(size_t count)
+    {
+        values.reserve(count);
+        denseToSlot.reserve(count);
+        slots.reserve(count);
+        freeSlots.reserve(count);
+    }
+
+    size_t size() const { return values.size(); }
+    bool empty() const { return values.empty(); }
+
+    // Dense view of every live value
+    std::vector<T> &data() { return values; }
+    const std::vector<T> &data() const { return values; }
+
+private:
+    struct Slot
+    {
+        uint32_t denseIndex;
+        uint32_t generation;
+    };
+
+    std::vector<T> values;
+    std::vector<uint32_t> denseToSlot;
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+};
+
+#endif // SLOT_MAP_H
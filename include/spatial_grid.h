@@ -0,0 +1,129 @@
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "position.h"
+
+// Uniform grid over the x/y plane for fixed-radius neighbour queries.
+// build() buckets points by cell with a hash table and a counting sort, so
+// building and querying are linear in the number of points. A query looks at
+// the cells its square overlaps: at most 2x2 when the radius is no more than
+// half the cell size.
+// Buffers are kept between builds, a grid rebuilt every tick stops allocating
+// once it has seen its largest input.
+class SpatialGrid
+{
+public:
+    // Points are referred to by their index in the array given to build()
+    void build(const Position *points, size_t count, double cellSize)
+    {
+        this->cellSize = cellSize;
+        inverseCell = 1.0 / cellSize;
+
+        size_t slots = 16;
+        while (slots < count * 2)
+        {
+            slots <<= 1;
+        }
+        slotMask = slots - 1;
+        slotKeys.assign(slots, EMPTY);
+        slotCounts.assign(slots, 0);
+        slotStarts.resize(slots);
+        pointSlots.resize(count);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint64_t key = cellKey(cellOf(points[i].x), cellOf(points[i].y));
+            size_t slot = probe(key);
+            slotKeys[slot] = key;
+            pointSlots[i] = static_cast<uint32_t>(slot);
+            ++slotCounts[slot];
+        }
+        uint32_t start = 0;
+        for (size_t slot = 0; slot < slots; ++slot)
+        {
+            slotStarts[slot] = start;
+            start += slotCounts[slot];
+        }
+        order.resize(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            order[slotStarts[pointSlots[i]]++] = static_cast<uint32_t>(i);
+        }
+        // Scattering moved every start to the end of its cell, step back
+        for (size_t slot = 0; slot < slots; ++slot)
+        {
+            slotStarts[slot] -= slotCounts[slot];
+        }
+    }
+
+    // Calls visit(index) for every point in the cells overlapping the square
+    // of `radius` around `position`: a superset of the points within radius
+    template <typename Visit>
+    void forEachNear(const Position &position, double radius, Visit &&visit) const
+    {
+        if (order.empty())
+        {
+            return;
+        }
+        int64_t xEnd = cellOf(position.x + radius);
+        int64_t yBegin = cellOf(position.y - radius);
+        int64_t yEnd = cellOf(position.y + radius);
+        for (int64_t x = cellOf(position.x - radius); x <= xEnd; ++x)
+        {
+            for (int64_t y = yBegin; y <= yEnd; ++y)
+            {
+                size_t slot = probe(cellKey(x, y));
+                if (slotKeys[slot] == EMPTY)
+                {
+                    continue;
+                }
+                const uint32_t *begin = order.data() + slotStarts[slot];
+                for (const uint32_t *it = begin; it != begin + slotCounts[slot]; ++it)
+                {
+                    visit(static_cast<size_t>(*it));
+                }
+            }
+        }
+    }
+
+    double getCellSize() const { return cellSize; }
+
+private:
+    static constexpr uint64_t EMPTY = UINT64_MAX;
+
+    double cellSize = 1.0;
+    double inverseCell = 1.0;
+    size_t slotMask = 0;
+    std::vector<uint64_t> slotKeys; // Open addressing, linear probing
+    std::vector<uint32_t> slotCounts;
+    std::vector<uint32_t> slotStarts; // Into `order`
+    std::vector<uint32_t> pointSlots;
+    std::vector<uint32_t> order; // Point indices grouped by cell
+
+    int64_t cellOf(double coordinate) const { return static_cast<int64_t>(std::floor(coordinate * inverseCell)); }
+
+    // Biased so cell (-1, -1) doesn't collide with EMPTY
+    static uint64_t cellKey(int64_t x, int64_t y)
+    {
+        const uint64_t bias = uint64_t(1) << 31;
+        return ((static_cast<uint64_t>(x) + bias) << 32) | ((static_cast<uint64_t>(y) + bias) & 0xffffffffu);
+    }
+
+    // Slot holding `key`, or the empty slot where it would go
+    size_t probe(uint64_t key) const
+    {
+        // Fibonacci hashing spreads neighbouring cells over the table
+        size_t slot = static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & slotMask;
+        while (slotKeys[slot] != key && slotKeys[slot] != EMPTY)
+        {
+            slot = (slot + 1) & slotMask;
+        }
+        return slot;
+    }
+};
+
+#endif // SPATIAL_GRID_H
@@ -0,0 +1,91 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Bounded lock-free ring for exactly one producer thread and one consumer
+// thread. Neither side ever blocks: tryPush fails when the ring is full and
+// tryPop when it is empty, so the caller decides whether to drop, retry or wait.
+// Each side also keeps a private copy of the other's index and only rereads
+// the shared one when that copy says full (or empty), so the cache line
+// ping-pong is paid once per burst instead of once per element.
+template <typename T>
+class SpscQueue
+{
+public:
+    // Capacity is rounded up to a power of two
+    explicit SpscQueue(size_t capacity)
+    {
+        size_t size = 2;
+        while (size < capacity)
+        {
+            size <<= 1;
+        }
+        slots.resize(size);
+        mask = size - 1;
+    }
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    size_t capacity() const { return slots.size(); }
+
+    // Producer side
+    bool tryPush(T value)
+    {
+        size_t tail = producer.tail.load(std::memory_order_relaxed);
+        if (tail - producer.cachedHead == slots.size())
+        {
+            producer.cachedHead = consumer.head.load(std::memory_order_acquire);
+            if (tail - producer.cachedHead == slots.size())
+            {
+                return false;
+            }
+        }
+        slots[tail & mask] = std::move(value);
+        producer.tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side; the slot is reset so it doesn't keep the value alive
+    bool tryPop(T &out)
+    {
+        size_t head = consumer.head.load(std::memory_order_relaxed);
+        if (head == consumer.cachedTail)
+        {
+            consumer.cachedTail = producer.tail.load(std::memory_order_acquire);
+            if (head == consumer.cachedTail)
+            {
+                return false;
+            }
+        }
+        out = std::move(slots[head & mask]);
+        slots[head & mask] = T();
+        consumer.head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    static const size_t CACHE_LINE = 64;
+
+    std::vector<T> slots;
+    size_t mask;
+
+    // Each index on its own cache line, next to the side that writes it
+    struct alignas(CACHE_LINE) ProducerState
+    {
+        std::atomic<size_t> tail{0};
+        size_t cachedHead = 0;
+    };
+    struct alignas(CACHE_LINE) ConsumerState
+    {
+        std::atomic<size_t> head{0};
+        size_t cachedTail = 0;
+    };
+    ProducerState producer;
+    ConsumerState consumer;
+};
+
+#endif // SPSC_QUEUE_H
@@ -3,11 +3,14 @@
 
 #include <string>
 #include "position.h" // The Target struct needs to know about Position
+#include "geodetic.h"
 
 struct Target
 {
+    int id; // Handle enemy tracks use to reference this target
     std::string name;
-    Position position;
+    GeodeticPosition location; // WGS-84
+    Position position;         // The same point in the simulation's local frame, converted once
 };
 
 #endif // TARGET_H
\ No newline at end of file
@@ -0,0 +1,73 @@
+#ifndef TERMINAL_RENDERER_H
+#define TERMINAL_RENDERER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Double-buffered terminal renderer. A frame is drawn into an off-screen
+// cell buffer, present() diffs it against what is already on screen and
+// sends only the changed cells (with cursor-addressing escapes) in a
+// single write.
+class TerminalRenderer
+{
+public:
+    enum class Color : uint8_t
+    {
+        Default,
+        Red,
+        Green,
+        Yellow,
+        Blue,
+        Magenta,
+        Cyan
+    };
+
+    struct Style
+    {
+        Color color = Color::Default;
+        bool bold = false;
+    };
+
+    explicit TerminalRenderer(int fd = 1);
+
+    // Starts a new frame: picks up the terminal size and blanks the back buffer
+    void beginFrame();
+
+    // Draws UTF-8 text at (row, col), clipped to the screen. Returns the column after the text.
+    int print(int row, int col, const std::string &text, Style style);
+    int print(int row, int col, const std::string &text) { return print(row, col, text, Style()); }
+
+    // Sends the difference between the back buffer and the screen
+    void present();
+
+    // Forget what is on screen so the next present() redraws everything
+    void invalidate();
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    size_t getLastPresentBytes() const { return lastPresentBytes; }
+
+private:
+    struct Cell
+    {
+        uint32_t codepoint = ' '; // 0 marks the right half of a double-width glyph
+        Style style;
+    };
+
+    int fd;
+    int rows = 0;
+    int cols = 0;
+    std::vector<Cell> back;
+    std::vector<Cell> front;
+    bool frontValid = false;
+    std::string output;
+    size_t lastPresentBytes = 0;
+
+    static bool sameCell(const Cell &a, const Cell &b);
+    void appendStyle(Style style);
+    void appendCodepoint(uint32_t codepoint);
+    void writeOutput();
+};
+
+#endif // TERMINAL_RENDERER_H
@@ -0,0 +1,57 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Fixed-size pool for data-parallel loops. The calling thread takes part in
+// every parallelFor, so a pool of size N owns N - 1 background threads.
+class ThreadPool
+{
+public:
+    explicit ThreadPool(size_t workerCount);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    size_t size() const { return threads.size() + 1; }
+
+    // Runs task(chunk) for every chunk in [0, chunkCount) and blocks until all
+    // have finished. Chunks are handed out dynamically; callers that need a
+    // deterministic result must write per-chunk output, not per-thread output.
+    // The task is called through a plain function pointer, so no std::function
+    // (and no heap allocation) is involved.
+    template <typename Task>
+    void parallelFor(size_t chunkCount, Task &&task)
+    {
+        run(chunkCount, [](void *context, size_t chunk)
+            { (*static_cast<typename std::remove_reference<Task>::type *>(context))(chunk); },
+            const_cast<void *>(static_cast<const void *>(&task)));
+    }
+
+private:
+    using TaskFn = void (*)(void *, size_t);
+
+    void run(size_t chunkCount, TaskFn task, void *context);
+    void workerLoop();
+    void runChunks();
+
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+
+    TaskFn currentTask = nullptr;
+    void *currentContext = nullptr;
+    size_t chunkTotal = 0;
+    size_t nextChunk = 0;
+    size_t chunksDone = 0;
+    unsigned long generation = 0;
+    bool stopping = false;
+};
+
+#endif // THREAD_POOL_H
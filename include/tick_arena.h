@@ -0,0 +1,50 @@
+#ifndef TICK_ARENA_H
+#define TICK_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+
+// Monotonic scratch memory for data that only lives for one tick.
+// Allocation bumps a pointer through one retained block, deallocation does
+// nothing, and reset() rewinds the block in O(1) once the tick's data is dead.
+// A tick that needs more than the block spills into the heap; the next
+// reset() then regrows the block past that high-water mark, so a steady
+// workload stops touching the heap after its first few ticks. Hand it to
+// std::pmr containers (or anything taking a std::pmr::memory_resource).
+class TickArena : public std::pmr::memory_resource
+{
+public:
+    explicit TickArena(size_t initialBytes = 64 * 1024);
+    TickArena(const TickArena &) = delete;
+    TickArena &operator=(const TickArena &) = delete;
+
+    // Everything allocated since the last reset must be gone (or never touched again)
+    void reset();
+    // Grows the block to at least `bytes` right away, so ticks up to that size
+    // never spill; a reset() with the same precondition
+    void reserve(size_t bytes);
+
+    size_t getCapacity() const { return capacity; }               // Current block size
+    size_t getUsed() const { return offset + spilledBytes; }      // Since the last reset
+    size_t getHighWater() const;                                  // Most used by any one tick
+    uint64_t getResetCount() const { return resets; }
+    uint64_t getOverflowCount() const { return overflows; }       // Ticks that spilled into the heap
+
+private:
+    std::unique_ptr<std::byte[]> block;
+    size_t capacity;
+    size_t offset = 0;
+    size_t spilledBytes = 0;
+    size_t highWater = 0;
+    uint64_t resets = 0;
+    uint64_t overflows = 0;
+    std::pmr::monotonic_buffer_resource spill{std::pmr::new_delete_resource()};
+
+    void *do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void *, size_t, size_t) override {} // Released in bulk by reset()
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+};
+
+#endif // TICK_ARENA_H
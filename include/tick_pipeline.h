@@ -0,0 +1,132 @@
+#ifndef TICK_PIPELINE_H
+#define TICK_PIPELINE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "simulation.h"
+#include "command_channel.h"
+#include "spsc_queue.h"
+
+// The live view's tick split into stages on their own threads:
+//   sensor      removes killed tracks, moves, scans and drops impacts at the
+//               tick rate (owns the track store and the radar)
+//   engagement  advances interceptor flights and decides launches for every
+//               sensor frame (owns the missile controller)
+//   render/log  the caller's thread: polls the newest frame to draw and
+//               writes every frame to the tick log and the shared-memory
+//               snapshot, if they are enabled
+// Stages hand each other immutable, shared frames through lock-free SPSC
+// queues; kills flow back from engagement to sensor the same way. Neither
+// sensor nor engagement ever waits on the stage after it: when a queue is
+// full the frame is dropped, and an engagement stage that falls behind skips
+// to the newest sensor frame (flights still advance by the ticks skipped).
+// After a dropped frame the log resynchronizes with a keyframe.
+// Kills land on the sensor's next tick, one tick later than in tick().
+// Operator commands for the controller queue up for the engagement stage,
+// which applies them between two engaged ticks (to the threats it engaged
+// last) and answers through a queue of its own, so they take effect within
+// a millisecond or so even while paused. Pausing holds the sensor at a tick
+// boundary, and with it everything downstream.
+class TickPipeline
+{
+public:
+    struct SensorFrame
+    {
+        long tick;
+        bool afterGap;                     // An earlier frame was dropped
+        TrackStore tracks;                 // Including the journal since the previous frame
+        std::vector<ThreatReport> threats; // Scan order
+    };
+
+    struct CommandResult
+    {
+        int client; // OperatorCommand::client
+        std::string text;
+    };
+
+    struct WorldFrame
+    {
+        std::shared_ptr<const SensorFrame> sensor;
+        bool afterGap;
+        std::vector<ThreatReport> threats; // Priority order, as engaged
+        std::vector<Missile> inventory;
+        std::vector<Missile> inFlight;
+        // Controller settings as of this tick
+        bool autoIntercept;
+        double autoInterceptThreshold;
+        MissileController::AssignmentMode assignmentMode;
+    };
+
+    TickPipeline(Simulation &sim, std::chrono::milliseconds tickInterval);
+    ~TickPipeline();
+    TickPipeline(const TickPipeline &) = delete;
+    TickPipeline &operator=(const TickPipeline &) = delete;
+
+    // The simulation must not be touched by anyone else between start and stop.
+    // stop() joins the stages, applies kills still on their way to the sensor
+    // and logs what was published; frames still in between are lost, so the
+    // tick log continues with a keyframe.
+    void start();
+    void stop();
+
+    // Render/log stage: logs every frame published since the last call and
+    // returns the newest one (the previous one again if nothing new arrived,
+    // null before the first)
+    std::shared_ptr<const WorldFrame> poll();
+
+    // Render side. submit() queues a controller command (see
+    // Simulation::applyCommand) and fails when the queue is full; commands
+    // still queued at stop() are dropped unanswered. takeResults() returns the
+    // results that came back since the last call, in order. Pause and step
+    // take effect at the sensor's next tick boundary.
+    bool submit(const OperatorCommand &command);
+    std::vector<CommandResult> takeResults();
+    void setPaused(bool pause);
+    bool isPaused() const { return paused.load(std::memory_order_relaxed); }
+    void step(); // One more tick while paused
+
+    uint64_t getSensorTicks() const { return sensorTicks.load(std::memory_order_relaxed); }
+    uint64_t getEngagedTicks() const { return engagedTicks.load(std::memory_order_relaxed); }
+    uint64_t getDroppedFrames() const { return droppedFrames.load(std::memory_order_relaxed); }
+
+private:
+    Simulation &sim;
+    std::chrono::milliseconds tickInterval;
+
+    SpscQueue<std::shared_ptr<const SensorFrame>> sensorFrames; // sensor -> engagement
+    SpscQueue<std::shared_ptr<const WorldFrame>> worldFrames;   // engagement -> render/log
+    SpscQueue<int> kills;                                       // engagement -> sensor
+    SpscQueue<OperatorCommand> commands;                        // render -> engagement
+    SpscQueue<CommandResult> results;                           // engagement -> render
+
+    std::thread sensorThread;
+    std::thread engagementThread;
+    std::atomic<bool> running{false};
+    std::atomic<bool> paused{false};
+    std::mutex stopMutex;
+    std::condition_variable stopSignal; // Cuts the sensor's wait short: stop, resume or step
+    long pendingSteps = 0;              // Guarded by stopMutex
+
+    std::atomic<uint64_t> sensorTicks{0};
+    std::atomic<uint64_t> engagedTicks{0};
+    std::atomic<uint64_t> droppedFrames{0};
+
+    std::shared_ptr<const WorldFrame> latest;
+    // Engagement side
+    long lastEngagedTick = 0;
+    std::vector<int> unsentKills;             // Kills the queue had no room for yet
+    std::vector<CommandResult> unsentResults; // Results the queue had no room for yet
+
+    void runSensor();
+    void runEngagement();
+    void applyCommands(const std::vector<ThreatReport> &threats);
+};
+
+#endif // TICK_PIPELINE_H
@@ -0,0 +1,138 @@
+#ifndef TICK_PROFILER_H
+#define TICK_PROFILER_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+// Per-phase tick latency, recorded by scoped timers into log-linear
+// (HDR-style) histograms. Timers compile to nothing unless the build defines
+// NORAD_TICK_PROFILING (CMake option of the same name); the histograms stay
+// so callers never need their own #ifdefs, they just remain empty.
+
+// Values are kept with 2^SUB_BUCKET_BITS linear buckets per power of two,
+// so every recorded value is reproduced within ~3%, from 1 ns to ~1100 s.
+class LatencyHistogram
+{
+public:
+    static const int SUB_BUCKET_BITS = 5;
+    static const int MAX_EXPONENT = 40;
+
+    void record(uint64_t nanoseconds)
+    {
+        ++counts[bucketOf(nanoseconds)];
+        ++count;
+        sum += nanoseconds;
+        min = nanoseconds < min ? nanoseconds : min;
+        max = nanoseconds > max ? nanoseconds : max;
+    }
+
+    // Smallest recorded value with at least `quantile` of the samples at or
+    // below it (to bucket precision, never above max); 0 when empty
+    uint64_t percentile(double quantile) const;
+
+    uint64_t getCount() const { return count; }
+    uint64_t getMin() const { return count > 0 ? min : 0; }
+    uint64_t getMax() const { return max; }
+    double getMean() const { return count > 0 ? static_cast<double>(sum) / count : 0.0; }
+    void reset();
+
+private:
+    static const size_t SUB_BUCKETS = size_t(1) << SUB_BUCKET_BITS;
+    static const size_t BUCKET_COUNT = (MAX_EXPONENT - SUB_BUCKET_BITS + 2) * SUB_BUCKETS;
+
+    std::array<uint64_t, BUCKET_COUNT> counts{};
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    uint64_t min = UINT64_MAX;
+    uint64_t max = 0;
+
+    static size_t bucketOf(uint64_t value)
+    {
+        if (value < SUB_BUCKETS)
+        {
+            return static_cast<size_t>(value);
+        }
+        int exponent = 63 - __builtin_clzll(value);
+        if (exponent > MAX_EXPONENT)
+        {
+            return BUCKET_COUNT - 1;
+        }
+        // Top SUB_BUCKET_BITS+1 bits: the leading one picks the row, the rest the column
+        size_t sub = static_cast<size_t>(value >> (exponent - SUB_BUCKET_BITS)) - SUB_BUCKETS;
+        return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + sub;
+    }
+
+    static uint64_t bucketUpperBound(size_t bucket);
+};
+
+enum class TickPhase
+{
+    Move,          // TrackStore::moveAll
+    Flights,       // Interceptor steps and arrivals
+    Scan,          // DetectionSystem::scanForThreats
+    AutoIntercept, // MissileController::autoInterceptThreats
+    Render,        // displayLiveBattlefield + present
+    Record,        // TickRecorder::recordTick
+    Publish,       // WorldPublisher::publish
+    Tick,          // Whole Simulation::tick (senseTick in the pipelined live view)
+    Count
+};
+
+const char *tickPhaseName(TickPhase phase);
+
+class TickProfiler
+{
+public:
+#ifdef NORAD_TICK_PROFILING
+    static constexpr bool ENABLED = true;
+#else
+    static constexpr bool ENABLED = false;
+#endif
+
+    void record(TickPhase phase, uint64_t nanoseconds) { phases[static_cast<size_t>(phase)].record(nanoseconds); }
+    const LatencyHistogram &get(TickPhase phase) const { return phases[static_cast<size_t>(phase)]; }
+    void reset();
+
+    // Table of count/p50/p99/p999/max per phase, in microseconds
+    void print(std::ostream &out) const;
+    // {"enabled": ..., "phases": {"move": {"count": ..., "p50_ns": ..., ...}, ...}}
+    void writeJson(std::ostream &out) const;
+
+private:
+    std::array<LatencyHistogram, static_cast<size_t>(TickPhase::Count)> phases;
+};
+
+// Records the lifetime of the enclosing scope into one phase
+class ScopedPhaseTimer
+{
+public:
+    ScopedPhaseTimer(TickProfiler &profiler, TickPhase phase)
+        : profiler(profiler), phase(phase), start(std::chrono::steady_clock::now()) {}
+    ~ScopedPhaseTimer()
+    {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        profiler.record(phase, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+    ScopedPhaseTimer(const ScopedPhaseTimer &) = delete;
+    ScopedPhaseTimer &operator=(const ScopedPhaseTimer &) = delete;
+
+private:
+    TickProfiler &profiler;
+    TickPhase phase;
+    std::chrono::steady_clock::time_point start;
+};
+
+#define NORAD_PROFILE_CONCAT_(a, b) a##b
+#define NORAD_PROFILE_CONCAT(a, b) NORAD_PROFILE_CONCAT_(a, b)
+
+#ifdef NORAD_TICK_PROFILING
+#define NORAD_PROFILE_PHASE(profiler, phase) \
+    ScopedPhaseTimer NORAD_PROFILE_CONCAT(phaseTimer_, __LINE__)((profiler), (phase))
+#else
+#define NORAD_PROFILE_PHASE(profiler, phase) ((void)0)
+#endif
+
+#endif // TICK_PROFILER_H
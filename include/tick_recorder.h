@@ -0,0 +1,167 @@
+#ifndef TICK_RECORDER_H
+#define TICK_RECORDER_H
+
+// Streaming record/replay of simulation ticks.
+//
+// A log is a header (protected targets and the interceptor catalog) followed
+// by one frame per tick. Keyframes carry the whole world state. Delta frames
+// carry only what the previous frame can't predict: track adds/removes in the
+// order they happened, new interceptor launches and flight steps. Enemy
+// positions and threat reports are not stored per tick; the replayer advances
+// the tracks with the same TrackStore::moveAll and rescans them with the same
+// radar, so their delta against the previous tick is implied. A keyframe
+// every N ticks bounds how far a seek has to roll forward and resynchronizes
+// the positions exactly.
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "track_store.h"
+#include "missile_controller.h"
+#include "detection_system.h"
+#include "target.h"
+
+namespace tick_log
+{
+    const char MAGIC[8] = {'N', 'O', 'R', 'A', 'D', 'R', 'E', 'C'};
+    const uint32_t VERSION = 3;
+
+    enum FrameType : uint8_t
+    {
+        FRAME_KEY = 1,
+        FRAME_DELTA = 2
+    };
+}
+
+class TickRecorder
+{
+public:
+    // Opens the log and writes its header; throws std::runtime_error on I/O failure
+    TickRecorder(const std::string &path, const std::vector<Target> &targets,
+                 const MissileController &controller, int keyframeInterval = 100);
+
+    // Appends the world state at the end of `tick`, which must have moved the
+    // tracks exactly once. `enemies` must journal its changes
+    // (TrackStore::setJournaling); the journal is consumed here.
+    void recordTick(long tick, TrackStore &enemies, const MissileController &controller);
+    // The same from a snapshot of the world (the pipelined live view):
+    // `enemies` holds the journal since the previous frame and is left untouched
+    void recordTick(long tick, const TrackStore &enemies,
+                    const std::vector<Missile> &inventory, const std::vector<Missile> &inFlight);
+    // Makes the next frame a keyframe, for callers that skipped ticks
+    void requestKeyframe() { keyframeRequested = true; }
+
+    uint64_t getBytesWritten() const { return bytesWritten; }
+    long getFramesWritten() const { return framesWritten; }
+
+private:
+    std::ofstream out;
+    std::string path;
+    int keyframeInterval;
+    long framesWritten = 0;
+    bool keyframeRequested = false;
+    uint64_t bytesWritten = 0;
+
+    std::vector<uint8_t> payload; // Reused frame buffer
+    size_t used = 0;
+
+    size_t trackCount = 0;            // Store size at the last frame
+    std::vector<int> knownFlights;    // Sorted in-flight missile IDs of the last frame
+    std::vector<int> currentFlights;
+
+    uint8_t *reserve(size_t bytes);
+    void putVarint(uint64_t value);
+    void putSigned(int64_t value);
+    void putDouble(double value);
+
+    void putPosition(const Position &position);
+    void putTrack(const TrackStore &enemies, long index);
+
+    void encodeTracks(const TrackStore &enemies, bool keyframe);
+    void encodeFlights(const std::vector<Missile> &inventory, const std::vector<Missile> &inFlight, bool keyframe);
+    void writeFrame(tick_log::FrameType type, long tick);
+};
+
+// Reads a log back into a world view the live renderer or the headless
+// driver can consume: a track store, a controller holding the recorded
+// inventory and flights, and the threat list (in priority order).
+class TickReplayer
+{
+public:
+    explicit TickReplayer(const std::string &path); // Throws std::runtime_error
+    TickReplayer(const TickReplayer &) = delete;
+    TickReplayer &operator=(const TickReplayer &) = delete;
+
+    // Applies the next frame; false at the end of the log
+    bool next();
+    // Jumps to the last keyframe at or before `tick` and rolls forward to it
+    void seek(long tick);
+
+    long getTick() const { return currentTick; }
+    long getFirstTick() const;
+    long getLastTick() const { return lastTick; }
+    size_t getFrameCount() const { return frameCount; }
+    size_t getKeyframeCount() const { return keyframes.size(); }
+
+    TrackStore &getEnemies() { return enemies; }
+    MissileController &getController() { return controller; }
+    const std::vector<Target> &getTargets() const { return targets; }
+    DetectionSystem &getRadar() { return radar; }
+    const std::vector<ThreatReport> &getThreats(); // In priority order
+
+private:
+    struct CatalogEntry
+    {
+        int damage;
+        std::string name;
+        double speed;
+        Position position;
+    };
+
+    struct Launch
+    {
+        Position from;
+        Position to;
+        int enemyId;
+        int flightSteps;
+    };
+
+    struct KeyframeEntry
+    {
+        long tick;
+        std::streamoff offset;
+    };
+
+    std::ifstream in;
+    std::string path;
+    std::vector<uint8_t> payload;
+    std::unordered_map<int, CatalogEntry> catalog;
+    std::unordered_map<int, Launch> launches;
+    std::vector<KeyframeEntry> keyframes;
+    std::streamoff firstFrameOffset = 0;
+    size_t frameCount = 0;
+    long lastTick = -1;
+    long currentTick = -1;
+
+    // Declaration order matters: the radar keeps references to targets and enemies
+    std::vector<Target> targets;
+    TrackStore enemies;
+    MissileController controller;
+    DetectionSystem radar;
+
+    std::vector<ThreatReport> threats;
+    bool threatsSorted = true;
+    std::vector<Missile> flights;
+
+    std::vector<Target> readHeader(); // Fills the catalog, returns the targets
+    bool readFrame(uint8_t &type, long &tick);
+    void applyKeyframe(const uint8_t *data, const uint8_t *end);
+    void applyDelta(const uint8_t *data, const uint8_t *end);
+    void addFlight(int missileId, int step);
+    void rescan();
+};
+
+#endif // TICK_RECORDER_H
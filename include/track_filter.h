@@ -0,0 +1,69 @@
+#ifndef TRACK_FILTER_H
+#define TRACK_FILTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "position.h"
+
+// Constant-velocity Kalman filters for a whole radar picture, one per track
+// ID, stored as columns (structure of arrays) and run in one batch per scan
+// with an AVX2 kernel when available.
+// State per track is position and velocity (per tick) on each axis. The noise
+// is the same on every axis and every axis is measured at once, so the three
+// axes share one 2x2 covariance [p00 p01; p01 p11] per track.
+//   predict: x += v dt, P = F P F' + Q (white acceleration, sigma a per tick^2)
+//   update:  K = P H' / (p00 + r), state += K (z - x), P = (I - K H) P
+// A new track starts at its first measurement, at rest, with a velocity
+// variance wide enough for anything that flies.
+class TrackFilter
+{
+public:
+    enum class Kernel
+    {
+        Auto,   // AVX2 when the CPU supports it, scalar otherwise
+        Scalar,
+        Avx2
+    };
+
+    // Throws std::invalid_argument unless measurementNoise > 0 and
+    // accelerationNoise >= 0 (1 sigma per axis, in m and m per tick^2)
+    explicit TrackFilter(double measurementNoise, double accelerationNoise = 0.05, double maxSpeed = 300.0);
+
+    // One scan: measure() every track seen, then update(). Tracks that weren't
+    // measured are dropped by update(), which may move rows around.
+    void measure(int id, const Position &measured);
+    void update(double time);
+    void clear();
+
+    size_t size() const { return ids.size(); }
+    long rowOf(int id) const; // -1 when not filtered
+    Position positionAt(size_t row) const { return {xs[row], ys[row], zs[row]}; }
+    Position velocityAt(size_t row) const { return {vxs[row], vys[row], vzs[row]}; }
+    // Estimated standard deviation of one axis of the position
+    double positionErrorAt(size_t row) const;
+
+    double getMeasurementNoise() const;
+    void setKernel(Kernel kernel) { this->kernel = kernel; }
+    static bool avx2Available();
+
+private:
+    double measurementVariance;
+    double accelerationVariance;
+    double initialVelocityVariance;
+    Kernel kernel = Kernel::Auto;
+
+    std::vector<int> ids;
+    std::vector<int32_t> rowById; // Dense track ID -> row (-1 when absent)
+    std::vector<double> xs, ys, zs;
+    std::vector<double> vxs, vys, vzs;
+    std::vector<double> p00s, p01s, p11s;
+    std::vector<double> lastTimes;        // Of the last update, NaN until the first one
+    std::vector<double> zxs, zys, zzs;    // This scan's measurements
+    std::vector<uint8_t> measured;
+    size_t measuredCount = 0;
+
+    void dropUnmeasured();
+};
+
+#endif // TRACK_FILTER_H
@@ -0,0 +1,116 @@
+#ifndef TRACK_FUSION_H
+#define TRACK_FUSION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "position.h"
+#include "spatial_grid.h"
+
+// One detection from one radar scan
+struct Plot
+{
+    uint32_t radar;    // Index of the radar site
+    int enemyId;       // Truth tag of the object measured; bookkeeping only, never used to correlate
+    Position position; // Measured, with the radar's noise
+    Position velocity; // Per tick, from the radar's Doppler and scan-to-scan tracking
+};
+
+// A fused track: every radar's plots of one object under one stable ID
+struct SystemTrack
+{
+    int id;            // System track ID, never reused
+    int enemyId;       // Truth tag of the plot that fit it best on its last update
+    Position position; // Estimate at lastUpdate
+    Position velocity; // Per tick
+    long lastUpdate;
+    int updates;       // Ticks with at least one plot
+
+    Position positionAt(long tick) const
+    {
+        double dt = static_cast<double>(tick - lastUpdate);
+        return {position.x + velocity.x * dt, position.y + velocity.y * dt, position.z + velocity.z * dt};
+    }
+};
+
+// Gate sizes and track lifetime follow from what the radars can do
+struct FusionSettings
+{
+    double positionNoise = 2.0; // Largest radar position error, 1 sigma per axis
+    double velocityNoise = 1.0; // Largest radar velocity error, 1 sigma per axis and tick
+    long maxScanInterval = 1;   // Longest gap between two scans of one radar
+    long coastLimit = 0;        // Ticks without plots before a track is dropped, 0 = 2 scan intervals + 1
+};
+
+// Correlates plots from many radars into system tracks. Each call predicts
+// every track to the current tick and buckets the predictions in a uniform
+// grid two gates wide, so gating a plot only looks at the tracks in the 2x2
+// cells around it and a whole fusion step is linear in plots + tracks.
+//   1. A plot joins the nearest track within the gate that no other plot of
+//      the same radar has joined this tick. The gate widens with the time
+//      since the track was last updated.
+//   2. Plots left over are clustered (one per radar, within the gate) into
+//      new tracks.
+//   3. Joined tracks are smoothed towards the mean of their plots with an
+//      alpha-beta filter; tracks without plots for coastLimit ticks are dropped.
+// Plots must be grouped by radar; the result only depends on their order.
+class TrackFusion
+{
+public:
+    explicit TrackFusion(const FusionSettings &settings = FusionSettings());
+
+    void fuse(long tick, const std::vector<Plot> &plots);
+
+    // Creation order, which drops preserve
+    const std::vector<SystemTrack> &getTracks() const { return tracks; }
+    uint64_t getTracksCreated() const { return tracksCreated; }
+    uint64_t getTracksDropped() const { return tracksDropped; }
+    uint64_t getTagSwitches() const { return tagSwitches; } // Updates whose best plot came from another object
+    const FusionSettings &getSettings() const { return settings; }
+
+private:
+    // What gating a plot against a track reads, packed into one cache line
+    struct Candidate
+    {
+        Position position;  // Predicted to this tick
+        double gate;
+        uint32_t claimedBy; // Last radar whose plot joined, UINT32_MAX for none
+    };
+
+    // Plots joined to a track in the current fusion step
+    struct Claim
+    {
+        uint32_t plots;
+        Position positionSum;
+        Position velocitySum;
+        double bestDistance;
+        int bestEnemyId;
+    };
+
+    FusionSettings settings;
+    std::vector<SystemTrack> tracks;
+    int nextTrackId = 1;
+    uint64_t tracksCreated = 0;
+    uint64_t tracksDropped = 0;
+    uint64_t tagSwitches = 0;
+
+    // Reused by every step
+    std::vector<Position> predicted; // Track positions at this tick, what the grid is built from
+    std::vector<Candidate> candidates;
+    std::vector<Claim> claims;
+    std::vector<size_t> leftover;    // Plot indices no track took
+    std::vector<Position> leftoverPositions;
+    std::vector<uint8_t> consumed;
+    std::vector<uint32_t> clusterRadars;
+    SpatialGrid trackGrid;
+    SpatialGrid plotGrid;
+
+    // Distance within which a plot can belong to a track last updated `age` ticks ago
+    double gate(long age) const;
+    void dropStale(long tick);
+    void associate(long tick, const std::vector<Plot> &plots);
+    void update(long tick);
+    void startTracks(long tick, const std::vector<Plot> &plots);
+};
+
+#endif // TRACK_FUSION_H
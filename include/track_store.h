@@ -0,0 +1,232 @@
+#ifndef TRACK_STORE_H
+#define TRACK_STORE_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <algorithm>
+#include "position.h"
+#include "enemy_missile.h"
+
+// One column of the track store. Normally owns its storage, but it can also
+// adopt external memory (a private file mapping) and work on it in place
+// until it has to grow, at which point the contents are copied out.
+template <typename T>
+class TrackColumn
+{
+public:
+    TrackColumn() = default;
+    TrackColumn(const TrackColumn &other) : owned(other.data(), other.data() + other.size()) {}
+    TrackColumn(TrackColumn &&other) noexcept
+        : owned(std::move(other.owned)), external(other.external), externalSize(other.externalSize)
+    {
+        other.external = nullptr;
+        other.externalSize = 0;
+    }
+    TrackColumn &operator=(TrackColumn other) noexcept
+    {
+        owned.swap(other.owned);
+        std::swap(external, other.external);
+        std::swap(externalSize, other.externalSize);
+        return *this;
+    }
+
+    T *data() { return external ? external : owned.data(); }
+    const T *data() const { return external ? external : owned.data(); }
+    size_t size() const { return external ? externalSize : owned.size(); }
+    bool isAdopted() const { return external != nullptr; }
+
+    T &operator[](size_t index) { return data()[index]; }
+    const T &operator[](size_t index) const { return data()[index]; }
+
+    void push_back(const T &value)
+    {
+        materialize(size() + 1);
+        owned.push_back(value);
+    }
+
+    void pop_back()
+    {
+        if (external)
+        {
+            --externalSize;
+        }
+        else
+        {
+            owned.pop_back();
+        }
+    }
+
+    void resize(size_t count, const T &value)
+    {
+        materialize(count);
+        owned.resize(count, value);
+    }
+
+    void reserve(size_t count)
+    {
+        if (external)
+        {
+            if (count > externalSize)
+            {
+                materialize(count);
+            }
+            return;
+        }
+        owned.reserve(count);
+    }
+
+    void clear()
+    {
+        external = nullptr;
+        externalSize = 0;
+        owned.clear();
+    }
+
+    void adopt(T *memory, size_t count)
+    {
+        std::vector<T>().swap(owned);
+        external = memory;
+        externalSize = count;
+    }
+
+private:
+    std::vector<T> owned;
+    T *external = nullptr;
+    size_t externalSize = 0;
+
+    void materialize(size_t capacity)
+    {
+        if (!external)
+        {
+            return;
+        }
+        owned.reserve(std::max(capacity, externalSize));
+        owned.assign(external, external + externalSize);
+        external = nullptr;
+        externalSize = 0;
+    }
+};
+
+// Structure-of-arrays storage for enemy tracks.
+// Every field lives in its own contiguous column so the bulk move and the
+// radar scan only stream the data they actually touch.
+class TrackStore
+{
+public:
+    enum class MoveKernel
+    {
+        Auto,   // AVX2 when the CPU supports it, scalar otherwise
+        Scalar,
+        Avx2
+    };
+
+    // A track table living in someone else's memory, typically a private
+    // mapping of a binary scenario file (see scenario_file.h). Every column
+    // holds `count` entries; `indexById` holds `indexSize` entries mapping a
+    // track ID to its row (-1 when absent). `owner` keeps the memory alive.
+    struct ExternalColumns
+    {
+        size_t count = 0;
+        int *ids = nullptr;
+        double *xs = nullptr;
+        double *ys = nullptr;
+        double *zs = nullptr;
+        double *targetXs = nullptr;
+        double *targetYs = nullptr;
+        double *targetZs = nullptr;
+        double *speeds = nullptr;
+        int *targetIds = nullptr;
+        int32_t *indexById = nullptr;
+        size_t indexSize = 0;
+        std::shared_ptr<void> owner;
+    };
+
+    // Replaces the contents with the external columns, used in place (no copy)
+    void adopt(const ExternalColumns &columns);
+
+    // Structural change log: while enabled every add/remove is appended in
+    // order, so a reader replaying it reproduces the exact row order
+    struct Change
+    {
+        int id;
+        bool removed;
+    };
+    void setJournaling(bool enabled);
+    const std::vector<Change> &getJournal() const { return journal; }
+    void clearJournal() { journal.clear(); }
+
+    size_t add(const EnemyMissile &enemy);
+    bool removeById(int id);
+    void clear();
+    void reserve(size_t count);
+
+    // Advance every track one step towards its target; a track within one
+    // step lands exactly on it (and stays there)
+    void moveAll();
+    // `ticks` steps at once along the same straight line, for cores that skip ticks
+    void advanceAll(long ticks);
+    void setMoveKernel(MoveKernel kernel);
+    static bool avx2Available();
+
+    size_t size() const { return ids.size(); }
+    bool empty() const { return ids.size() == 0; }
+    bool contains(int id) const;
+    long indexOf(int id) const; // Dense position of a track ID, -1 when absent
+
+    // Per-track accessors (index is the dense position, not the track ID)
+    int idAt(size_t index) const { return ids[index]; }
+    Position positionAt(size_t index) const { return {xs[index], ys[index], zs[index]}; }
+    Position targetAt(size_t index) const { return {targetXs[index], targetYs[index], targetZs[index]}; }
+    double speedAt(size_t index) const { return speeds[index]; }
+    int targetIdAt(size_t index) const { return targetIds[index]; }
+    EnemyMissile toEnemyMissile(size_t index) const;
+    // Where the track will be `ticks` steps from now (same path as advanceAll)
+    Position positionAfter(size_t index, long ticks) const;
+    // Moves `position`, a point on the track's path, `steps` times with
+    // moveAll's own arithmetic: from positionAt(index) it lands exactly where
+    // that many moveAll calls would, where positionAfter agrees only to rounding
+    Position stepAlong(size_t index, Position position, long steps) const;
+    // Steps of moveAll until the track is within `radius` of its target
+    // (closer than it, or no further with `inclusive`), 0 if it already is and
+    // -1 if it doesn't get there within `maxSteps`. Matches moveAll step for
+    // step: the closed form only decides when it is clear of a step boundary,
+    // otherwise the steps are replayed with moveAll's own arithmetic.
+    long stepsUntilWithin(size_t index, double radius, bool inclusive, long maxSteps) const;
+
+    // Raw columns for the hot loops
+    const int *idData() const { return ids.data(); }
+    const double *xData() const { return xs.data(); }
+    const double *yData() const { return ys.data(); }
+    const double *zData() const { return zs.data(); }
+    const double *targetXData() const { return targetXs.data(); }
+    const double *targetYData() const { return targetYs.data(); }
+    const double *targetZData() const { return targetZs.data(); }
+    const double *speedData() const { return speeds.data(); }
+    const int *targetIdData() const { return targetIds.data(); }
+
+private:
+    TrackColumn<int> ids;
+    TrackColumn<double> xs;
+    TrackColumn<double> ys;
+    TrackColumn<double> zs;
+    TrackColumn<double> targetXs;
+    TrackColumn<double> targetYs;
+    TrackColumn<double> targetZs;
+    TrackColumn<double> speeds;
+    TrackColumn<int> targetIds;
+
+    // Dense track ID -> column index lookup (-1 when absent)
+    TrackColumn<int32_t> indexById;
+
+    // Keeps adopted column memory alive
+    std::shared_ptr<void> externalOwner;
+
+    bool journaling = false;
+    std::vector<Change> journal;
+
+    MoveKernel moveKernel = MoveKernel::Auto;
+};
+
+#endif // TRACK_STORE_H
@@ -0,0 +1,53 @@
+#ifndef WEAPON_TARGET_ASSIGNMENT_H
+#define WEAPON_TARGET_ASSIGNMENT_H
+
+#include <chrono>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+// Batch weapon-target assignment: matches rows (threats) to columns
+// (interceptors) minimizing the summed cost (time to intercept) with a
+// forward auction and epsilon scaling. All buffers come from `resource`
+// (the heap by default) and are reused between solves.
+class WeaponTargetAssigner
+{
+public:
+    explicit WeaponTargetAssigner(std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+    struct Assignment
+    {
+        size_t row;
+        size_t col;
+        double cost;
+    };
+
+    // `costs` is row-major rows x cols and requires rows <= cols. Every row is
+    // assigned a distinct column. If the time budget runs out the auction stops
+    // and the remaining rows are matched greedily; microseconds::max() never
+    // runs out, which keeps the result independent of machine load.
+    void solve(const double *costs, size_t rows, size_t cols,
+               std::chrono::microseconds budget);
+
+    // Baseline: rows in order, each takes the cheapest column still free
+    void solveGreedy(const double *costs, size_t rows, size_t cols);
+
+    const std::pmr::vector<Assignment> &getAssignments() const { return assignments; }
+    double getTotalCost() const;
+    bool timedOut() const { return budgetExceeded; }
+    size_t getBidCount() const { return bids; }
+
+private:
+    std::pmr::vector<double> prices;
+    std::pmr::vector<long> ownerOfCol;  // Row holding each column, -1 if free
+    std::pmr::vector<long> colOfRow;    // Column held by each row, -1 if unassigned
+    std::pmr::vector<size_t> unassigned;
+    std::pmr::vector<Assignment> assignments;
+    bool budgetExceeded = false;
+    size_t bids = 0;
+
+    void greedyFill(const double *costs, size_t rows, size_t cols);
+    void collect(const double *costs, size_t rows, size_t cols);
+};
+
+#endif // WEAPON_TARGET_ASSIGNMENT_H
@@ -0,0 +1,47 @@
+#ifndef WORLD_PUBLISHER_H
+#define WORLD_PUBLISHER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "geodetic.h"
+#include "world_snapshot.h"
+#include "track_store.h"
+#include "detection_system.h"
+#include "missile.h"
+#include "target.h"
+
+// Writer side of the shared-memory world snapshot (world_snapshot.h): copies
+// every tick's tracks, threat reports and interceptors into the frame readers
+// aren't on and publishes it. Never waits for readers; a tick costs one pass
+// over each list.
+class WorldPublisher
+{
+public:
+    // Creates the POSIX shared-memory object `name` (replacing a stale one),
+    // with room for `trackCapacity` tracks and threats and
+    // `interceptorCapacity` interceptors per frame; anything beyond is left
+    // out and the frame marked truncated. Throws std::runtime_error if the
+    // region can't be created.
+    WorldPublisher(const std::string &name, const GeodeticPosition &origin, const std::vector<Target> &targets,
+                   size_t trackCapacity, size_t interceptorCapacity);
+    ~WorldPublisher(); // Unlinks the name; readers still mapped keep their view
+    WorldPublisher(const WorldPublisher &) = delete;
+    WorldPublisher &operator=(const WorldPublisher &) = delete;
+
+    void publish(long tick, const TrackStore &tracks, const std::vector<ThreatReport> &threats,
+                 const std::vector<Missile> &inventory, const std::vector<Missile> &inFlight);
+
+    const std::string &getName() const { return name; }
+    uint64_t getFramesPublished() const;
+
+private:
+    std::string name;
+    unsigned char *base = nullptr;
+    size_t size = 0;
+
+    world_snapshot::Header &header() { return *reinterpret_cast<world_snapshot::Header *>(base); }
+};
+
+#endif // WORLD_PUBLISHER_H
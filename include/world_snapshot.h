@@ -0,0 +1,181 @@
+#ifndef WORLD_SNAPSHOT_H
+#define WORLD_SNAPSHOT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "position.h"
+
+// Layout of the POSIX shared-memory region a running simulation publishes its
+// world into every tick (see world_publisher.h), and the reader external
+// displays and analysis tools map it with. The reader needs nothing else from
+// the simulator: link norad_snapshot, not norad_core.
+//
+//   Header | target records | frame 0 | frame 1
+//   frame: FrameHeader | track records | threat records | interceptor records
+//
+// The writer alternates between the two frames, so it always fills the one
+// readers are not looking at. Each frame has its own sequence counter, odd
+// while it is being written (a seqlock): a reader reads the newest frame in
+// place and checks the counter didn't move, which only happens if the writer
+// got two ticks ahead of it. Neither side ever waits for the other.
+// Positions are east-north-up metres around the scenario origin (geodetic.h).
+namespace world_snapshot
+{
+    const char MAGIC[8] = {'N', 'O', 'R', 'A', 'D', 'S', 'H', 'M'};
+    const uint32_t VERSION = 1;
+    const char *const DEFAULT_NAME = "/norad-world";
+
+    struct Header
+    {
+        char magic[8]; // Written last: a region without it is still being set up
+        uint32_t version;
+        uint32_t headerBytes;
+        int64_t writerPid;
+        uint64_t trackCapacity; // Records each frame has room for
+        uint64_t threatCapacity;
+        uint64_t interceptorCapacity;
+        uint64_t targetCount;
+        uint64_t targetsOffset; // From the start of the region
+        uint64_t frameOffsets[2];
+        uint64_t frameBytes;
+        double originLatitude;
+        double originLongitude;
+        double originAltitude;
+        std::atomic<uint64_t> published; // Frames published; the newest is frame (published - 1) % 2
+    };
+
+    struct TargetRecord
+    {
+        int32_t id;
+        char name[36];
+        double latitude;
+        double longitude;
+        double altitude;
+        Position position;
+    };
+
+    struct FrameHeader
+    {
+        std::atomic<uint64_t> sequence; // Odd while the writer is filling the frame
+        int64_t tick;
+        uint64_t trackCount;
+        uint64_t threatCount;
+        uint64_t interceptorCount;
+        uint32_t truncated; // More than a capacity's worth were left out
+        uint32_t reserved;
+    };
+
+    struct TrackRecord
+    {
+        int32_t id;
+        int32_t targetId;
+        Position position;
+        Position target;
+        double speed; // Metres per tick
+    };
+
+    struct ThreatRecord
+    {
+        int32_t detectionId;
+        int32_t enemyId;
+        int32_t targetId;
+        int32_t reserved;
+        double distanceToTarget;
+        double speed;
+        double timeToImpact; // Ticks, +infinity when not closing
+        Position position;
+        Position velocity;
+    };
+
+    enum InterceptorState : uint32_t
+    {
+        INTERCEPTOR_READY = 0,
+        INTERCEPTOR_IN_FLIGHT = 1
+    };
+
+    struct InterceptorRecord
+    {
+        int32_t id;
+        int32_t targetEnemyId; // -1 unless in flight at a track
+        uint32_t state;        // InterceptorState
+        int32_t damage;
+        char name[24];
+        double speed;
+        double flightProgress; // 0 on the pad, 1 on arrival
+        Position position;
+        Position flightTarget;
+    };
+
+    // Bytes of one frame with the given capacities, records 8-byte aligned
+    size_t frameBytes(uint64_t trackCapacity, uint64_t threatCapacity, uint64_t interceptorCapacity);
+}
+
+// One consistent frame, read in place. The pointers are only valid inside the
+// WorldSnapshotReader::read callback.
+struct WorldSnapshotView
+{
+    long tick;
+    bool truncated;
+    const world_snapshot::TrackRecord *tracks;
+    size_t trackCount;
+    const world_snapshot::ThreatRecord *threats; // Priority order when engaged, else scan order
+    size_t threatCount;
+    const world_snapshot::InterceptorRecord *interceptors; // Ready ones first, then those in flight
+    size_t interceptorCount;
+};
+
+// Maps a published region read-only. Any number of readers, in any number of
+// processes, can read at once without slowing the writer down.
+class WorldSnapshotReader
+{
+public:
+    // Throws std::runtime_error if there is no such region or it isn't a
+    // snapshot of this version (yet)
+    explicit WorldSnapshotReader(const std::string &name = world_snapshot::DEFAULT_NAME);
+    ~WorldSnapshotReader();
+    WorldSnapshotReader(const WorldSnapshotReader &) = delete;
+    WorldSnapshotReader &operator=(const WorldSnapshotReader &) = delete;
+
+    const world_snapshot::Header &header() const { return *reinterpret_cast<const world_snapshot::Header *>(base); }
+    const world_snapshot::TargetRecord *targets() const;
+    size_t targetCount() const { return header().targetCount; }
+    uint64_t framesPublished() const { return header().published.load(std::memory_order_acquire); }
+    bool writerAlive() const;
+    // Reads that had to start over because the writer overtook them
+    uint64_t getRetries() const { return retries; }
+
+    // Calls visit(view) on the newest frame until it gets through a frame the
+    // writer left alone, so anything visit derives is consistent only once
+    // read returns; visit may run more than once and must not keep pointers.
+    // Returns false without calling visit while nothing has been published.
+    template <typename Visit>
+    bool read(Visit visit)
+    {
+        WorldSnapshotView view;
+        uint64_t sequence;
+        while (begin(view, sequence))
+        {
+            visit(static_cast<const WorldSnapshotView &>(view));
+            if (validate(sequence))
+            {
+                return true;
+            }
+            ++retries;
+        }
+        return false;
+    }
+
+private:
+    std::string name;
+    unsigned char *base = nullptr;
+    size_t size = 0;
+    uint64_t retries = 0;
+    const world_snapshot::FrameHeader *frame = nullptr; // Of the read in progress
+
+    bool begin(WorldSnapshotView &view, uint64_t &sequence);
+    bool validate(uint64_t sequence) const;
+};
+
+#endif // WORLD_SNAPSHOT_H
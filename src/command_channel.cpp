@@ -0,0 +1,406 @@
+#include "command_channel.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+    const size_t READ_CHUNK = 512;
+
+    std::runtime_error channelError(const std::string &path, const std::string &message)
+    {
+        return std::runtime_error("control socket " + path + ": " + message);
+    }
+
+    int parseCount(const std::string &token, const char *what)
+    {
+        size_t used = 0;
+        int value = -1;
+        try
+        {
+            value = std::stoi(token, &used);
+        }
+        catch (const std::exception &)
+        {
+            used = 0;
+        }
+        if (used == 0 || used != token.size() || value < 0)
+        {
+            throw std::invalid_argument(std::string(what) + " must be a non-negative number, not '" + token + "'");
+        }
+        return value;
+    }
+
+    OperatorCommand::Switch parseSwitch(const std::string &token, const char *on, const char *off)
+    {
+        if (token == on)
+        {
+            return OperatorCommand::Switch::On;
+        }
+        if (token == off)
+        {
+            return OperatorCommand::Switch::Off;
+        }
+        if (token == "toggle")
+        {
+            return OperatorCommand::Switch::Toggle;
+        }
+        throw std::invalid_argument(std::string("expected ") + on + ", " + off + " or toggle, not '" + token + "'");
+    }
+
+    bool readable(int fd)
+    {
+        pollfd entry = {fd, POLLIN, 0};
+        return ::poll(&entry, 1, 0) > 0;
+    }
+}
+
+OperatorCommand parseOperatorCommand(const std::string &line)
+{
+    std::istringstream in(line);
+    std::vector<std::string> words;
+    std::string word;
+    while (in >> word)
+    {
+        std::transform(word.begin(), word.end(), word.begin(), [](unsigned char c)
+                       { return static_cast<char>(std::tolower(c)); });
+        words.push_back(word);
+    }
+    if (words.empty())
+    {
+        throw std::invalid_argument("empty command");
+    }
+
+    struct Verb
+    {
+        const char *name;
+        OperatorCommand::Type type;
+        size_t arguments;
+    };
+    static const Verb verbs[] = {
+        {"launch", OperatorCommand::Type::Launch, 2},
+        {"intercept", OperatorCommand::Type::Intercept, 1},
+        {"auto", OperatorCommand::Type::AutoIntercept, 1},
+        {"threshold", OperatorCommand::Type::Threshold, 1},
+        {"max-auto", OperatorCommand::Type::MaxAuto, 1},
+        {"assign", OperatorCommand::Type::Assignment, 1},
+        {"pause", OperatorCommand::Type::Pause, 0},
+        {"resume", OperatorCommand::Type::Resume, 0},
+        {"step", OperatorCommand::Type::Step, 0},
+        {"status", OperatorCommand::Type::Status, 0},
+        {"help", OperatorCommand::Type::Help, 0},
+        {"quit", OperatorCommand::Type::Quit, 0}};
+
+    const Verb *verb = std::find_if(std::begin(verbs), std::end(verbs), [&](const Verb &candidate)
+                                    { return words[0] == candidate.name; });
+    if (verb == std::end(verbs))
+    {
+        throw std::invalid_argument("unknown command '" + words[0] + "', try help");
+    }
+    if (words.size() != verb->arguments + 1)
+    {
+        throw std::invalid_argument(words[0] + " takes " + std::to_string(verb->arguments) + " argument(s), try help");
+    }
+
+    OperatorCommand command;
+    command.type = verb->type;
+    switch (command.type)
+    {
+    case OperatorCommand::Type::Launch:
+        if (std::optional<InterceptorClass> kind = interceptorClassNamed(words[1]))
+        {
+            command.missileClass = *kind;
+        }
+        else if (words[1].find_first_not_of("0123456789") != std::string::npos)
+        {
+            throw std::invalid_argument("no missile '" + words[1] + "': give an ID or patriot, tomahawk, stinger or javelin");
+        }
+        else
+        {
+            command.id = parseCount(words[1], "missile ID");
+        }
+        command.target = parseCount(words[2], "target number");
+        break;
+    case OperatorCommand::Type::Intercept:
+        command.id = parseCount(words[1], "threat number");
+        break;
+    case OperatorCommand::Type::MaxAuto:
+        command.id = parseCount(words[1], "launch budget");
+        break;
+    case OperatorCommand::Type::AutoIntercept:
+        command.setting = parseSwitch(words[1], "on", "off");
+        break;
+    case OperatorCommand::Type::Assignment:
+        command.setting = parseSwitch(words[1], "global", "greedy");
+        break;
+    case OperatorCommand::Type::Threshold:
+    {
+        size_t used = 0;
+        try
+        {
+            command.value = std::stod(words[1], &used);
+        }
+        catch (const std::exception &)
+        {
+            used = 0;
+        }
+        if (used == 0 || used != words[1].size() || !(command.value > 0.0))
+        {
+            throw std::invalid_argument("threshold must be a positive distance in metres, not '" + words[1] + "'");
+        }
+        break;
+    }
+    default:
+        break;
+    }
+    return command;
+}
+
+const char *operatorCommandHelp()
+{
+    return "commands: launch M T, intercept N, auto on|off|toggle, threshold D, max-auto N, "
+           "assign greedy|global|toggle, pause, resume, step, status, quit";
+}
+
+CommandChannel::~CommandChannel()
+{
+    releaseConsole();
+    for (const auto &entry : clients)
+    {
+        ::close(entry.second.fd);
+    }
+    if (listener >= 0)
+    {
+        ::close(listener);
+        ::unlink(path.c_str());
+    }
+}
+
+void CommandChannel::listen(const std::string &socketPath)
+{
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (socketPath.empty() || socketPath.size() >= sizeof(address.sun_path))
+    {
+        throw channelError(socketPath, "path must be 1 to " + std::to_string(sizeof(address.sun_path) - 1) + " bytes");
+    }
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+    // Only ever replace a socket left behind by an earlier run, never a file
+    struct stat existing;
+    if (::lstat(socketPath.c_str(), &existing) == 0)
+    {
+        if (!S_ISSOCK(existing.st_mode))
+        {
+            throw channelError(socketPath, "exists and is not a socket");
+        }
+        ::unlink(socketPath.c_str());
+    }
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        throw channelError(socketPath, std::string("cannot create: ") + std::strerror(errno));
+    }
+    if (::bind(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0 || ::listen(fd, 16) != 0)
+    {
+        int error = errno;
+        ::close(fd);
+        throw channelError(socketPath, std::string("cannot listen: ") + std::strerror(error));
+    }
+    if (listener >= 0)
+    {
+        ::close(listener);
+        ::unlink(path.c_str());
+    }
+    listener = fd;
+    path = socketPath;
+}
+
+void CommandChannel::attachConsole()
+{
+    if (consoleAttached)
+    {
+        return;
+    }
+    consoleIsTerminal = ::isatty(STDIN_FILENO) && ::tcgetattr(STDIN_FILENO, &savedTerminal) == 0;
+    if (consoleIsTerminal)
+    {
+        termios raw = savedTerminal;
+        raw.c_lflag &= ~static_cast<tcflag_t>(ICANON | ECHO);
+        raw.c_cc[VMIN] = 0;
+        raw.c_cc[VTIME] = 0;
+        ::tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+    }
+    consoleAttached = true;
+    consoleLine.clear();
+}
+
+void CommandChannel::releaseConsole()
+{
+    if (!consoleAttached)
+    {
+        return;
+    }
+    if (consoleIsTerminal)
+    {
+        ::tcsetattr(STDIN_FILENO, TCSANOW, &savedTerminal);
+    }
+    consoleAttached = false;
+    consoleLine.clear();
+}
+
+void CommandChannel::poll(std::vector<OperatorCommand> &commands)
+{
+    if (consoleAttached)
+    {
+        readConsole(commands);
+    }
+    if (listener >= 0)
+    {
+        acceptClients();
+    }
+    for (auto it = clients.begin(); it != clients.end();)
+    {
+        if (readClient(it->second, it->first, commands))
+        {
+            ++it;
+        }
+        else
+        {
+            ::close(it->second.fd);
+            it = clients.erase(it);
+        }
+    }
+}
+
+void CommandChannel::reply(int client, const std::string &text)
+{
+    if (client == CONSOLE)
+    {
+        consoleReply = text;
+        return;
+    }
+    auto it = clients.find(client);
+    if (it != clients.end())
+    {
+        std::string line = text + "\n";
+        ::send(it->second.fd, line.data(), line.size(), MSG_DONTWAIT | MSG_NOSIGNAL);
+    }
+}
+
+void CommandChannel::acceptClients()
+{
+    while (true)
+    {
+        int fd = ::accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0)
+        {
+            return; // EAGAIN once the backlog is empty; anything else is the client's problem
+        }
+        clients[nextClient++] = {fd, std::string()};
+    }
+}
+
+bool CommandChannel::readClient(Client &client, int id, std::vector<OperatorCommand> &commands)
+{
+    char buffer[READ_CHUNK];
+    while (true)
+    {
+        ssize_t got = ::recv(client.fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+        if (got == 0)
+        {
+            return false;
+        }
+        if (got < 0)
+        {
+            return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+        }
+        client.pending.append(buffer, static_cast<size_t>(got));
+
+        size_t start = 0;
+        size_t end;
+        while ((end = client.pending.find('\n', start)) != std::string::npos)
+        {
+            submitLine(client.pending.substr(start, end - start), id, commands);
+            start = end + 1;
+        }
+        client.pending.erase(0, start);
+        if (client.pending.size() > MAX_LINE)
+        {
+            reply(id, "error: line longer than " + std::to_string(MAX_LINE) + " bytes");
+            client.pending.clear();
+        }
+    }
+}
+
+void CommandChannel::readConsole(std::vector<OperatorCommand> &commands)
+{
+    char buffer[READ_CHUNK];
+    while (readable(STDIN_FILENO))
+    {
+        ssize_t got = ::read(STDIN_FILENO, buffer, sizeof(buffer));
+        if (got <= 0)
+        {
+            // End of a piped stdin: nothing more will come
+            if (got == 0 && !consoleIsTerminal)
+            {
+                consoleAttached = false;
+            }
+            return;
+        }
+        for (ssize_t i = 0; i < got; ++i)
+        {
+            char c = buffer[i];
+            if (c == '\n' || c == '\r')
+            {
+                std::string line;
+                line.swap(consoleLine);
+                submitLine(line, CONSOLE, commands);
+            }
+            else if (c == 0x7f || c == '\b')
+            {
+                if (!consoleLine.empty())
+                {
+                    consoleLine.pop_back();
+                }
+            }
+            else if (c == 0x1b)
+            {
+                consoleLine.clear(); // Escape abandons the line
+            }
+            else if (std::isprint(static_cast<unsigned char>(c)) && consoleLine.size() < MAX_LINE)
+            {
+                consoleLine.push_back(c);
+            }
+        }
+    }
+}
+
+void CommandChannel::submitLine(const std::string &line, int client, std::vector<OperatorCommand> &commands)
+{
+    if (line.find_first_not_of(" \t\r") == std::string::npos)
+    {
+        return;
+    }
+    try
+    {
+        OperatorCommand command = parseOperatorCommand(line);
+        command.client = client;
+        commands.push_back(command);
+    }
+    catch (const std::invalid_argument &error)
+    {
+        reply(client, std::string("error: ") + error.what());
+    }
+}
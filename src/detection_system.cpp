@@ -1,59 +1,390 @@
 #include "detection_system.h"
 #include <cmath>
 #include "target.h"
-#include "enemy_missile.h"
+#include "track_store.h"
+#include "thread_pool.h"
+#include "track_fusion.h"
+#include "track_filter.h"
+#include "measurement_noise.h"
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <stdexcept>
 
-DetectionSystem::DetectionSystem(const std::vector<EnemyMissile> &enemyMissiles, const std::vector<Target> &targets)
-    : enemyMissiles(enemyMissiles), targets(targets), detectionIdCounter(0) {}
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define DETECTION_SYSTEM_HAS_AVX2 1
+#include <immintrin.h>
+#endif
 
-std::vector<ThreatReport> DetectionSystem::scanForThreats()
+namespace
 {
-    std::vector<ThreatReport> currentThreats;
+    // Noise stream of the radar, apart from the sensor network's site indices
+    const uint64_t RADAR_NOISE_SOURCE = 1u << 20;
 
-    // Loop through all our detected enemy missiles
-    for (const auto &enemy : enemyMissiles)
+    // Ticks until a track `offset` from its target, `distance` away, gets
+    // there at the speed it is closing with
+    double timeToImpact(const Position &offset, double distance, const Position &velocity)
     {
+        if (distance <= 0.0)
+        {
+            return 0.0;
+        }
+        double closing = -(offset.x * velocity.x + offset.y * velocity.y + offset.z * velocity.z) / distance;
+        return closing > 0.0 ? distance / closing : std::numeric_limits<double>::infinity();
+    }
+}
 
-        // Get the enemy missile's intended target position
-        Position enemyTargetPos = enemy.getTargetPosition();
-        //   std::cout << "Enemy target pos: {" << enemyTargetPos.x
-        //              << ", " << enemyTargetPos.y
-        //              << ", " << enemyTargetPos.z << "}" << std::endl;
-        // Find the actual Target object that matches this position
-        // This is a simplified way to find the target's name
-        std::string targetName = "Unknown";
-        for (const auto &target : targets)
-        {
-            if (target.position.x == enemyTargetPos.x &&
-                target.position.y == enemyTargetPos.y &&
-                target.position.z == enemyTargetPos.z)
-            {
-                targetName = target.name;
-                break;
-            }
+DetectionSystem::DetectionSystem(const TrackStore &enemyMissiles, const std::vector<Target> &targets)
+    : enemyMissiles(enemyMissiles), targets(targets)
+{
+    unidentifiedNameId = names.intern("Unidentified Threat");
+
+    // Build the target ID index once so each scan never has to search the target list
+    for (size_t i = 0; i < targets.size(); ++i)
+    {
+        int id = targets[i].id;
+        if (id < 0)
+        {
+            continue;
         }
+        if (static_cast<size_t>(id) >= targetIndexById.size())
+        {
+            targetIndexById.resize(static_cast<size_t>(id) + 1, -1);
+        }
+        targetIndexById[id] = static_cast<int>(i);
+    }
+}
+
+const Target *DetectionSystem::getTarget(int targetId) const
+{
+    if (targetId < 0 || static_cast<size_t>(targetId) >= targetIndexById.size())
+    {
+        return nullptr;
+    }
+    int index = targetIndexById[targetId];
+    return index >= 0 ? &targets[index] : nullptr;
+}
+
+const std::string &DetectionSystem::getName(int nameId) const
+{
+    return names.getName(nameId);
+}
+
+const std::string &DetectionSystem::getTargetName(int targetId) const
+{
+    static const std::string unknown = "Unknown";
+    const Target *target = getTarget(targetId);
+    return target ? target->name : unknown;
+}
+
+DetectionSystem::~DetectionSystem() = default;
+
+void DetectionSystem::setWorkerCount(size_t workers)
+{
+    if (workers <= 1)
+    {
+        pool.reset();
+        chunkReports.clear();
+        chunkOffsets.clear();
+        return;
+    }
+    if (!pool || pool->size() != workers)
+    {
+        pool = std::make_unique<ThreadPool>(workers);
+        chunkReports.resize(workers);
+        chunkOffsets.resize(workers + 1);
+    }
+}
+
+void DetectionSystem::setMeasurementNoise(double sigma)
+{
+    if (sigma < 0.0)
+    {
+        throw std::invalid_argument("Radar measurement noise can't be negative");
+    }
+    filter = sigma > 0.0 ? std::make_unique<TrackFilter>(sigma) : nullptr;
+    scans = 0;
+}
+
+double DetectionSystem::getMeasurementNoise() const
+{
+    return filter ? filter->getMeasurementNoise() : 0.0;
+}
+
+size_t DetectionSystem::getWorkerCount() const
+{
+    return pool ? pool->size() : 1;
+}
+
+const std::vector<ThreatReport> &DetectionSystem::getLastThreats() const
+{
+    return reports;
+}
+
+std::vector<ThreatReport> &DetectionSystem::scanForThreats()
+{
+    reports.clear();
+    if (filter)
+    {
+        ++scans;
+        measureAll();
+    }
+
+    // Small scans aren't worth waking the pool for
+    const size_t MIN_TRACKS_PER_CHUNK = 4096;
+    size_t trackCount = enemyMissiles.size();
+    size_t chunkCount = pool ? std::min(pool->size(), trackCount / MIN_TRACKS_PER_CHUNK) : 0;
+
+    // Size the buffer for the worst case (every track a threat) once, instead
+    // of growing it tick by tick as tracks come into range
+    if (reports.capacity() < trackCount)
+    {
+        reports.reserve(trackCount);
+    }
+
+    if (chunkCount <= 1)
+    {
+        scanRange(0, trackCount, reports);
+        return reports;
+    }
+
+    // Each chunk fills its own buffer, no shared state while scanning
+    size_t chunkSize = (trackCount + chunkCount - 1) / chunkCount;
+    pool->parallelFor(chunkCount, [&](size_t chunk)
+                      {
+                          std::vector<ThreatReport> &out = chunkReports[chunk];
+                          out.clear();
+                          if (out.capacity() < chunkSize)
+                          {
+                              out.reserve(chunkSize);
+                          }
+                          size_t begin = chunk * chunkSize;
+                          scanRange(begin, std::min(begin + chunkSize, trackCount), out); });
+
+    // Prefix sums give every chunk its slice of the result, then chunks copy in parallel
+    chunkOffsets[0] = 0;
+    for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+    {
+        chunkOffsets[chunk + 1] = chunkOffsets[chunk] + chunkReports[chunk].size();
+    }
+    reports.resize(chunkOffsets[chunkCount]);
+    pool->parallelFor(chunkCount, [&](size_t chunk)
+                      { std::copy(chunkReports[chunk].begin(), chunkReports[chunk].end(),
+                                  reports.begin() + chunkOffsets[chunk]); });
+
+    return reports;
+}
+
+void DetectionSystem::measureAll()
+{
+    // Uniform noise with the configured standard deviation
+    const double spread = filter->getMeasurementNoise() * std::sqrt(3.0);
+    const int *ids = enemyMissiles.idData();
+    const double *xs = enemyMissiles.xData();
+    const double *ys = enemyMissiles.yData();
+    const double *zs = enemyMissiles.zData();
+    for (size_t i = 0; i < enemyMissiles.size(); ++i)
+    {
+        filter->measure(ids[i], {xs[i] + spread * uniformNoise(RADAR_NOISE_SOURCE, ids[i], scans, 0),
+                                 ys[i] + spread * uniformNoise(RADAR_NOISE_SOURCE, ids[i], scans, 1),
+                                 zs[i] + spread * uniformNoise(RADAR_NOISE_SOURCE, ids[i], scans, 2)});
+    }
+    filter->update(static_cast<double>(scans));
+}
+
+ThreatReport DetectionSystem::makeReport(size_t index, const Position &position, const Position &velocity,
+                                         double distance) const
+{
+    Position enemyTargetPos = enemyMissiles.targetAt(index);
+    Position offset = {position.x - enemyTargetPos.x, position.y - enemyTargetPos.y, position.z - enemyTargetPos.z};
+
+    ThreatReport threat;
+    threat.detectionId = enemyMissiles.idAt(index);
+    threat.enemyId = enemyMissiles.idAt(index);
+    threat.enemyNameId = unidentifiedNameId;
+    threat.targetId = enemyMissiles.targetIdAt(index);
+    threat.distanceToTarget = distance;
+    threat.calculatedSpeed = std::sqrt(velocity.x * velocity.x + velocity.y * velocity.y + velocity.z * velocity.z);
+    threat.timeToImpact = timeToImpact(offset, distance, velocity);
+    threat.enemyPosition = position;
+    threat.enemyVelocity = velocity;
+    return threat;
+}
+
+ThreatReport DetectionSystem::reportAt(size_t index, const Position &position) const
+{
+    Position enemyTargetPos = enemyMissiles.targetAt(index);
+    double dx = position.x - enemyTargetPos.x;
+    double dy = position.y - enemyTargetPos.y;
+    double dz = position.z - enemyTargetPos.z;
+    double distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+
+    // Tracks fly straight at their target, so the velocity is the unit line of sight times speed
+    double speed = enemyMissiles.speedAt(index);
+    double step = distance > 0 ? speed / distance : 0.0;
+    ThreatReport threat = makeReport(index, position, {-dx * step, -dy * step, -dz * step}, distance);
+    threat.calculatedSpeed = speed;
+    return threat;
+}
+
+std::vector<ThreatReport> &DetectionSystem::reportTracks(const std::vector<SystemTrack> &tracks, long tick)
+{
+    reports.clear();
+    reportedRows.assign(enemyMissiles.size(), 0);
+
+    for (const SystemTrack &track : tracks)
+    {
+        long index = enemyMissiles.indexOf(track.enemyId);
+        if (index < 0 || reportedRows[index])
+        {
+            continue;
+        }
+
+        Position position = track.positionAt(tick);
+        Position enemyTargetPos = enemyMissiles.targetAt(index);
+        double dx = position.x - enemyTargetPos.x;
+        double dy = position.y - enemyTargetPos.y;
+        double dz = position.z - enemyTargetPos.z;
+        double distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+        if (distance >= THREAT_RANGE)
+        {
+            continue;
+        }
+        reportedRows[index] = 1;
+
+        ThreatReport threat = makeReport(index, position, track.velocity, distance);
+        threat.detectionId = track.id;
+        reports.push_back(threat);
+    }
+    return reports;
+}
+
+void DetectionSystem::scanRange(size_t begin, size_t end, std::vector<ThreatReport> &out) const
+{
+    if (!filter)
+    {
+#ifdef DETECTION_SYSTEM_HAS_AVX2
+        if (kernel != Kernel::Scalar && avx2Available())
+        {
+            scanTruthAvx2(begin, end, out);
+            return;
+        }
+#endif
+        scanTruthScalar(begin, end, out);
+        return;
+    }
+
+    const int *ids = enemyMissiles.idData();
+
+    // Loop through all our detected enemy missiles
+    for (size_t i = begin; i < end; ++i)
+    {
+        // Get the enemy missile's intended target position
+        Position enemyTargetPos = enemyMissiles.targetAt(i);
+        // Where the radar thinks it is: the filter's estimate
+        long row = filter->rowOf(ids[i]);
+        Position enemyPos = filter->positionAt(row);
 
         // Calculate the 3D distance between the enemy missile and its intended target
-        double dx = enemy.getCurrentPosition().x - enemyTargetPos.x;
-        double dy = enemy.getCurrentPosition().y - enemyTargetPos.y;
-        double dz = enemy.getCurrentPosition().z - enemyTargetPos.z;
-        double distance = std::sqrt(std::pow(dx, 2) + std::pow(dy, 2) + std::pow(dz, 2));
+        double dx = enemyPos.x - enemyTargetPos.x;
+        double dy = enemyPos.y - enemyTargetPos.y;
+        double dz = enemyPos.z - enemyTargetPos.z;
+        double distance = std::sqrt(dx * dx + dy * dy + dz * dz);
 
-        const double THREAT_RANGE = 10000.0;
         if (distance < THREAT_RANGE)
         {
-            ThreatReport threat;
-            threat.detectionId = enemy.getId();
-            threat.enemyId = enemy.getId();
-            threat.enemyName = "Unidentified Threat";
-            threat.targetName = targetName;
-            threat.distanceToTarget = distance;
-            threat.calculatedSpeed = enemy.getSpeed();
-            threat.enemyPosition = enemy.getCurrentPosition();
+            out.push_back(makeReport(i, enemyPos, filter->velocityAt(row), distance));
+        }
+    }
+}
+
+void DetectionSystem::reportIfInRange(size_t index, double distanceSquared, std::vector<ThreatReport> &out) const
+{
+    // The squared gate can pass a track whose rounded distance is exactly
+    // THREAT_RANGE; the same test as the event scheduler's settles it
+    if (std::sqrt(distanceSquared) < THREAT_RANGE)
+    {
+        out.push_back(reportAt(index, enemyMissiles.positionAt(index)));
+    }
+}
+
+void DetectionSystem::scanTruthScalar(size_t begin, size_t end, std::vector<ThreatReport> &out) const
+{
+    const double *xs = enemyMissiles.xData();
+    const double *ys = enemyMissiles.yData();
+    const double *zs = enemyMissiles.zData();
+    const double *targetXs = enemyMissiles.targetXData();
+    const double *targetYs = enemyMissiles.targetYData();
+    const double *targetZs = enemyMissiles.targetZData();
+    const double rangeSquared = THREAT_RANGE * THREAT_RANGE;
+
+    for (size_t i = begin; i < end; ++i)
+    {
+        double dx = xs[i] - targetXs[i];
+        double dy = ys[i] - targetYs[i];
+        double dz = zs[i] - targetZs[i];
+        double distanceSquared = dx * dx + dy * dy + dz * dz;
+        if (distanceSquared < rangeSquared)
+        {
+            reportIfInRange(i, distanceSquared, out);
+        }
+    }
+}
+
+#ifdef DETECTION_SYSTEM_HAS_AVX2
+__attribute__((target("avx2"))) void DetectionSystem::scanTruthAvx2(size_t begin, size_t end,
+                                                                     std::vector<ThreatReport> &out) const
+{
+    const double *xs = enemyMissiles.xData();
+    const double *ys = enemyMissiles.yData();
+    const double *zs = enemyMissiles.zData();
+    const double *targetXs = enemyMissiles.targetXData();
+    const double *targetYs = enemyMissiles.targetYData();
+    const double *targetZs = enemyMissiles.targetZData();
+    const __m256d rangeSquared = _mm256_set1_pd(THREAT_RANGE * THREAT_RANGE);
+    size_t i = begin;
+
+    // Most tracks are out of range: one compare and a movemask skip four of them
+    for (; i + 4 <= end; i += 4)
+    {
+        __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(xs + i), _mm256_loadu_pd(targetXs + i));
+        __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(ys + i), _mm256_loadu_pd(targetYs + i));
+        __m256d dz = _mm256_sub_pd(_mm256_loadu_pd(zs + i), _mm256_loadu_pd(targetZs + i));
+        // Same operation order as the scalar loop, so both gates agree exactly
+        __m256d distanceSquared = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)),
+                                                _mm256_mul_pd(dz, dz));
+        int inRange = _mm256_movemask_pd(_mm256_cmp_pd(distanceSquared, rangeSquared, _CMP_LT_OQ));
+        if (inRange == 0)
+        {
+            continue;
+        }
 
-            currentThreats.push_back(threat);
+        alignas(32) double lanes[4];
+        _mm256_store_pd(lanes, distanceSquared);
+        for (int lane = 0; lane < 4; ++lane)
+        {
+            if (inRange & (1 << lane))
+            {
+                reportIfInRange(i + lane, lanes[lane], out);
+            }
         }
     }
-    return currentThreats;
-}
\ No newline at end of file
+
+    scanTruthScalar(i, end, out);
+}
+#else
+void DetectionSystem::scanTruthAvx2(size_t begin, size_t end, std::vector<ThreatReport> &out) const
+{
+    scanTruthScalar(begin, end, out);
+}
+#endif
+
+bool DetectionSystem::avx2Available()
+{
+#ifdef DETECTION_SYSTEM_HAS_AVX2
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
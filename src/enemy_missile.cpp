@@ -2,8 +2,8 @@
 #include <cmath>
 
 // Implement the constructor to initialize the member variables
-EnemyMissile::EnemyMissile(int id, const Position& start, const Position& target, double speed)
-    : id(id), currentPosition(start), targetPosition(target), speed(speed), startPosition(start)
+EnemyMissile::EnemyMissile(int id, const Position& start, const Position& target, double speed, int targetId)
+    : id(id), currentPosition(start), targetPosition(target), speed(speed), targetId(targetId)
 {
 }
 
@@ -32,4 +32,5 @@ void EnemyMissile::move() {
 const Position& EnemyMissile::getCurrentPosition() const { return currentPosition; }
 int EnemyMissile::getId() const { return id; }
 const Position& EnemyMissile::getTargetPosition() const { return targetPosition; }
-double EnemyMissile::getSpeed() const { return speed; }
\ No newline at end of file
+double EnemyMissile::getSpeed() const { return speed; }
+int EnemyMissile::getTargetId() const { return targetId; }
\ No newline at end of file
@@ -0,0 +1,33 @@
+#include "event_scheduler.h"
+#include <algorithm>
+
+namespace
+{
+    // std heap functions build a max-heap, so "less" means "due later"
+    bool dueLater(const SimEvent &a, const SimEvent &b)
+    {
+        if (a.tick != b.tick)
+        {
+            return a.tick > b.tick;
+        }
+        if (a.type != b.type)
+        {
+            return a.type > b.type;
+        }
+        return a.id > b.id;
+    }
+}
+
+void EventScheduler::schedule(long tick, SimEventType type, int id)
+{
+    heap.push_back({tick, type, id});
+    std::push_heap(heap.begin(), heap.end(), dueLater);
+}
+
+SimEvent EventScheduler::pop()
+{
+    std::pop_heap(heap.begin(), heap.end(), dueLater);
+    SimEvent event = heap.back();
+    heap.pop_back();
+    return event;
+}
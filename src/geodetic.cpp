@@ -0,0 +1,106 @@
+#include "geodetic.h"
+#include <cmath>
+
+namespace
+{
+    const double DEGREES = M_PI / 180.0;
+
+    // Rows east, north, up of the tangent plane at (latitude, longitude), in ECEF
+    void tangentAxes(double latitude, double longitude, double rows[3][3])
+    {
+        double sinLat = std::sin(latitude * DEGREES);
+        double cosLat = std::cos(latitude * DEGREES);
+        double sinLon = std::sin(longitude * DEGREES);
+        double cosLon = std::cos(longitude * DEGREES);
+        rows[0][0] = -sinLon;
+        rows[0][1] = cosLon;
+        rows[0][2] = 0.0;
+        rows[1][0] = -sinLat * cosLon;
+        rows[1][1] = -sinLat * sinLon;
+        rows[1][2] = cosLat;
+        rows[2][0] = cosLat * cosLon;
+        rows[2][1] = cosLat * sinLon;
+        rows[2][2] = sinLat;
+    }
+}
+
+Position geodeticToEcef(const GeodeticPosition &location)
+{
+    double sinLat = std::sin(location.latitude * DEGREES);
+    double cosLat = std::cos(location.latitude * DEGREES);
+    // Prime vertical radius of curvature
+    double n = wgs84::SEMI_MAJOR_AXIS / std::sqrt(1.0 - wgs84::ECCENTRICITY_SQUARED * sinLat * sinLat);
+    double horizontal = (n + location.altitude) * cosLat;
+    return {horizontal * std::cos(location.longitude * DEGREES),
+            horizontal * std::sin(location.longitude * DEGREES),
+            (n * (1.0 - wgs84::ECCENTRICITY_SQUARED) + location.altitude) * sinLat};
+}
+
+GeodeticPosition ecefToGeodetic(const Position &ecef)
+{
+    const double a = wgs84::SEMI_MAJOR_AXIS;
+    const double e2 = wgs84::ECCENTRICITY_SQUARED;
+    const double b = a * (1.0 - wgs84::FLATTENING);
+
+    double p = std::sqrt(ecef.x * ecef.x + ecef.y * ecef.y);
+    double longitude = std::atan2(ecef.y, ecef.x);
+    if (p < 1e-9)
+    {
+        // On the polar axis
+        return {ecef.z >= 0.0 ? 90.0 : -90.0, 0.0, std::fabs(ecef.z) - b};
+    }
+
+    // Bowring's parametric start, then fixed-point iteration; a few rounds
+    // reach millimetre precision anywhere near the surface
+    double beta = std::atan2(a * ecef.z, b * p);
+    double secondE2 = e2 / (1.0 - e2);
+    double latitude = std::atan2(ecef.z + secondE2 * b * std::pow(std::sin(beta), 3),
+                                 p - e2 * a * std::pow(std::cos(beta), 3));
+    double altitude = 0.0;
+    for (int i = 0; i < 3; ++i)
+    {
+        double sinLat = std::sin(latitude);
+        double n = a / std::sqrt(1.0 - e2 * sinLat * sinLat);
+        altitude = p / std::cos(latitude) - n;
+        latitude = std::atan2(ecef.z, p * (1.0 - e2 * n / (n + altitude)));
+    }
+    return {latitude / DEGREES, longitude / DEGREES, altitude};
+}
+
+LocalFrame::LocalFrame(const GeodeticPosition &origin) : origin(origin), originEcef(geodeticToEcef(origin))
+{
+    tangentAxes(origin.latitude, origin.longitude, rotation);
+}
+
+Position LocalFrame::fromEcef(const Position &ecef) const
+{
+    double dx = ecef.x - originEcef.x;
+    double dy = ecef.y - originEcef.y;
+    double dz = ecef.z - originEcef.z;
+    return {rotation[0][0] * dx + rotation[0][1] * dy + rotation[0][2] * dz,
+            rotation[1][0] * dx + rotation[1][1] * dy + rotation[1][2] * dz,
+            rotation[2][0] * dx + rotation[2][1] * dy + rotation[2][2] * dz};
+}
+
+Position LocalFrame::toEcef(const Position &local) const
+{
+    // The rotation is orthonormal, its transpose undoes it
+    return {originEcef.x + rotation[0][0] * local.x + rotation[1][0] * local.y + rotation[2][0] * local.z,
+            originEcef.y + rotation[0][1] * local.x + rotation[1][1] * local.y + rotation[2][1] * local.z,
+            originEcef.z + rotation[0][2] * local.x + rotation[1][2] * local.y + rotation[2][2] * local.z};
+}
+
+LocalFrame::Axes LocalFrame::axesAt(const GeodeticPosition &location) const
+{
+    double rows[3][3];
+    tangentAxes(location.latitude, location.longitude, rows);
+
+    // Directions only: rotate, don't translate
+    auto rotate = [this](const double *direction)
+    {
+        return Position{rotation[0][0] * direction[0] + rotation[0][1] * direction[1] + rotation[0][2] * direction[2],
+                        rotation[1][0] * direction[0] + rotation[1][1] * direction[1] + rotation[1][2] * direction[2],
+                        rotation[2][0] * direction[0] + rotation[2][1] * direction[1] + rotation[2][2] * direction[2]};
+    };
+    return {rotate(rows[0]), rotate(rows[1]), rotate(rows[2])};
+}
@@ -0,0 +1,181 @@
+#include "intercept_solver.h"
+#include <cmath>
+#include <limits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define INTERCEPT_SOLVER_HAS_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    const double UNREACHABLE = std::numeric_limits<double>::infinity();
+
+    // With h = r.v, a = v.v - s^2, c = r.r the roots are (-h -+ sqrt(h^2 - ac)) / a.
+    // The earlier one rewritten as c / (sqrt(h^2 - ac) - h) needs no case split on
+    // the sign of a (faster or slower interceptor, or equal speeds) and is
+    // non-negative exactly when it is a real intercept.
+    inline double timeToGo(double rx, double ry, double rz, double vx, double vy, double vz, double speedSquared)
+    {
+        double c = rx * rx + ry * ry + rz * rz;
+        double h = rx * vx + ry * vy + rz * vz;
+        double a = vx * vx + vy * vy + vz * vz - speedSquared;
+        double discriminant = h * h - a * c;
+        if (c == 0.0)
+        {
+            return 0.0;
+        }
+        if (discriminant < 0.0)
+        {
+            return UNREACHABLE;
+        }
+        double denominator = std::sqrt(discriminant) - h;
+        return denominator > 0.0 ? c / denominator : UNREACHABLE;
+    }
+
+    // A meeting at or past the horizon is no intercept: the track has reached its target by then
+    inline double withinHorizon(double time, double horizon)
+    {
+        return time < horizon ? time : UNREACHABLE;
+    }
+
+    // Shared by both kernels so the vector path and the tail produce identical results
+    void solveRowScalar(const double *x, const double *y, const double *z, const double *speedSquared,
+                        const Position &target, const Position &velocity, double horizon, double *out,
+                        size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            out[i] = withinHorizon(timeToGo(target.x - x[i], target.y - y[i], target.z - z[i],
+                                            velocity.x, velocity.y, velocity.z, speedSquared[i]),
+                                   horizon);
+        }
+    }
+
+#ifdef INTERCEPT_SOLVER_HAS_AVX2
+    __attribute__((target("avx2"))) void solveRowAvx2(const double *x, const double *y, const double *z,
+                                                      const double *speedSquared, const Position &target,
+                                                      const Position &velocity, double horizon, double *out,
+                                                      size_t count)
+    {
+        const __m256d zero = _mm256_setzero_pd();
+        const __m256d horizonVector = _mm256_set1_pd(horizon);
+        const __m256d unreachable = _mm256_set1_pd(UNREACHABLE);
+        const __m256d tx = _mm256_set1_pd(target.x);
+        const __m256d ty = _mm256_set1_pd(target.y);
+        const __m256d tz = _mm256_set1_pd(target.z);
+        const __m256d vx = _mm256_set1_pd(velocity.x);
+        const __m256d vy = _mm256_set1_pd(velocity.y);
+        const __m256d vz = _mm256_set1_pd(velocity.z);
+        const __m256d vv = _mm256_set1_pd(velocity.x * velocity.x + velocity.y * velocity.y + velocity.z * velocity.z);
+        size_t i = 0;
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m256d rx = _mm256_sub_pd(tx, _mm256_loadu_pd(x + i));
+            __m256d ry = _mm256_sub_pd(ty, _mm256_loadu_pd(y + i));
+            __m256d rz = _mm256_sub_pd(tz, _mm256_loadu_pd(z + i));
+
+            __m256d c = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(rx, rx), _mm256_mul_pd(ry, ry)),
+                                      _mm256_mul_pd(rz, rz));
+            __m256d h = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(rx, vx), _mm256_mul_pd(ry, vy)),
+                                      _mm256_mul_pd(rz, vz));
+            __m256d a = _mm256_sub_pd(vv, _mm256_loadu_pd(speedSquared + i));
+            __m256d discriminant = _mm256_sub_pd(_mm256_mul_pd(h, h), _mm256_mul_pd(a, c));
+
+            // Same decisions as timeToGo, as masks: no real root, root behind us, already there
+            __m256d real = _mm256_cmp_pd(discriminant, zero, _CMP_GE_OQ);
+            __m256d denominator = _mm256_sub_pd(_mm256_sqrt_pd(_mm256_max_pd(discriminant, zero)), h);
+            __m256d ahead = _mm256_and_pd(real, _mm256_cmp_pd(denominator, zero, _CMP_GT_OQ));
+            __m256d time = _mm256_blendv_pd(unreachable, _mm256_div_pd(c, denominator), ahead);
+            time = _mm256_blendv_pd(time, zero, _mm256_cmp_pd(c, zero, _CMP_EQ_OQ));
+            time = _mm256_blendv_pd(time, unreachable, _mm256_cmp_pd(time, horizonVector, _CMP_GE_OQ));
+
+            _mm256_storeu_pd(out + i, time);
+        }
+
+        solveRowScalar(x, y, z, speedSquared, target, velocity, horizon, out, i, count);
+    }
+#endif
+}
+
+bool InterceptSolution::reachable() const
+{
+    return timeToGo != UNREACHABLE;
+}
+
+InterceptSolution solveIntercept(const Position &interceptor, double speed,
+                                 const Position &target, const Position &velocity, double horizon)
+{
+    InterceptSolution solution;
+    solution.timeToGo = withinHorizon(timeToGo(target.x - interceptor.x, target.y - interceptor.y,
+                                               target.z - interceptor.z, velocity.x, velocity.y, velocity.z,
+                                               speed * speed),
+                                      horizon);
+    solution.point = target;
+    if (solution.reachable())
+    {
+        solution.point.x += velocity.x * solution.timeToGo;
+        solution.point.y += velocity.y * solution.timeToGo;
+        solution.point.z += velocity.z * solution.timeToGo;
+    }
+    return solution;
+}
+
+void InterceptSolver::clearInterceptors()
+{
+    xs.clear();
+    ys.clear();
+    zs.clear();
+    speedsSquared.clear();
+}
+
+void InterceptSolver::reserveInterceptors(size_t count)
+{
+    xs.reserve(count);
+    ys.reserve(count);
+    zs.reserve(count);
+    speedsSquared.reserve(count);
+}
+
+void InterceptSolver::addInterceptor(const Position &position, double speed)
+{
+    xs.push_back(position.x);
+    ys.push_back(position.y);
+    zs.push_back(position.z);
+    speedsSquared.push_back(speed * speed);
+}
+
+bool InterceptSolver::avx2Available()
+{
+#ifdef INTERCEPT_SOLVER_HAS_AVX2
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+void InterceptSolver::solve(const Position *targets, const Position *velocities, const double *horizons,
+                            size_t rows, double *times) const
+{
+    size_t cols = xs.size();
+
+#ifdef INTERCEPT_SOLVER_HAS_AVX2
+    if (kernel != Kernel::Scalar && avx2Available())
+    {
+        for (size_t row = 0; row < rows; ++row)
+        {
+            solveRowAvx2(xs.data(), ys.data(), zs.data(), speedsSquared.data(),
+                         targets[row], velocities[row], horizons[row], times + row * cols, cols);
+        }
+        return;
+    }
+#endif
+
+    for (size_t row = 0; row < rows; ++row)
+    {
+        solveRowScalar(xs.data(), ys.data(), zs.data(), speedsSquared.data(),
+                       targets[row], velocities[row], horizons[row], times + row * cols, 0, cols);
+    }
+}
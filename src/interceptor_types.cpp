@@ -0,0 +1,24 @@
+#include "interceptor_types.h"
+#include <mutex>
+#include <set>
+#include <string>
+
+std::string_view interceptorName(InterceptorClass kind, std::string_view name)
+{
+    if (const InterceptorSpec *spec = interceptorSpec(kind))
+    {
+        return spec->name;
+    }
+
+    // Scenario files name only a handful of custom classes, so this never
+    // grows past a few entries; set nodes keep their strings in place
+    static std::mutex lock;
+    static std::set<std::string, std::less<>> names;
+    std::lock_guard<std::mutex> guard(lock);
+    auto found = names.find(name);
+    if (found == names.end())
+    {
+        found = names.emplace(name).first;
+    }
+    return *found;
+}
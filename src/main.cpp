@@ -6,10 +6,28 @@
 #include <chrono>
 #include <iomanip>
 #include <cstdlib>
+#include <ctime>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <csignal>
 #include "missile_controller.h"
 #include "enemy_missile.h"
+#include "track_store.h"
 #include "detection_system.h"
 #include "target.h"
+#include "scenario.h"
+#include "simulation.h"
+#include "terminal_renderer.h"
+#include "tick_recorder.h"
+#include "tick_profiler.h"
+#include "tick_pipeline.h"
+#include "monte_carlo.h"
+#include "sharded_theater.h"
+#include "world_publisher.h"
+#include "command_channel.h"
+#include "track_filter.h"
+#include <fstream>
 
 // Color constants for terminal output
 #define RESET "\033[0m"
@@ -21,15 +39,6 @@
 #define BLUE "\033[34m"
 #define MAGENTA "\033[35m"
 
-// Configuration structure for missile initialization
-struct MissileConfig
-{
-    int damage;
-    std::string name;
-    double speed;
-    Position position;
-};
-
 // Menu options enum for better code readability
 enum MenuOption
 {
@@ -38,7 +47,8 @@ enum MenuOption
     DETECT = 3,
     AUTO_INTERCEPT = 4, // New option
     LIVE_VIEW = 5,
-    EXIT = 6
+    PROFILE = 6,
+    EXIT = 7
 };
 // Clear screen function
 void clearScreen()
@@ -83,107 +93,266 @@ int getChoice(const std::string &prompt, int min, int max)
 }
 
 /**
- * Removes an enemy missile from the vector by ID
+ * Removes an enemy missile from the track store by ID
+ */
+bool removeEnemyMissileById(TrackStore &enemies, int id)
+{
+    return enemies.removeById(id);
+}
+
+/**
+ * Splits `available` screen rows between lists that want `wanted[i]` rows each.
+ * Every list gets an equal share, rows a short list doesn't need go to the others.
  */
-bool removeEnemyMissileById(std::vector<EnemyMissile> &enemies, int id)
+std::vector<int> allocateRows(const std::vector<size_t> &wanted, int available)
 {
-    for (auto it = enemies.begin(); it != enemies.end(); ++it)
+    std::vector<int> granted(wanted.size(), 0);
+    bool progress = true;
+    while (available > 0 && progress)
     {
-        if (it->getId() == id)
+        progress = false;
+        for (size_t i = 0; i < wanted.size() && available > 0; ++i)
         {
-            enemies.erase(it);
-            return true;
+            if (static_cast<size_t>(granted[i]) < wanted[i])
+            {
+                ++granted[i];
+                --available;
+                progress = true;
+            }
         }
     }
-    return false;
+    return granted;
+}
+
+/**
+ * Draws up to `maxRows` lines of a list starting at `row`, using the last row
+ * for an "... and N more" note when the list doesn't fit. Returns the next free row.
+ */
+template <typename LineFn>
+int drawList(TerminalRenderer &screen, int row, size_t count, int maxRows,
+             TerminalRenderer::Style style, LineFn line)
+{
+    size_t shown = count <= static_cast<size_t>(maxRows) ? count : static_cast<size_t>(std::max(maxRows - 1, 0));
+    for (size_t i = 0; i < shown; ++i)
+    {
+        screen.print(row++, 0, line(i), style);
+    }
+    if (shown < count && maxRows > 0)
+    {
+        screen.print(row++, 0, "  ... and " + std::to_string(count - shown) + " more", style);
+    }
+    return row;
+}
+
+std::string formatPosition(const Position &pos)
+{
+    return "(" + std::to_string(static_cast<int>(pos.x)) + "," + std::to_string(static_cast<int>(pos.y)) + ")";
+}
+
+std::string formatLocation(const GeodeticPosition &location)
+{
+    char text[48];
+    std::snprintf(text, sizeof(text), "(%.4f%c, %.4f%c)", std::fabs(location.latitude), location.latitude < 0 ? 'S' : 'N',
+                  std::fabs(location.longitude), location.longitude < 0 ? 'W' : 'E');
+    return text;
 }
 
 /**
- * Display live battlefield view
+ * Draws the live battlefield view into the renderer's back buffer
  */
-void displayLiveBattlefield(const MissileController &controller,
-                            const std::vector<EnemyMissile> &enemyMissiles,
+void displayLiveBattlefield(TerminalRenderer &screen,
+                            const std::vector<Missile> &inventory,
+                            const std::vector<Missile> &inFlight,
+                            const TrackStore &enemyMissiles,
                             const std::vector<Target> &targets,
-                            const std::vector<ThreatReport> &threats)
+                            const DetectionSystem &radar,
+                            const std::vector<ThreatReport> &threats,
+                            double framesPerSecond,
+                            const std::string &status = "OPERATIONAL",
+                            const std::string &footer = "Press Ctrl+C to return to menu...")
 {
-    clearScreen();
+    using Color = TerminalRenderer::Color;
+    const TerminalRenderer::Style header = {Color::Cyan, true};
+    const TerminalRenderer::Style red = {Color::Red, false};
+    const TerminalRenderer::Style green = {Color::Green, false};
+    const TerminalRenderer::Style yellow = {Color::Yellow, false};
+    const TerminalRenderer::Style plain = {Color::Default, false};
 
     // Header
-    std::cout << BOLD << CYAN << "═══════════════════════════════════════════════════════════════" << RESET << std::endl;
-    std::cout << BOLD << CYAN << "                    MISSILE DEFENSE COMMAND CENTER             " << RESET << std::endl;
-    std::cout << BOLD << CYAN << "═══════════════════════════════════════════════════════════════" << RESET << std::endl;
+    int row = 0;
+    screen.print(row++, 0, "═══════════════════════════════════════════════════════════════", header);
+    screen.print(row++, 0, "                    MISSILE DEFENSE COMMAND CENTER             ", header);
+    screen.print(row++, 0, "═══════════════════════════════════════════════════════════════", header);
 
     // System status
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    std::cout << YELLOW << "Time: " << std::put_time(std::localtime(&time_t), "%H:%M:%S")
-              << "    Status: " << GREEN << "OPERATIONAL" << RESET << std::endl;
-    std::cout << std::endl;
+    char clock[16];
+    std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::strftime(clock, sizeof(clock), "%H:%M:%S", std::localtime(&now));
+    int col = screen.print(row, 0, std::string("Time: ") + clock + "    Status: ", yellow);
+    col = screen.print(row, col, status, green);
+    screen.print(row++, col, "    " + std::to_string(static_cast<int>(framesPerSecond)) + " FPS", plain);
+    ++row;
+
+    // Section titles, blank separators and the footer take fixed rows, the lists share the rest
+    int fixedRows = row + 5 * 2 + 1;
+    std::vector<int> budget = allocateRows({threats.size(), enemyMissiles.size(), inventory.size(),
+                                            inFlight.size(), targets.size()},
+                                           screen.getRows() - fixedRows);
 
     // Threats section
     if (!threats.empty())
     {
-        std::cout << BOLD << RED << "🚨 ACTIVE THREATS: " << threats.size() << RESET << std::endl;
-        for (const auto &threat : threats)
-        {
-            std::cout << RED << "  ▶ Threat #" << threat.detectionId
-                      << " → " << threat.targetName
-                      << " (Distance: " << static_cast<int>(threat.distanceToTarget) << "km)"
-                      << RESET << std::endl;
-        }
+        screen.print(row++, 0, "🚨 ACTIVE THREATS: " + std::to_string(threats.size()), {Color::Red, true});
+        row = drawList(screen, row, threats.size(), budget[0], red, [&](size_t i)
+                       { return "  ▶ Threat #" + std::to_string(threats[i].detectionId) +
+                                " → " + radar.getTargetName(threats[i].targetId) +
+                                " (Distance: " + std::to_string(static_cast<int>(threats[i].distanceToTarget)) + "m)"; });
     }
     else
     {
-        std::cout << GREEN << "✅ NO THREATS DETECTED" << RESET << std::endl;
+        screen.print(row++, 0, "✅ NO THREATS DETECTED", green);
     }
-    std::cout << std::endl;
+    ++row;
 
     // Enemy missiles
-    std::cout << BOLD << MAGENTA << "🎯 ENEMY MISSILES:" << RESET << std::endl;
+    screen.print(row++, 0, "🎯 ENEMY MISSILES: " + std::to_string(enemyMissiles.size()), {Color::Magenta, true});
     if (enemyMissiles.empty())
     {
-        std::cout << GREEN << "  None detected" << RESET << std::endl;
+        screen.print(row++, 0, "  None detected", green);
     }
     else
     {
-        for (const auto &enemy : enemyMissiles)
-        {
-            Position pos = enemy.getCurrentPosition();
-            Position target = enemy.getTargetPosition();
-            std::cout << RED << "  ▶ ID:" << enemy.getId()
-                      << " Pos:(" << static_cast<int>(pos.x) << "," << static_cast<int>(pos.y) << ")"
-                      << " → (" << static_cast<int>(target.x) << "," << static_cast<int>(target.y) << ")"
-                      << " Speed:" << static_cast<int>(enemy.getSpeed()) << "m/s"
-                      << RESET << std::endl;
-        }
+        row = drawList(screen, row, enemyMissiles.size(), budget[1], red, [&](size_t i)
+                       { return "  ▶ ID:" + std::to_string(enemyMissiles.idAt(i)) +
+                                " Pos:" + formatPosition(enemyMissiles.positionAt(i)) +
+                                " → " + formatPosition(enemyMissiles.targetAt(i)) +
+                                " Speed:" + std::to_string(static_cast<int>(enemyMissiles.speedAt(i))) + "m/s"; });
     }
-    std::cout << std::endl;
+    ++row;
 
     // Our missiles
-    std::cout << BOLD << BLUE << "🚀 OUR MISSILES:" << RESET << std::endl;
-    controller.printAllStatuses();
-    std::cout << std::endl;
+    screen.print(row++, 0, "🚀 OUR MISSILES: " + std::to_string(inventory.size()), {Color::Blue, true});
+    row = drawList(screen, row, inventory.size(), budget[2], plain, [&](size_t i)
+                   {
+                       const Missile &missile = inventory[i];
+                       Position pos = missile.getCurrentPosition();
+                       return "Missile #" + std::to_string(missile.getId()) + " (" + std::string(missile.getName()) + ") at (" +
+                              std::to_string(static_cast<int>(pos.x)) + ", " + std::to_string(static_cast<int>(pos.y)) +
+                              ", " + std::to_string(static_cast<int>(pos.z)) + ")"; });
+    ++row;
+
+    // Interceptors currently flying
+    screen.print(row++, 0, "🛫 INTERCEPTORS IN FLIGHT: " + std::to_string(inFlight.size()), {Color::Blue, true});
+    row = drawList(screen, row, inFlight.size(), budget[3], yellow, [&](size_t i)
+                   {
+                       const Missile &missile = inFlight[i];
+                       int done = static_cast<int>(missile.getFlightProgress() * Missile::FLIGHT_STEPS);
+                       return "[ " + std::string(done, '#') + std::string(Missile::FLIGHT_STEPS - done, ' ') + " ] " +
+                              std::to_string(static_cast<int>(missile.getFlightProgress() * 100)) + "% " +
+                              std::string(missile.getName()) + " #" + std::to_string(missile.getId()) +
+                              " pos: " + formatPosition(missile.getCurrentPosition()); });
+    ++row;
 
     // Targets
-    std::cout << BOLD << YELLOW << "🏙️  PROTECTED TARGETS:" << RESET << std::endl;
-    for (const auto &target : targets)
+    screen.print(row++, 0, "🏙️  PROTECTED TARGETS:", {Color::Yellow, true});
+    row = drawList(screen, row, targets.size(), budget[4], yellow, [&](size_t i)
+                   { return "  ▶ " + targets[i].name + " " + formatLocation(targets[i].location); });
+    ++row;
+
+    screen.print(std::min(row, screen.getRows() - 1), 0, footer, {Color::Cyan, false});
+}
+
+namespace
+{
+    // Set by Ctrl+C while the live view runs, so it can stop its threads and
+    // hand the terminal back instead of the process dying mid-frame
+    volatile std::sig_atomic_t liveViewInterrupted = 0;
+
+    void interruptLiveView(int)
     {
-        std::cout << YELLOW << "  ▶ " << target.name
-                  << " (" << target.position.x << "," << target.position.y << ")"
-                  << RESET << std::endl;
+        liveViewInterrupted = 1;
     }
-    std::cout << std::endl;
+}
+
+std::string describeLiveStatus(const TickPipeline &pipeline, const TickPipeline::WorldFrame &frame)
+{
+    std::string text = pipeline.isPaused() ? "PAUSED" : "OPERATIONAL";
+    text += "  tick " + std::to_string(frame.sensor->tick) + ", auto-intercept " +
+            (frame.autoIntercept ? "on" : "off") + " within " +
+            std::to_string(static_cast<long>(frame.autoInterceptThreshold)) + " m, " +
+            (frame.assignmentMode == MissileController::AssignmentMode::Global ? "global" : "greedy");
+    return text;
+}
 
-    std::cout << CYAN << "Press Ctrl+C to return to menu..." << RESET << std::endl;
+/**
+ * Acts on the operator commands that arrived since the last frame: the live
+ * view's own (pause, quit, ...) right away, the rest through the pipeline's
+ * engagement stage, which owns the controller. Returns false on quit.
+ */
+bool dispatchCommands(CommandChannel &channel, TickPipeline &pipeline, const std::vector<Target> &retaliationTargets,
+                      std::vector<OperatorCommand> &commands)
+{
+    using Type = OperatorCommand::Type;
+
+    bool keepRunning = true;
+    for (OperatorCommand &command : commands)
+    {
+        switch (command.type)
+        {
+        case Type::Quit:
+            channel.reply(command.client, "ok: leaving the live view");
+            keepRunning = false;
+            break;
+        case Type::Pause:
+            pipeline.setPaused(true);
+            channel.reply(command.client, "ok: paused");
+            break;
+        case Type::Resume:
+            pipeline.setPaused(false);
+            channel.reply(command.client, "ok: resumed");
+            break;
+        case Type::Step:
+            if (!pipeline.isPaused())
+            {
+                channel.reply(command.client, "error: step needs pause first");
+                break;
+            }
+            pipeline.step();
+            channel.reply(command.client, "ok: one more tick");
+            break;
+        case Type::Help:
+            channel.reply(command.client, operatorCommandHelp());
+            break;
+        default:
+            if (command.type == Type::Launch)
+            {
+                if (command.target < 1 || static_cast<size_t>(command.target) > retaliationTargets.size())
+                {
+                    channel.reply(command.client, "error: target number must be 1 to " +
+                                                      std::to_string(retaliationTargets.size()));
+                    break;
+                }
+                command.aim = retaliationTargets[command.target - 1].position;
+            }
+            if (!pipeline.submit(command))
+            {
+                channel.reply(command.client, "error: too many commands waiting, try again");
+            }
+            break;
+        }
+    }
+    commands.clear();
+    return keepRunning;
 }
 
-// Update your live view to include auto-intercept
-// FIXED: Updated live view
-void runLiveView(MissileController &controller,
-                 std::vector<EnemyMissile> &enemyMissiles,
-                 const std::vector<Target> &targets,
-                 DetectionSystem &radar)
+/**
+ * Runs the world at its tick rate and draws it, taking operator commands from
+ * the terminal and the control socket without ever waiting on either. Left
+ * with quit or Ctrl+C.
+ */
+void runLiveView(Simulation &sim, CommandChannel &channel, const std::vector<Target> &retaliationTargets)
 {
+    MissileController &controller = sim.getController();
 
     clearScreen();
     std::cout << BOLD << GREEN << "Entering Live View Mode..." << RESET << std::endl;
@@ -191,49 +360,136 @@ void runLiveView(MissileController &controller,
     {
         std::cout << BOLD << MAGENTA << "🤖 Auto-intercept is ACTIVE" << RESET << std::endl;
     }
-    std::cout << "Press Ctrl+C to exit" << std::endl;
+    if (!channel.getPath().empty())
+    {
+        std::cout << "Control socket: " << channel.getPath() << std::endl;
+    }
+    std::cout << "Type help for commands, quit or Ctrl+C to return to the menu" << std::endl;
     std::this_thread::sleep_for(std::chrono::seconds(2));
 
+    // Console messages from the controller would tear the diffed frame, keep it quiet here
+    bool wasVerbose = controller.isVerbose();
+    controller.setVerbose(false);
+
+    using Clock = std::chrono::steady_clock;
+    const auto tickInterval = std::chrono::milliseconds(1500);
+    const auto frameInterval = std::chrono::milliseconds(33); // ~30 FPS
+
+    liveViewInterrupted = 0;
+    struct sigaction interrupt = {};
+    struct sigaction previousInterrupt;
+    interrupt.sa_handler = interruptLiveView;
+    sigemptyset(&interrupt.sa_mask);
+    sigaction(SIGINT, &interrupt, &previousInterrupt);
+    channel.attachConsole();
+
+    // Sensor and engagement tick on their own threads; this one only reads
+    // commands and draws (and logs) whatever they last published, so neither
+    // a slow terminal nor an operator can hold them up
+    TickPipeline pipeline(sim, tickInterval);
+    TerminalRenderer screen;
+    auto lastFrame = Clock::now() - frameInterval;
+    double framesPerSecond = 0.0;
+    std::vector<OperatorCommand> commands;
+
     try
     {
-        while (true)
+        pipeline.start();
+        bool running = true;
+        while (running && !liveViewInterrupted)
         {
-            // Update enemy missile positions
-            for (auto &enemy : enemyMissiles)
-            {
-                enemy.move();
-            }
+            auto frameStart = Clock::now();
 
-            // Scan for threats
-            std::vector<ThreatReport> threats = radar.scanForThreats();
+            channel.poll(commands);
+            running = dispatchCommands(channel, pipeline, retaliationTargets, commands);
 
-            // AUTO-INTERCEPT IN LIVE VIEW (FIXED)
-            if (!threats.empty() && controller.isAutoInterceptEnabled())
+            // Redraw at the frame rate, only changed cells reach the terminal
+            std::shared_ptr<const TickPipeline::WorldFrame> frame = pipeline.poll();
+            for (const TickPipeline::CommandResult &result : pipeline.takeResults())
+            {
+                channel.reply(result.client, result.text);
+            }
+            if (frame)
             {
-                std::vector<int> interceptedIds = controller.autoInterceptThreats(threats);
+                NORAD_PROFILE_PHASE(sim.getProfiler(), TickPhase::Render);
+                const std::string &reply = channel.getConsoleReply();
+                std::string footer = "> " + channel.getConsoleLine() + "_   " +
+                                     (reply.empty() ? "help for commands, quit or Ctrl+C returns to the menu" : reply);
+                screen.beginFrame();
+                displayLiveBattlefield(screen, frame->inventory, frame->inFlight, frame->sensor->tracks,
+                                       sim.getTargets(), sim.getRadar(), frame->threats, framesPerSecond,
+                                       describeLiveStatus(pipeline, *frame), footer);
+                screen.present();
+            }
 
-                // Remove only the actually intercepted missiles
-                for (int enemyId : interceptedIds)
-                {
-                    removeEnemyMissileById(enemyMissiles, enemyId);
-                }
+            double frameSeconds = std::chrono::duration<double>(frameStart - lastFrame).count();
+            if (frameSeconds > 0.0)
+            {
+                framesPerSecond = 1.0 / frameSeconds;
             }
+            lastFrame = frameStart;
 
-            // Rescan after potential interceptions
-            threats = radar.scanForThreats();
+            std::this_thread::sleep_until(frameStart + frameInterval);
+        }
+    }
+    catch (const std::exception &error)
+    {
+        std::cout << RED << "Error: " << error.what() << RESET << std::endl;
+    }
+    pipeline.stop();
+    channel.releaseConsole();
+    sigaction(SIGINT, &previousInterrupt, nullptr);
+    controller.setVerbose(wasVerbose);
+    clearScreen();
+    std::cout << YELLOW << "Exiting live view..." << RESET << std::endl;
+}
+/**
+ * Interactive view of interceptor flight: advances every in-flight missile one
+ * step per frame and redraws its progress bar until all have arrived.
+ * Returns the IDs of enemy missiles hit by the arriving interceptors.
+ */
+std::vector<int> animateFlights(MissileController &controller)
+{
+    std::vector<int> hitEnemyIds;
+    std::vector<Missile> landed;
+    size_t linesDrawn = 0;
 
-            // Display the battlefield
-            displayLiveBattlefield(controller, enemyMissiles, targets, threats);
+    while (controller.getInFlightCount() > 0)
+    {
+        const std::vector<Missile> &arrivals = controller.updateFlights();
+        landed.insert(landed.end(), arrivals.begin(), arrivals.end());
+        for (const auto &missile : arrivals)
+        {
+            if (missile.getTargetEnemyId() >= 0)
+            {
+                hitEnemyIds.push_back(missile.getTargetEnemyId());
+            }
+        }
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+        // Jump back over the previous frame and redraw it
+        if (linesDrawn > 0)
+        {
+            std::cout << "\033[" << linesDrawn << "F\033[J";
         }
+        for (const auto &missile : arrivals)
+        {
+            missile.printFlightProgress();
+            std::cout << "\n";
+        }
+        controller.printFlightStatuses();
+        std::cout << std::flush;
+        linesDrawn = arrivals.size() + controller.getInFlightCount();
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
     }
-    catch (...)
+
+    for (const auto &missile : landed)
     {
-        clearScreen();
-        std::cout << YELLOW << "Exiting live view..." << RESET << std::endl;
+        std::cout << "\033[1;32m" << missile.getName() << " (ID #" << missile.getId() << ") has reached its target!\033[0m" << std::endl;
     }
+    return hitEnemyIds;
 }
+
 /**
  * Handles the missile launch process including target selection
  */
@@ -255,6 +511,7 @@ void handleLaunchMissile(MissileController &controller, const std::vector<Target
         int targetChoice = getChoice("\nChoose a target (by number): ", 1, targets.size());
         const Position &chosenTarget = targets[targetChoice - 1].position;
         controller.launchMissile(*missileToLaunch, chosenTarget);
+        animateFlights(controller);
     }
     else
     {
@@ -266,16 +523,13 @@ void handleLaunchMissile(MissileController &controller, const std::vector<Target
  * Handles threat detection and interception process
  */
 void handleThreatDetection(MissileController &controller,
-                           std::vector<EnemyMissile> &enemyMissiles,
+                           TrackStore &enemyMissiles,
                            DetectionSystem &radar)
 {
     std::cout << BOLD << CYAN << "Scanning for threats..." << RESET << std::endl;
 
     // Update enemy missile positions
-    for (auto &enemy : enemyMissiles)
-    {
-        enemy.move();
-    }
+    enemyMissiles.moveAll();
 
     std::vector<ThreatReport> threats = radar.scanForThreats();
 
@@ -289,7 +543,8 @@ void handleThreatDetection(MissileController &controller,
     if (controller.isAutoInterceptEnabled())
     {
         std::cout << YELLOW << "Auto-intercept system analyzing threats..." << RESET << std::endl;
-        std::vector<int> interceptedEnemyIds = controller.autoInterceptThreats(threats);
+        controller.autoInterceptThreats(threats);
+        std::vector<int> interceptedEnemyIds = animateFlights(controller);
 
         // Remove ONLY the actually intercepted enemy missiles
         for (int enemyId : interceptedEnemyIds)
@@ -332,7 +587,7 @@ void handleThreatDetection(MissileController &controller,
             const auto &threat = threats[i];
             std::cout << i + 1 << ". ID: " << threat.detectionId
                       << ", Enemy: " << threat.enemyId
-                      << ", To: " << threat.targetName
+                      << ", To: " << radar.getTargetName(threat.targetId)
                       << ", Distance: " << static_cast<int>(threat.distanceToTarget)
                       << ", Speed: " << static_cast<int>(threat.calculatedSpeed) << " m/s" << std::endl;
         }
@@ -344,6 +599,7 @@ void handleThreatDetection(MissileController &controller,
         {
             const ThreatReport &chosenThreat = threats[interceptChoice - 1];
             int enemyMissileId = controller.interceptThreat(chosenThreat);
+            animateFlights(controller);
 
             if (removeEnemyMissileById(enemyMissiles, enemyMissileId))
             {
@@ -368,7 +624,8 @@ void displayMenu()
     std::cout << "3. Detect Incoming Threats\n";
     std::cout << "4. 🤖 Auto-Intercept Settings\n"; // New option
     std::cout << "5. 🔴 Live Battlefield View\n";
-    std::cout << "6. Exit\n";
+    std::cout << "6. ⏱  Tick Latency Profile\n";
+    std::cout << "7. Exit\n";
 }
 
 void handleAutoInterceptMenu(MissileController &controller)
@@ -382,10 +639,11 @@ void handleAutoInterceptMenu(MissileController &controller)
         std::cout << "\n1. Toggle Auto-Intercept\n";
         std::cout << "2. Set Distance Threshold\n";
         std::cout << "3. Set Max Auto-Intercept Missiles\n";
-        std::cout << "4. Reset Usage Counter\n";
-        std::cout << "5. Back to Main Menu\n";
+        std::cout << "4. Toggle Assignment Mode (greedy/global)\n";
+        std::cout << "5. Reset Usage Counter\n";
+        std::cout << "6. Back to Main Menu\n";
 
-        int choice = getChoice("\nChoose option: ", 1, 5);
+        int choice = getChoice("\nChoose option: ", 1, 6);
 
         switch (choice)
         {
@@ -397,7 +655,7 @@ void handleAutoInterceptMenu(MissileController &controller)
         }
         case 2:
         {
-            std::cout << "Enter new threshold distance (km): ";
+            std::cout << "Enter new threshold distance (m): ";
             double threshold;
             std::cin >> threshold;
             if (threshold > 0)
@@ -417,75 +675,770 @@ void handleAutoInterceptMenu(MissileController &controller)
             break;
         }
         case 4:
+        {
+            bool global = controller.getAssignmentMode() == MissileController::AssignmentMode::Global;
+            controller.setAssignmentMode(global ? MissileController::AssignmentMode::Greedy
+                                                : MissileController::AssignmentMode::Global);
+            break;
+        }
+        case 5:
         {
             // Reset the usage counter (you'd need to add this method)
             std::cout << GREEN << "Usage counter reset" << RESET << std::endl;
             break;
         }
-        case 5:
+        case 6:
             return; // Back to main menu
         }
     }
 }
 
+// Options for the non-interactive entry points
+struct CommandLineOptions
+{
+    bool headless = false;
+    bool eventDriven = false; // Headless run on the next-event core
+    long ticks = 1000;
+    size_t tracks = 0; // 0 = the default demo scenario
+    size_t interceptors = 5;
+    int maxAutoIntercept = 3;
+    double autoInterceptThreshold = 2000.0;
+    size_t workers = 1;
+    unsigned seed = 1;
+    bool greedyAssignment = false;
+    std::string scenarioPath; // Binary scenario file, overrides --tracks
+    std::string recordPath;   // Tick log to write while running
+    std::string publishName;  // Shared-memory object the world is published to every tick
+    std::string controlPath;  // Unix-domain socket the live view takes operator commands on
+    std::string replayPath;   // Tick log to play back instead of simulating
+    double replaySpeed = 1.0;
+    long replayFrom = -1;     // First tick shown, -1 = start of the log
+    std::string profileJsonPath; // Phase latency histograms written here at exit
+    size_t monteCarloReplicates = 0; // 0 = a single run
+    size_t radars = 0;               // Radar sites added to the scenario, 0 = ideal radar
+    double radarNoise = 0.0;         // Measurement error of the ideal radar, 1 sigma per axis
+    size_t shards = 0;               // Worker processes of a sharded run, 0 = a single process
+};
+
+void printUsage(const char *program)
+{
+    std::cout << "Usage: " << program << " [--headless [--event-driven]] [--ticks N] [--tracks N]\n"
+              << "          [--interceptors N] [--max-auto N] [--threshold D] [--seed N] [--workers N]\n"
+              << "          [--assignment greedy|global] [--scenario FILE]\n"
+              << "          [--record FILE] [--replay FILE [--replay-speed X] [--replay-from TICK]]\n"
+              << "          [--profile-json FILE] [--monte-carlo N] [--radars N] [--radar-noise S]\n"
+              << "          [--shards N] [--publish NAME] [--control PATH]\n\n"
+              << "  --headless        Run N fixed ticks with no terminal UI and report throughput\n"
+              << "  --event-driven    Headless: jump between predicted events instead of stepping every tick\n"
+              << "  --ticks N         Number of ticks to simulate (default 1000)\n"
+              << "  --tracks N        Use a synthetic salvo of N enemy tracks instead of the demo scenario\n"
+              << "  --interceptors N  Interceptor magazine size for the salvo (default 5)\n"
+              << "  --max-auto N      Max auto-intercept launches (default 3)\n"
+              << "  --threshold D     Auto-intercept threats within distance D (default 2000)\n"
+              << "  --seed N          RNG seed for the salvo (default 1)\n"
+              << "  --workers N       Threads used by the radar scan, or by --monte-carlo replicates (default 1)\n"
+              << "  --assignment M    Auto-intercept pairing: global (default) or greedy\n"
+              << "  --scenario FILE   Load a binary scenario (see norad_scenario_convert)\n"
+              << "  --record FILE     Write every tick to a replay log\n"
+              << "  --replay FILE     Play back a replay log (headless: decode it and summarize)\n"
+              << "  --replay-speed X  Live playback rate multiplier (default 1)\n"
+              << "  --replay-from T   Start playback at tick T\n"
+              << "  --profile-json F  Write per-phase tick latency histograms to F at exit\n"
+              << "  --monte-carlo N   Run N perturbed replicates of the scenario and summarize leakers,\n"
+              << "                    interceptor expenditure and time to engage\n"
+              << "  --radars N        Watch the scenario with N radar sites and fuse their plots\n"
+              << "  --radar-noise S   Radar position error S (1 sigma per axis), tracked with Kalman filters\n"
+              << "  --shards N        Headless: split the theater into N spatial shards, one worker process each\n"
+              << "  --publish NAME    Publish every tick to POSIX shared memory NAME (e.g. /norad-world)\n"
+              << "                    for readers such as norad_snapshot_watch\n"
+              << "  --control PATH    Take live view commands on a Unix-domain socket at PATH too\n";
+}
+
 /**
- * Initializes system data including missiles, targets, and enemy missiles
+ * Parses command line flags, returns false (after printing usage) on bad input
  */
-void initializeSystem(MissileController &controller,
-                      std::vector<EnemyMissile> &enemyMissiles,
-                      const std::vector<Target> &targets)
-{
-    int missileId = 1;
-
-    // Launch pad positions
-    const Position launchPadA = {100.0, 50.0, 0.0};
-    const Position launchPadB = {200.0, 75.0, 0.0};
-
-    // Missile configurations
-    const std::vector<MissileConfig> configs = {
-        {100, "Patriot", 80.0, launchPadA},
-        {100, "Patriot", 80.0, launchPadA},
-        {200, "Tomahawk", 100.0, launchPadB},
-        {50, "Stinger", 120.0, launchPadB},
-        {150, "Javelin", 90.0, launchPadA}};
-
-    // Add missiles to controller
-    for (const auto &config : configs)
-    {
-        controller.addMissile(Missile(
-            missileId++,
-            config.damage,
-            config.name,
-            config.speed,
-            config.position));
-    }
-
-    // Initialize enemy missiles with more interesting movement
-    enemyMissiles.push_back(EnemyMissile(101, {5000.0, 3000.0, 0.0}, targets[0].position, 50.0));
-    enemyMissiles.push_back(EnemyMissile(102, {6000.0, 4000.0, 0.0}, targets[1].position, 75.0));
-    enemyMissiles.push_back(EnemyMissile(103, {4500.0, 2500.0, 0.0}, targets[2].position, 60.0));
+bool parseCommandLine(int argc, char *argv[], CommandLineOptions &options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        try
+        {
+            if (arg == "--headless")
+            {
+                options.headless = true;
+            }
+            else if (arg == "--event-driven")
+            {
+                options.eventDriven = true;
+            }
+            else if (arg == "--ticks" && hasValue)
+            {
+                options.ticks = std::stol(argv[++i]);
+            }
+            else if (arg == "--tracks" && hasValue)
+            {
+                options.tracks = std::stoul(argv[++i]);
+            }
+            else if (arg == "--interceptors" && hasValue)
+            {
+                options.interceptors = std::stoul(argv[++i]);
+            }
+            else if (arg == "--max-auto" && hasValue)
+            {
+                options.maxAutoIntercept = std::stoi(argv[++i]);
+            }
+            else if (arg == "--threshold" && hasValue)
+            {
+                options.autoInterceptThreshold = std::stod(argv[++i]);
+                if (options.autoInterceptThreshold < 0.0)
+                {
+                    throw std::invalid_argument("threshold");
+                }
+            }
+            else if (arg == "--monte-carlo" && hasValue)
+            {
+                options.monteCarloReplicates = std::stoul(argv[++i]);
+                if (options.monteCarloReplicates == 0)
+                {
+                    throw std::invalid_argument("replicates");
+                }
+            }
+            else if (arg == "--shards" && hasValue)
+            {
+                options.shards = std::stoul(argv[++i]);
+                if (options.shards == 0)
+                {
+                    throw std::invalid_argument("shards");
+                }
+            }
+            else if (arg == "--radars" && hasValue)
+            {
+                options.radars = std::stoul(argv[++i]);
+            }
+            else if (arg == "--radar-noise" && hasValue)
+            {
+                options.radarNoise = std::stod(argv[++i]);
+                if (options.radarNoise < 0.0)
+                {
+                    throw std::invalid_argument("noise");
+                }
+            }
+            else if (arg == "--workers" && hasValue)
+            {
+                options.workers = std::stoul(argv[++i]);
+            }
+            else if (arg == "--seed" && hasValue)
+            {
+                options.seed = static_cast<unsigned>(std::stoul(argv[++i]));
+            }
+            else if (arg == "--scenario" && hasValue)
+            {
+                options.scenarioPath = argv[++i];
+            }
+            else if (arg == "--record" && hasValue)
+            {
+                options.recordPath = argv[++i];
+            }
+            else if (arg == "--publish" && hasValue)
+            {
+                options.publishName = argv[++i];
+            }
+            else if (arg == "--control" && hasValue)
+            {
+                options.controlPath = argv[++i];
+            }
+            else if (arg == "--profile-json" && hasValue)
+            {
+                options.profileJsonPath = argv[++i];
+            }
+            else if (arg == "--replay" && hasValue)
+            {
+                options.replayPath = argv[++i];
+            }
+            else if (arg == "--replay-speed" && hasValue)
+            {
+                options.replaySpeed = std::stod(argv[++i]);
+                if (options.replaySpeed <= 0.0)
+                {
+                    throw std::invalid_argument("speed");
+                }
+            }
+            else if (arg == "--replay-from" && hasValue)
+            {
+                options.replayFrom = std::stol(argv[++i]);
+            }
+            else if (arg == "--assignment" && hasValue && (std::string(argv[i + 1]) == "greedy" || std::string(argv[i + 1]) == "global"))
+            {
+                options.greedyAssignment = std::string(argv[++i]) == "greedy";
+            }
+            else
+            {
+                printUsage(argv[0]);
+                return false;
+            }
+        }
+        catch (const std::exception &)
+        {
+            std::cout << RED << "Invalid value for " << arg << RESET << "\n";
+            printUsage(argv[0]);
+            return false;
+        }
+    }
+
+    // The tick log needs every tick, the event core skips them
+    if (options.eventDriven && !options.recordPath.empty())
+    {
+        std::cout << RED << "--event-driven can't be combined with --record" << RESET << "\n";
+        return false;
+    }
+    // Radar plots and noisy measurements are neither predicted nor logged
+    if ((options.radars > 0 || options.radarNoise > 0.0) && (options.eventDriven || !options.recordPath.empty()))
+    {
+        std::cout << RED << "--radars and --radar-noise can't be combined with --event-driven or --record" << RESET << "\n";
+        return false;
+    }
+    // Replicates run on the tick core, unrecorded
+    if (options.monteCarloReplicates > 0 && (options.eventDriven || !options.recordPath.empty() || !options.replayPath.empty()))
+    {
+        std::cout << RED << "--monte-carlo can't be combined with --event-driven, --record or --replay" << RESET << "\n";
+        return false;
+    }
+    // Snapshots come from the tick core of one process
+    if (!options.publishName.empty() && (options.eventDriven || !options.replayPath.empty() ||
+                                         options.monteCarloReplicates > 0 || options.shards > 0))
+    {
+        std::cout << RED << "--publish can't be combined with --event-driven, --replay, --monte-carlo or --shards"
+                  << RESET << "\n";
+        return false;
+    }
+    // Commands steer the interactive live view
+    if (!options.controlPath.empty() && (options.headless || !options.replayPath.empty() ||
+                                         options.monteCarloReplicates > 0 || options.shards > 0))
+    {
+        std::cout << RED << "--control can't be combined with --headless, --replay, --monte-carlo or --shards"
+                  << RESET << "\n";
+        return false;
+    }
+    // Shards run the tick core on the ideal radar, each in its own process
+    if (options.shards > 0 && (!options.headless || options.eventDriven || !options.recordPath.empty() ||
+                               !options.replayPath.empty() || options.monteCarloReplicates > 0 ||
+                               options.radars > 0 || options.radarNoise > 0.0))
+    {
+        std::cout << RED << "--shards needs --headless and can't be combined with --event-driven, --record, --replay, "
+                  << "--monte-carlo, --radars or --radar-noise" << RESET << "\n";
+        return false;
+    }
+    return true;
 }
 
-int main()
+void showTickProfile(const TickProfiler &profiler)
 {
+    std::cout << "\n"
+              << BOLD << CYAN << "Tick Latency Profile:" << RESET << "\n";
+    if (!TickProfiler::ENABLED)
+    {
+        std::cout << YELLOW << "Built without NORAD_TICK_PROFILING, no timings recorded." << RESET << "\n";
+        return;
+    }
+    if (profiler.get(TickPhase::Tick).getCount() == 0)
+    {
+        std::cout << "No ticks yet - run the live view first.\n";
+        return;
+    }
+    profiler.print(std::cout);
+}
+
+/**
+ * Writes the phase histograms to the --profile-json file, if one was given
+ */
+void dumpTickProfile(const CommandLineOptions &options, const TickProfiler &profiler)
+{
+    if (options.profileJsonPath.empty())
+    {
+        return;
+    }
+    std::ofstream out(options.profileJsonPath);
+    profiler.writeJson(out);
+    if (!out)
+    {
+        std::cout << RED << "Error: cannot write " << options.profileJsonPath << RESET << "\n";
+    }
+}
+
+/**
+ * How far the radar's Kalman estimates are from the truth, over every track still filtered
+ */
+void printFilterError(const TrackFilter &filter, const TrackStore &enemies)
+{
+    double positionSquared = 0.0;
+    double velocitySquared = 0.0;
+    size_t count = 0;
+    for (size_t i = 0; i < enemies.size(); ++i)
+    {
+        long row = filter.rowOf(enemies.idAt(i));
+        if (row < 0)
+        {
+            continue;
+        }
+        // Tracks fly straight at their target at constant speed
+        Position truth = enemies.positionAt(i);
+        Position target = enemies.targetAt(i);
+        double tx = target.x - truth.x, ty = target.y - truth.y, tz = target.z - truth.z;
+        double remaining = std::sqrt(tx * tx + ty * ty + tz * tz);
+        double step = remaining > 0.0 ? enemies.speedAt(i) / remaining : 0.0;
+
+        Position position = filter.positionAt(row);
+        Position velocity = filter.velocityAt(row);
+        double dx = position.x - truth.x, dy = position.y - truth.y, dz = position.z - truth.z;
+        double vx = velocity.x - tx * step, vy = velocity.y - ty * step, vz = velocity.z - tz * step;
+        positionSquared += dx * dx + dy * dy + dz * dz;
+        velocitySquared += vx * vx + vy * vy + vz * vz;
+        ++count;
+    }
+    double divisor = count > 0 ? static_cast<double>(count) : 1.0;
+    std::cout << "  Radar noise:    " << std::setprecision(1) << filter.getMeasurementNoise() << " m per axis, "
+              << count << " tracks filtered\n"
+              << "  Track error:    " << std::setprecision(2) << std::sqrt(positionSquared / divisor) << " m, "
+              << std::sqrt(velocitySquared / divisor) << " m/tick RMS (measurements "
+              << filter.getMeasurementNoise() * std::sqrt(3.0) << " m)\n";
+}
+
+Scenario loadScenario(const CommandLineOptions &options)
+{
+    Scenario scenario;
+    if (!options.scenarioPath.empty())
+    {
+        scenario = Scenario::loadBinary(options.scenarioPath);
+    }
+    else if (options.tracks > 0)
+    {
+        scenario = Scenario::makeSalvo(options.tracks, options.interceptors, options.seed);
+    }
+    else
+    {
+        scenario = Scenario::makeDefault();
+    }
+    scenario.addRadarNetwork(options.radars);
+    scenario.radarNoise = options.radarNoise;
+    return scenario;
+}
+
+/**
+ * Headless batch mode: no menus, no screen clearing, no sleeps
+ */
+int runHeadlessMode(const CommandLineOptions &options, const Scenario &scenario,
+                    std::chrono::steady_clock::time_point loadStart)
+{
+    Simulation sim(scenario);
+    double setupSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - loadStart).count();
+    sim.getController().setVerbose(false);
+    sim.getController().setMaxAutoInterceptMissiles(options.maxAutoIntercept);
+    sim.getController().setAutoInterceptThreshold(options.autoInterceptThreshold);
+    sim.getController().setAssignmentMode(options.greedyAssignment ? MissileController::AssignmentMode::Greedy
+                                                                   : MissileController::AssignmentMode::Global);
+    sim.getRadar().setWorkerCount(options.workers);
+    if (SensorNetwork *sensors = sim.getSensors())
+    {
+        sensors->setWorkerCount(options.workers);
+    }
+    if (!options.recordPath.empty())
+    {
+        try
+        {
+            sim.startRecording(options.recordPath);
+        }
+        catch (const std::runtime_error &error)
+        {
+            std::cout << RED << "Error: " << error.what() << RESET << "\n";
+            return 1;
+        }
+    }
+    if (!options.publishName.empty())
+    {
+        try
+        {
+            sim.startPublishing(options.publishName);
+        }
+        catch (const std::exception &error)
+        {
+            std::cout << RED << "Error: " << error.what() << RESET << "\n";
+            return 1;
+        }
+    }
+
+    SimulationStats stats = options.eventDriven ? sim.runEventDriven(options.ticks) : sim.runHeadless(options.ticks);
+
+    const TickArena &arena = sim.getController().getScratchArena();
+    std::cout << (options.eventDriven ? "Event-driven run: " : "Headless run: ")
+              << scenario.trackCount() << " tracks, "
+              << scenario.interceptors.size() << " interceptors, "
+              << options.workers << " scan worker(s)\n"
+              << "  Setup:          " << std::fixed << std::setprecision(3) << setupSeconds << " s\n"
+              << "  Ticks:          " << stats.ticks << "\n"
+              << "  Elapsed:        " << std::fixed << std::setprecision(3) << stats.elapsedSeconds << " s\n"
+              << "  Ticks/sec:      " << std::setprecision(1) << stats.ticksPerSecond() << "\n"
+              << "  Tracks/sec:     " << stats.tracksPerSecond() << "\n"
+              << "  Threat reports: " << stats.threatReports << "\n"
+              << "  Intercepts:     " << stats.interceptsLaunched << " launched, "
+              << stats.enemiesDestroyed << " enemies destroyed\n"
+              << "  Impacts:        " << stats.impacts << "\n"
+              << "  Scratch arena:  " << arena.getHighWater() / 1024 << " KiB high-water, "
+              << arena.getCapacity() / 1024 << " KiB block, " << arena.getOverflowCount() << " overflow(s)\n";
+    if (options.eventDriven)
+    {
+        std::cout << "  Events:         " << stats.eventsProcessed << "\n";
+    }
+    if (const SensorNetwork *sensors = sim.getSensors())
+    {
+        const TrackFusion &fusion = sensors->getFusion();
+        std::cout << "  Sensors:        " << sensors->getSites().size() << " radar sites, "
+                  << sensors->getPlotCount() << " plots\n"
+                  << "  Fusion:         " << fusion.getTracksCreated() << " system tracks started, "
+                  << fusion.getTracks().size() << " live, " << fusion.getTagSwitches() << " tag switches\n";
+    }
+    if (const TrackFilter *filter = sim.getRadar().getFilter())
+    {
+        printFilterError(*filter, sim.getEnemies());
+    }
+    if (const TickRecorder *recorder = sim.getRecorder())
+    {
+        std::cout << "  Recorded:       " << recorder->getFramesWritten() << " frames, "
+                  << recorder->getBytesWritten() << " bytes to " << options.recordPath << "\n";
+    }
+    if (const WorldPublisher *publisher = sim.getPublisher())
+    {
+        std::cout << "  Published:      " << publisher->getFramesPublished() << " frames to " << publisher->getName() << "\n";
+    }
+    if (TickProfiler::ENABLED && stats.ticks > 0 && !options.eventDriven)
+    {
+        std::cout << "\n";
+        sim.getProfiler().print(std::cout);
+    }
+    dumpTickProfile(options, sim.getProfiler());
+    return 0;
+}
+
+/**
+ * Monte Carlo analysis: perturbed replicates of the scenario spread over --workers threads
+ */
+int runMonteCarloMode(const CommandLineOptions &options, const Scenario &scenario)
+{
+    MonteCarloConfig config;
+    config.replicates = options.monteCarloReplicates;
+    config.ticks = options.ticks;
+    config.seed = options.seed;
+    config.workers = options.workers;
+    config.maxAutoIntercept = options.maxAutoIntercept;
+    config.autoInterceptThreshold = options.autoInterceptThreshold;
+    config.assignmentMode = options.greedyAssignment ? MissileController::AssignmentMode::Greedy
+                                                     : MissileController::AssignmentMode::Global;
+
+    MonteCarloReport report = runMonteCarlo(scenario, config);
+
+    std::cout << "Monte Carlo run: " << config.replicates << " replicates x " << config.ticks << " ticks, "
+              << scenario.trackCount() << " tracks, " << scenario.interceptors.size() << " interceptors, "
+              << config.workers << " worker(s)\n"
+              << "  Engagement:     threshold " << std::fixed << std::setprecision(1) << config.autoInterceptThreshold
+              << ", max auto " << config.maxAutoIntercept << ", "
+              << (options.greedyAssignment ? "greedy" : "global") << " assignment\n"
+              << "  Perturbation:   launch +-" << config.launchJitter << ", speed +-"
+              << config.speedJitter * 100.0 << "%, delay 0-" << config.maxLaunchDelay << " ticks, seed " << config.seed << "\n"
+              << "  Elapsed:        " << std::setprecision(3) << report.elapsedSeconds << " s\n";
+    report.print(std::cout);
+    return 0;
+}
+
+/**
+ * Sharded run: the theater split into --shards spatial shards, one worker process each
+ */
+int runShardedMode(const CommandLineOptions &options, const Scenario &scenario)
+{
+    ShardedConfig config;
+    config.shards = options.shards;
+    config.ticks = options.ticks;
+    config.scanWorkers = options.workers;
+    config.maxAutoIntercept = options.maxAutoIntercept;
+    config.autoInterceptThreshold = options.autoInterceptThreshold;
+    config.assignmentMode = options.greedyAssignment ? MissileController::AssignmentMode::Greedy
+                                                     : MissileController::AssignmentMode::Global;
+
+    ShardedReport report;
+    try
+    {
+        report = runSharded(scenario, config);
+    }
+    catch (const std::exception &error)
+    {
+        std::cout << RED << "Error: " << error.what() << RESET << "\n";
+        return 1;
+    }
+
+    std::cout << "Sharded run: " << scenario.trackCount() << " tracks, " << scenario.interceptors.size()
+              << " interceptors, " << config.shards << " shard process(es), "
+              << config.scanWorkers << " scan worker(s) each\n";
+    report.print(std::cout);
+    return 0;
+}
+
+/**
+ * Plays a tick log back through the live battlefield view, one recorded tick
+ * per simulation interval (scaled by --replay-speed). Reads the live view's
+ * commands from the terminal without waiting on it: pause, resume and step
+ * move through the log, quit or Ctrl+C leaves.
+ */
+void runReplayView(TickReplayer &replay, double speed)
+{
+    using Clock = std::chrono::steady_clock;
+    using Type = OperatorCommand::Type;
+    const auto tickInterval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.5 / speed));
+    const auto frameInterval = std::chrono::milliseconds(33);
+
+    liveViewInterrupted = 0;
+    struct sigaction interrupt = {};
+    struct sigaction previousInterrupt;
+    interrupt.sa_handler = interruptLiveView;
+    sigemptyset(&interrupt.sa_mask);
+    sigaction(SIGINT, &interrupt, &previousInterrupt);
+    CommandChannel channel;
+    channel.attachConsole();
+
+    TerminalRenderer screen;
+    auto nextTick = Clock::now() + tickInterval;
+    auto lastFrame = Clock::now() - frameInterval;
+    double framesPerSecond = 0.0;
+    bool finished = false;
+    bool paused = false;
+    std::vector<OperatorCommand> commands;
+
+    try
+    {
+        bool running = true;
+        while (running && !liveViewInterrupted)
+        {
+            auto frameStart = Clock::now();
+
+            channel.poll(commands);
+            for (const OperatorCommand &command : commands)
+            {
+                switch (command.type)
+                {
+                case Type::Quit:
+                    running = false;
+                    break;
+                case Type::Pause:
+                    paused = true;
+                    channel.reply(command.client, "ok: paused");
+                    break;
+                case Type::Resume:
+                    paused = false;
+                    nextTick = frameStart + tickInterval;
+                    channel.reply(command.client, "ok: resumed");
+                    break;
+                case Type::Step:
+                    if (!paused)
+                    {
+                        channel.reply(command.client, "error: step needs pause first");
+                        break;
+                    }
+                    finished = finished || !replay.next();
+                    channel.reply(command.client, "ok: one more tick");
+                    break;
+                default:
+                    channel.reply(command.client, "error: a replay only takes pause, resume, step and quit");
+                    break;
+                }
+            }
+            commands.clear();
+
+            while (!paused && !finished && frameStart >= nextTick)
+            {
+                finished = !replay.next();
+                nextTick += tickInterval;
+            }
+
+            std::string status = "REPLAY tick " + std::to_string(replay.getTick()) + "/" +
+                                 std::to_string(replay.getLastTick()) + (finished ? " (end)" : paused ? " (paused)" : "");
+            const std::string &reply = channel.getConsoleReply();
+            std::string footer = "> " + channel.getConsoleLine() + "_   " +
+                                 (reply.empty() ? "pause, resume, step; quit or Ctrl+C leaves the replay" : reply);
+            screen.beginFrame();
+            displayLiveBattlefield(screen, replay.getController().getMissiles(),
+                                   replay.getController().getInFlightMissiles(), replay.getEnemies(),
+                                   replay.getTargets(), replay.getRadar(), replay.getThreats(), framesPerSecond,
+                                   status, footer);
+            screen.present();
+
+            double frameSeconds = std::chrono::duration<double>(frameStart - lastFrame).count();
+            if (frameSeconds > 0.0)
+            {
+                framesPerSecond = 1.0 / frameSeconds;
+            }
+            lastFrame = frameStart;
+
+            std::this_thread::sleep_until(frameStart + frameInterval);
+        }
+    }
+    catch (const std::exception &error)
+    {
+        std::cout << RED << "Error: " << error.what() << RESET << std::endl;
+    }
+    channel.releaseConsole();
+    sigaction(SIGINT, &previousInterrupt, nullptr);
+    clearScreen();
+    std::cout << YELLOW << "Exiting replay..." << RESET << std::endl;
+}
+
+int runReplayMode(const CommandLineOptions &options)
+{
+    try
+    {
+        auto start = std::chrono::steady_clock::now();
+        TickReplayer replay(options.replayPath);
+        if (options.replayFrom >= 0)
+        {
+            replay.seek(options.replayFrom);
+        }
+        else
+        {
+            replay.next();
+        }
+
+        if (!options.headless)
+        {
+            runReplayView(replay, options.replaySpeed);
+            return 0;
+        }
+
+        long decoded = replay.getTick() >= 0 ? 1 : 0;
+        while (replay.next())
+        {
+            ++decoded;
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "Replay: " << options.replayPath << "\n"
+                  << "  Frames:         " << replay.getFrameCount() << " (" << replay.getKeyframeCount() << " keyframes), ticks "
+                  << replay.getFirstTick() << "-" << replay.getLastTick() << "\n"
+                  << "  Decoded:        " << decoded << " frames in " << std::fixed << std::setprecision(3) << seconds << " s\n"
+                  << "  Final tick:     " << replay.getTick() << "\n"
+                  << "  Tracks:         " << replay.getEnemies().size() << "\n"
+                  << "  Threats:        " << replay.getThreats().size() << "\n"
+                  << "  In flight:      " << replay.getController().getInFlightCount() << "\n"
+                  << "  Inventory:      " << replay.getController().getMissiles().size() << "\n";
+    }
+    catch (const std::exception &error)
+    {
+        std::cout << RED << "Error: " << error.what() << RESET << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    CommandLineOptions options;
+    if (!parseCommandLine(argc, argv, options))
+    {
+        return 1;
+    }
+
+    if (!options.replayPath.empty())
+    {
+        return runReplayMode(options);
+    }
+
+    auto loadStart = std::chrono::steady_clock::now();
+    Scenario scenario;
+    try
+    {
+        scenario = loadScenario(options);
+    }
+    catch (const std::exception &error)
+    {
+        std::cout << RED << "Error: " << error.what() << RESET << "\n";
+        return 1;
+    }
+
+    if (options.monteCarloReplicates > 0)
+    {
+        return runMonteCarloMode(options, scenario);
+    }
+    if (options.shards > 0)
+    {
+        return runShardedMode(options, scenario);
+    }
+    if (options.headless)
+    {
+        return runHeadlessMode(options, scenario, loadStart);
+    }
+
     std::cout << BOLD << GREEN << "\nNORAD Missile System Engaged" << RESET << "\n";
 
     // System initialization
-    MissileController controller;
-    std::vector<EnemyMissile> enemyMissiles;
-
-    const std::vector<Target> usTargets = {
-        {"New York", {-74.0, 40.7, 0.0}},
-        {"Washington DC", {-77.0, 38.9, 0.0}},
-        {"Los Angeles", {-118.2, 34.0, 0.0}}};
+    Simulation sim(scenario);
+    MissileController &controller = sim.getController();
+    TrackStore &enemyMissiles = sim.getEnemies();
+    DetectionSystem &radar = sim.getRadar();
+    radar.setWorkerCount(options.workers);
+    if (SensorNetwork *sensors = sim.getSensors())
+    {
+        sensors->setWorkerCount(options.workers);
+    }
+    if (options.greedyAssignment)
+    {
+        controller.setAssignmentMode(MissileController::AssignmentMode::Greedy);
+    }
+    if (!options.recordPath.empty())
+    {
+        try
+        {
+            sim.startRecording(options.recordPath);
+        }
+        catch (const std::exception &error)
+        {
+            std::cout << RED << "Error: " << error.what() << RESET << "\n";
+            return 1;
+        }
+    }
+    if (!options.publishName.empty())
+    {
+        try
+        {
+            sim.startPublishing(options.publishName);
+        }
+        catch (const std::exception &error)
+        {
+            std::cout << RED << "Error: " << error.what() << RESET << "\n";
+            return 1;
+        }
+    }
 
-    const std::vector<Target> retaliationTargets = {
-        {"Pyongyang", {127.5, 39.0, 0.0}},
-        {"Moscow", {37.6, 55.7, 0.0}},
-        {"Beijing", {116.4, 39.9, 0.0}}};
+    // Clients may connect any time; they are answered while the live view runs
+    CommandChannel channel;
+    if (!options.controlPath.empty())
+    {
+        try
+        {
+            channel.listen(options.controlPath);
+        }
+        catch (const std::exception &error)
+        {
+            std::cout << RED << "Error: " << error.what() << RESET << "\n";
+            return 1;
+        }
+    }
 
-    initializeSystem(controller, enemyMissiles, usTargets);
-    DetectionSystem radar(enemyMissiles, usTargets);
+    std::vector<Target> retaliationTargets = {
+        {1, "Pyongyang", {39.0, 127.5, 0.0}, {}},
+        {2, "Moscow", {55.7, 37.6, 0.0}, {}},
+        {3, "Beijing", {39.9, 116.4, 0.0}, {}}};
+    for (Target &target : retaliationTargets)
+    {
+        target.position = scenario.frame.fromGeodetic(target.location);
+    }
 
     // Main application loop
     bool running = true;
@@ -513,15 +1466,20 @@ int main()
             break;
 
         case LIVE_VIEW:
-            runLiveView(controller, enemyMissiles, usTargets, radar);
+            runLiveView(sim, channel, retaliationTargets);
+            break;
+
+        case PROFILE:
+            showTickProfile(sim.getProfiler());
             break;
 
         case EXIT:
             running = false;
+            dumpTickProfile(options, sim.getProfiler());
             std::cout << BOLD << GREEN << "System shutdown complete." << RESET << std::endl;
             break;
         }
     }
 
     return 0;
-}
\ No newline at end of file
+}
@@ -1,16 +1,25 @@
 #include "missile.h"
-#include <thread> // Required for std::this_thread::sleep_for
-#include <chrono> // Required for std::chrono::milliseconds
-#include <cmath>  // Required for std::sqrt
 #include "position.h"
+#include <type_traits>
+
+// Inventories and in-flight lists are copied every pipelined tick; with the
+// name in static storage that is a plain memory copy
+static_assert(std::is_trivially_copyable<Missile>::value, "Missile must stay trivially copyable");
+
 // This is the full definition of the constructor
-Missile::Missile(int id, int damage, std::string missileName, double missileSpeed, Position startPosition)
+Missile::Missile(int id, int damage, std::string_view missileName, double missileSpeed, Position startPosition)
     : id(id),
       damageStrength(damage),
-      name(missileName),
+      kind(classifyInterceptor(missileName, damage, missileSpeed)),
+      name(interceptorName(kind, missileName)),
       speed(missileSpeed),
       currentPosition(startPosition),
-      isLaunched(false)
+      flightState(FlightState::Ready),
+      launchPosition(startPosition),
+      flightTarget(startPosition),
+      flightStep(0),
+      flightSteps(FLIGHT_STEPS),
+      targetEnemyId(-1)
 {
     // The body of the constructor is here.
     // All initialization is done in the initializer list
@@ -37,7 +46,7 @@ int Missile::getId() const
     return id;
 }
 
-std::string Missile::getName() const
+std::string_view Missile::getName() const
 {
     return name;
 }
@@ -52,56 +61,99 @@ Position Missile::getCurrentPosition() const
     return currentPosition;
 }
 
-void Missile::triggerLaunch(const Position &target)
+bool Missile::hasHitTarget() const
 {
-    if (isLaunched)
-    {
-        std::cout << "\033[31mMissile " << getName() << " (ID #" << getId() << ") is already launched!\033[0m" << std::endl;
-        return;
-    }
+    return flightState == FlightState::Arrived;
+}
+
+bool Missile::isInFlight() const
+{
+    return flightState == FlightState::InFlight;
+}
+
+int Missile::getTargetEnemyId() const
+{
+    return targetEnemyId;
+}
+
+int Missile::getFlightStep() const
+{
+    return flightStep;
+}
+
+int Missile::getFlightSteps() const
+{
+    return flightSteps;
+}
+
+int Missile::getDamage() const
+{
+    return damageStrength;
+}
 
-    isLaunched = true;
-    std::cout << "\033[36m-- Launch sequence initiated for " << getName() << " --\033[0m" << std::endl;
+const Position &Missile::getLaunchPosition() const
+{
+    return launchPosition;
+}
 
-    double maxAltitude = 500.0;
-    Position initialPosition = currentPosition;
+const Position &Missile::getFlightTarget() const
+{
+    return flightTarget;
+}
 
-    int steps = 20;
+double Missile::getFlightProgress() const
+{
+    return static_cast<double>(flightStep) / flightSteps;
+}
 
-    // Calculate total distance for a more meaningful progress bar
-    double dxTotal = target.x - initialPosition.x;
-    double dyTotal = target.y - initialPosition.y;
-    double dzTotal = target.z - initialPosition.z;
-    double totalDistance = std::sqrt(dxTotal * dxTotal + dyTotal * dyTotal + dzTotal * dzTotal);
+bool Missile::launch(const Position &target, int enemyId, int steps)
+{
+    if (flightState != FlightState::Ready)
+    {
+        return false;
+    }
 
-    for (int i = 0; i <= steps; ++i)
+    flightState = FlightState::InFlight;
+    launchPosition = currentPosition;
+    flightTarget = target;
+    flightStep = 0;
+    flightSteps = steps > 0 ? steps : 1;
+    targetEnemyId = enemyId;
+    return true;
+}
+
+bool Missile::advanceFlight(int steps)
+{
+    if (flightState != FlightState::InFlight)
     {
-        double t = static_cast<double>(i) / steps;
-
-        currentPosition.x = initialPosition.x + t * dxTotal;
-        currentPosition.y = initialPosition.y + t * dyTotal;
-        currentPosition.z = initialPosition.z + (t * (1.0 - t)) * maxAltitude * 4;
-
-        // Use a progress indicator and colored output for the path
-        double currentDistance = std::sqrt(
-            std::pow(currentPosition.x - initialPosition.x, 2) +
-            std::pow(currentPosition.y - initialPosition.y, 2) +
-            std::pow(currentPosition.z - initialPosition.z, 2));
-
-        std::cout << "\r\033[33m[ \033[0m"
-                  << std::string(i, '#') << std::string(steps - i, ' ')
-                  << "\033[33m ] " << static_cast<int>(t * 100) << "% "
-                  << "pos: (" << static_cast<int>(currentPosition.x) << ", "
-                  << static_cast<int>(currentPosition.y) << ", " << static_cast<int>(currentPosition.z) << ")\033[0m"
-                  << std::flush;
-
-        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        return false;
     }
 
-    // Ensure final output is on a new line
-    std::cout << std::endl;
+    flightStep += steps;
+    if (flightStep >= flightSteps)
+    {
+        // Final position is exactly the target
+        flightStep = flightSteps;
+        currentPosition = flightTarget;
+        flightState = FlightState::Arrived;
+        return true;
+    }
 
-    // Final position message
-    currentPosition = target;
-    std::cout << "\033[1;32m" << getName() << " (ID #" << getId() << ") has reached its target!\033[0m" << std::endl;
-}
\ No newline at end of file
+    double t = getFlightProgress();
+    currentPosition.x = launchPosition.x + t * (flightTarget.x - launchPosition.x);
+    currentPosition.y = launchPosition.y + t * (flightTarget.y - launchPosition.y);
+    currentPosition.z = launchPosition.z + (t * (1.0 - t)) * FLIGHT_APEX * 4;
+    return false;
+}
+
+void Missile::printFlightProgress() const
+{
+    // Use a progress indicator and colored output for the path
+    int done = static_cast<int>(getFlightProgress() * FLIGHT_STEPS);
+    std::cout << "\033[33m[ \033[0m"
+              << std::string(done, '#') << std::string(FLIGHT_STEPS - done, ' ')
+              << "\033[33m ] " << static_cast<int>(getFlightProgress() * 100) << "% "
+              << getName() << " #" << getId()
+              << " pos: (" << static_cast<int>(currentPosition.x) << ", "
+              << static_cast<int>(currentPosition.y) << ", " << static_cast<int>(currentPosition.z) << ")\033[0m";
+}
@@ -1,6 +1,11 @@
 #include "missile_controller.h"
 #include <iostream>
 #include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <tuple>
 
 #define RESET "\033[0m"
 #define BOLD "\033[1m"
@@ -10,15 +15,63 @@
 #define RED "\033[31m"
 #define MAGENTA "\033[35m"
 
+namespace
+{
+    // Where a constant-velocity track will be after `ticks`
+    Position leadPoint(const ThreatReport &threat, double ticks)
+    {
+        return {threat.enemyPosition.x + threat.enemyVelocity.x * ticks,
+                threat.enemyPosition.y + threat.enemyVelocity.y * ticks,
+                threat.enemyPosition.z + threat.enemyVelocity.z * ticks};
+    }
+
+    // Flights advance in whole ticks, so an interceptor arrives on the first tick at or past its time to go
+    int flightStepsFor(double timeToGo)
+    {
+        return std::max(1, static_cast<int>(std::ceil(timeToGo)));
+    }
+}
+
 // Existing methods (keeping your current implementations)
-void MissileController::addMissile(const Missile &missile)
+MissileController::MissileHandle MissileController::addMissile(const Missile &missile)
 {
-    missiles.push_back(missile);
+    int id = missile.getId();
+    if (id < 0)
+    {
+        throw std::invalid_argument("MissileController: missile IDs must be non-negative");
+    }
+    if (!getMissileHandle(id).isNull())
+    {
+        throw std::invalid_argument("MissileController: duplicate missile ID " + std::to_string(id));
+    }
+
+    if (static_cast<size_t>(id) >= handleById.size())
+    {
+        handleById.resize(static_cast<size_t>(id) + 1);
+        classSlotById.resize(static_cast<size_t>(id) + 1);
+    }
+    MissileHandle handle = missiles.insert(missile);
+    handleById[id] = handle;
+    std::vector<int> &sameClass = readyByClass[static_cast<size_t>(missile.getClass())];
+    classSlotById[id] = static_cast<uint32_t>(sameClass.size());
+    sameClass.push_back(id);
+
+    // Keep the flight buffers big enough for the whole magazine, so launches
+    // and arrivals during the simulation never reallocate
+    size_t needed = missiles.size() + inFlight.size();
+    if (inFlight.capacity() < needed)
+    {
+        size_t capacity = std::max(needed, inFlight.capacity() * 2);
+        inFlight.reserve(capacity);
+        arrivals.reserve(capacity);
+        engagedEnemyIds.reserve(capacity);
+    }
+    return handle;
 }
 
 void MissileController::moveAllMissiles(double dx, double dy, double dz)
 {
-    for (auto &missile : missiles)
+    for (auto &missile : missiles.data())
     {
         missile.move(dx, dy, dz);
     }
@@ -27,75 +80,205 @@ void MissileController::moveAllMissiles(double dx, double dy, double dz)
 void MissileController::printAllStatuses() const
 {
     std::cout << "\n";
-    for (const auto &missile : missiles)
+    for (const auto &missile : missiles.data())
     {
         missile.printStatus();
     }
 }
 
-void MissileController::launchMissile(Missile &missile, const Position &targetCity)
+void MissileController::launchMissile(Missile &missile, const Position &targetCity, int targetEnemyId, int flightSteps)
 {
-    std::cout << "\n";
     int missileId = missile.getId();
-    std::string missileName = missile.getName();
+    std::string_view missileName = missile.getName();
+
+    if (!missile.launch(targetCity, targetEnemyId, flightSteps))
+    {
+        if (verbose)
+        {
+            std::cout << "\033[31mMissile " << missileName << " (ID #" << missileId << ") is already launched!\033[0m" << std::endl;
+        }
+        return;
+    }
 
+    // The missile leaves the inventory and flies on from the in-flight list
+    inFlight.push_back(missile);
+    if (targetEnemyId >= 0)
+    {
+        auto slot = std::lower_bound(engagedEnemyIds.begin(), engagedEnemyIds.end(), targetEnemyId);
+        if (slot == engagedEnemyIds.end() || *slot != targetEnemyId)
+        {
+            engagedEnemyIds.insert(slot, targetEnemyId);
+        }
+    }
+
+    if (!removeMissileById(missileId) && verbose)
+    {
+        std::cout << "\n\033[1;31mError: Failed to remove " << missileName << " (ID: #" << missileId << ").\033[0m" << std::endl;
+    }
+
+    if (!verbose)
+    {
+        return;
+    }
+
+    // `missile` was the inventory slot, now holding whatever was swapped into it;
+    // report from the copy in flight
+    const Missile &launched = inFlight.back();
+    const Position &from = launched.getCurrentPosition();
+    std::cout << "\n";
     std::cout << "\033[1;33m-- Launching " << missileName << " Missile --\033[0m" << std::endl;
-    std::cout << "\033[36m  - Speed: " << missile.getSpeed() << " m/s" << std::endl;
-    std::cout << "  - From: (" << missile.getCurrentPosition().x << ", "
-              << missile.getCurrentPosition().y << ", " << missile.getCurrentPosition().z << ")" << std::endl;
+    std::cout << "\033[36m  - Speed: " << launched.getSpeed() << " m/s" << std::endl;
+    std::cout << "  - From: (" << from.x << ", "
+              << from.y << ", " << from.z << ")" << std::endl;
     std::cout << "  - To:   (" << targetCity.x << ", "
               << targetCity.y << ", " << targetCity.z << ")" << std::endl;
     std::cout << "\033[0m------------------------------------------" << std::endl;
+    std::cout << "\033[36m-- Launch sequence initiated for " << missileName << " --\033[0m" << std::endl;
+}
 
-    missile.triggerLaunch(targetCity);
+const std::vector<Missile> &MissileController::updateFlights(int steps)
+{
+    arrivals.clear();
 
-    if (removeMissileById(missileId))
+    for (size_t i = 0; i < inFlight.size();)
     {
-        // Missile removed successfully
-    }
-    else
-    {
-        std::cout << "\n\033[1;31mError: Failed to remove " << missileName << " (ID: #" << missileId << ").\033[0m" << std::endl;
+        if (inFlight[i].advanceFlight(steps))
+        {
+            auto engaged = std::lower_bound(engagedEnemyIds.begin(), engagedEnemyIds.end(), inFlight[i].getTargetEnemyId());
+            if (engaged != engagedEnemyIds.end() && *engaged == inFlight[i].getTargetEnemyId())
+            {
+                engagedEnemyIds.erase(engaged);
+            }
+            arrivals.push_back(inFlight[i]);
+
+            // Order of the in-flight list doesn't matter, swap-and-pop
+            inFlight[i] = inFlight.back();
+            inFlight.pop_back();
+        }
+        else
+        {
+            ++i;
+        }
     }
+    return arrivals;
 }
 
-bool MissileController::removeMissileById(int id)
+const std::vector<Missile> &MissileController::getInFlightMissiles() const
+{
+    return inFlight;
+}
+
+size_t MissileController::getInFlightCount() const
+{
+    return inFlight.size();
+}
+
+bool MissileController::isEnemyEngaged(int enemyId) const
+{
+    return std::binary_search(engagedEnemyIds.begin(), engagedEnemyIds.end(), enemyId);
+}
+
+void MissileController::restoreFlights(const std::vector<Missile> &flights)
 {
-    for (auto it = missiles.begin(); it != missiles.end(); ++it)
+    inFlight.assign(flights.begin(), flights.end());
+    engagedEnemyIds.clear();
+    for (const auto &missile : inFlight)
     {
-        if (it->getId() == id)
+        if (missile.getTargetEnemyId() >= 0)
         {
-            missiles.erase(it);
-            return true;
+            engagedEnemyIds.push_back(missile.getTargetEnemyId());
         }
     }
-    return false;
+    std::sort(engagedEnemyIds.begin(), engagedEnemyIds.end());
+    engagedEnemyIds.erase(std::unique(engagedEnemyIds.begin(), engagedEnemyIds.end()), engagedEnemyIds.end());
+}
+
+void MissileController::printFlightStatuses() const
+{
+    for (const auto &missile : inFlight)
+    {
+        missile.printFlightProgress();
+        std::cout << "\n";
+    }
+}
+
+bool MissileController::removeMissileById(int id)
+{
+    return removeMissile(getMissileHandle(id));
 }
 
 Missile *MissileController::getMissileById(int id)
 {
-    for (Missile &missile : missiles)
+    return missiles.get(getMissileHandle(id));
+}
+
+Missile *MissileController::getMissile(MissileHandle handle)
+{
+    return missiles.get(handle);
+}
+
+MissileController::MissileHandle MissileController::getMissileHandle(int id) const
+{
+    if (id < 0 || static_cast<size_t>(id) >= handleById.size())
     {
-        if (missile.getId() == id)
-        {
-            return &missile;
-        }
+        return MissileHandle();
     }
-    return nullptr;
+    return handleById[id];
+}
+
+bool MissileController::removeMissile(MissileHandle handle)
+{
+    const Missile *missile = missiles.get(handle);
+    if (!missile)
+    {
+        return false;
+    }
+
+    // Swap-and-pop out of the class list, repointing the ID that moved
+    int id = missile->getId();
+    std::vector<int> &sameClass = readyByClass[static_cast<size_t>(missile->getClass())];
+    uint32_t slot = classSlotById[id];
+    sameClass[slot] = sameClass.back();
+    classSlotById[sameClass[slot]] = slot;
+    sameClass.pop_back();
+
+    handleById[id] = MissileHandle();
+    return missiles.erase(handle);
+}
+
+size_t MissileController::getReadyCount(InterceptorClass kind) const
+{
+    return readyByClass[static_cast<size_t>(kind)].size();
+}
+
+Missile *MissileController::getReadyMissile(InterceptorClass kind)
+{
+    const std::vector<int> &sameClass = readyByClass[static_cast<size_t>(kind)];
+    return sameClass.empty() ? nullptr : missiles.get(handleById[sameClass.back()]);
 }
 
 int MissileController::interceptThreat(const ThreatReport& threat) {
     if (missiles.empty()) {
-        std::cout << RED << "No available missiles to launch an intercept!" << RESET << std::endl;
+        if (verbose) {
+            std::cout << RED << "No available missiles to launch an intercept!" << RESET << std::endl;
+        }
         return -1;
     }
 
-    Missile& interceptorMissile = missiles.front();
-    int missileId = interceptorMissile.getId();
-    std::string missileName = interceptorMissile.getName();
-    
-    std::cout << GREEN << "Intercept started" << RESET << std::endl;
-    launchMissile(interceptorMissile, threat.enemyPosition);
+    beginScratch();
+    double timeToGo;
+    Missile* interceptorMissile = selectBestInterceptor(threat, timeToGo);
+    if (!interceptorMissile) {
+        if (verbose) {
+            std::cout << RED << "No available missile can reach threat #" << threat.detectionId << RESET << std::endl;
+        }
+        return -1;
+    }
+
+    if (verbose) {
+        std::cout << GREEN << "Intercept started" << RESET << std::endl;
+    }
+    launchMissile(*interceptorMissile, leadPoint(threat, timeToGo), threat.enemyId, flightStepsFor(timeToGo));
 
     return threat.enemyId;
 }
@@ -104,7 +287,9 @@ int MissileController::interceptThreat(const ThreatReport& threat) {
 
 void MissileController::setAutoIntercept(bool enabled) {
     autoInterceptEnabled = enabled;
-    std::cout << CYAN << "Auto-intercept " << (enabled ? "ENABLED" : "DISABLED") << RESET << std::endl;
+    if (verbose) {
+        std::cout << CYAN << "Auto-intercept " << (enabled ? "ENABLED" : "DISABLED") << RESET << std::endl;
+    }
 }
 
 bool MissileController::isAutoInterceptEnabled() const {
@@ -113,36 +298,63 @@ bool MissileController::isAutoInterceptEnabled() const {
 
 void MissileController::setAutoInterceptThreshold(double threshold) {
     autoInterceptThreshold = threshold;
-    std::cout << CYAN << "Auto-intercept threshold set to " << threshold << " km" << RESET << std::endl;
+    if (verbose) {
+        std::cout << CYAN << "Auto-intercept threshold set to " << threshold << " km" << RESET << std::endl;
+    }
+}
+
+double MissileController::getAutoInterceptThreshold() const {
+    return autoInterceptThreshold;
+}
+
+bool MissileController::canAutoIntercept() const {
+    return autoInterceptEnabled && hasAvailableMissiles() && usedAutoInterceptMissiles < maxAutoInterceptMissiles;
 }
 
 void MissileController::setMaxAutoInterceptMissiles(int maxMissiles) {
     maxAutoInterceptMissiles = maxMissiles;
-    std::cout << CYAN << "Max auto-intercept missiles set to " << maxMissiles << RESET << std::endl;
+    if (verbose) {
+        std::cout << CYAN << "Max auto-intercept missiles set to " << maxMissiles << RESET << std::endl;
+    }
 }
 
 // FIXED: Updated autoInterceptThreats method
-std::vector<int> MissileController::autoInterceptThreats(const std::vector<ThreatReport>& threats) {
-    std::vector<int> interceptedEnemyIds;  // Track which enemies were actually intercepted
+const std::pmr::vector<int>& MissileController::autoInterceptThreats(std::vector<ThreatReport>& threats) {
+    std::pmr::vector<int>& interceptedEnemyIds = beginScratch().engagedThisCall;  // Track which enemies we launched against
+    interceptedEnemyIds.reserve(missiles.size());
     
     if (!autoInterceptEnabled || threats.empty()) {
         return interceptedEnemyIds;
     }
 
     if (!hasAvailableMissiles()) {
-        std::cout << YELLOW << "Auto-intercept: No missiles available" << RESET << std::endl;
+        if (verbose) {
+            std::cout << YELLOW << "Auto-intercept: No missiles available" << RESET << std::endl;
+        }
         return interceptedEnemyIds;
     }
 
     if (usedAutoInterceptMissiles >= maxAutoInterceptMissiles) {
-        std::cout << YELLOW << "Auto-intercept: Maximum auto-intercept missiles used (" 
-                  << maxAutoInterceptMissiles << ")" << RESET << std::endl;
+        if (verbose) {
+            std::cout << YELLOW << "Auto-intercept: Maximum auto-intercept missiles used (" 
+                      << maxAutoInterceptMissiles << ")" << RESET << std::endl;
+        }
         return interceptedEnemyIds;
     }
 
-    std::vector<ThreatReport> prioritizedThreats = prioritizeThreats(threats);
+    prioritizeThreats(threats);
 
-    for (const auto& threat : prioritizedThreats) {
+    if (assignmentMode == AssignmentMode::Global) {
+        interceptGlobal(threats);
+    } else {
+        interceptGreedy(threats);
+    }
+
+    return interceptedEnemyIds;
+}
+
+void MissileController::interceptGreedy(const std::vector<ThreatReport>& threats) {
+    for (const auto& threat : threats) {
         if (usedAutoInterceptMissiles >= maxAutoInterceptMissiles) {
             break;
         }
@@ -152,37 +364,252 @@ std::vector<int> MissileController::autoInterceptThreats(const std::vector<Threa
         }
 
         if (shouldInterceptThreat(threat)) {
-            Missile* interceptor = selectBestInterceptor(threat);
+            double timeToGo;
+            Missile* interceptor = selectBestInterceptor(threat, timeToGo);
             
             if (interceptor) {
-                std::cout << BOLD << MAGENTA << "🤖 AUTO-INTERCEPT ENGAGED: " 
-                          << "Launching " << interceptor->getName() 
-                          << " against threat #" << threat.detectionId 
-                          << " (Enemy ID: " << threat.enemyId << ")" << RESET << std::endl;
-                
-                // Launch the interceptor
-                launchMissile(*interceptor, threat.enemyPosition);
-                usedAutoInterceptMissiles++;
-                
-                // Add this enemy ID to our intercepted list
-                interceptedEnemyIds.push_back(threat.enemyId);
+                launchAutoInterceptor(*interceptor, threat, timeToGo);
                 
                 // IMPORTANT: Only intercept ONE threat per call for realistic simulation
                 break;  // Exit after first intercept
             }
         }
     }
+}
 
-    return interceptedEnemyIds;
+void MissileController::interceptGlobal(const std::vector<ThreatReport>& threats) {
+    // The most urgent eligible threats, as many as there are interceptors left to spend
+    size_t pairBudget = std::min(static_cast<size_t>(maxAutoInterceptMissiles - usedAutoInterceptMissiles),
+                                 missiles.size());
+    pairBudget = std::min(pairBudget, maxAssignmentPairs);
+
+    WorkingSet& work = *scratch->working;
+    work.candidateThreats.reserve(std::min(pairBudget, threats.size()));
+    size_t nextThreat = 0;
+    auto fillCandidates = [&]() {
+        for (; nextThreat < threats.size() && work.candidateThreats.size() < pairBudget; ++nextThreat) {
+            if (shouldInterceptThreat(threats[nextThreat])) {
+                work.candidateThreats.push_back(nextThreat);
+            }
+        }
+    };
+    fillCandidates();
+    if (work.candidateThreats.empty()) {
+        return;
+    }
+    size_t rows = work.candidateThreats.size();
+
+    // Interceptors on the same pad with the same speed cost the same against
+    // every threat, so each group only needs as many columns as there are threats
+    const std::vector<Missile>& inventory = missiles.data();
+    work.inventoryColumns.reserve(inventory.size());
+    for (size_t i = 0; i < inventory.size(); ++i) {
+        work.inventoryColumns.push_back({i, inventory[i].getCurrentPosition(), inventory[i].getSpeed()});
+    }
+    auto groupKey = [](const InterceptorColumn& column) {
+        return std::make_tuple(column.position.x, column.position.y, column.position.z, column.speed);
+    };
+    std::sort(work.inventoryColumns.begin(), work.inventoryColumns.end(),
+              [&](const InterceptorColumn& a, const InterceptorColumn& b) {
+                  return groupKey(a) < groupKey(b);
+              });
+
+    work.assignmentColumns.reserve(inventory.size());
+    size_t groupSize = 0;
+    for (size_t i = 0; i < work.inventoryColumns.size(); ++i) {
+        groupSize = (i > 0 && groupKey(work.inventoryColumns[i]) == groupKey(work.inventoryColumns[i - 1])) ? groupSize + 1 : 1;
+        if (groupSize <= rows) {
+            work.assignmentColumns.push_back(work.inventoryColumns[i]);
+        }
+    }
+
+    // Heterogeneous magazines can still be wide; keep the fastest interceptors.
+    // Ties go to inventory order, which keeps the pick deterministic without
+    // std::stable_sort (its merge buffer comes from the heap, not the arena)
+    size_t maxColumns = std::max<size_t>(rows * 8, 64);
+    if (work.assignmentColumns.size() > maxColumns) {
+        std::sort(work.assignmentColumns.begin(), work.assignmentColumns.end(),
+                  [](const InterceptorColumn& a, const InterceptorColumn& b) {
+                      if (a.speed != b.speed) {
+                          return a.speed > b.speed;
+                      }
+                      return a.missileIndex < b.missileIndex;
+                  });
+        work.assignmentColumns.resize(maxColumns);
+    }
+    size_t cols = work.assignmentColumns.size();
+
+    // Cost: time to go on a lead-pursuit course, each batch of rows solved at once
+    work.interceptSolver.reserveInterceptors(cols);
+    for (const auto& column : work.assignmentColumns) {
+        work.interceptSolver.addInterceptor(column.position, column.speed);
+    }
+    work.rowPositions.reserve(rows);
+    work.rowVelocities.reserve(rows);
+    work.rowHorizons.reserve(rows);
+    work.timesToGo.reserve(rows * cols);
+
+    // Threats nobody can catch drop out and the next eligible ones take their
+    // rows, the way greedy walks on past them: late in a raid the most urgent
+    // threats are the ones about to hit, and would otherwise hide the rest
+    double longest = 0.0;
+    size_t kept = 0;
+    while (kept < work.candidateThreats.size()) {
+        size_t batch = work.candidateThreats.size() - kept;
+        work.rowPositions.clear();
+        work.rowVelocities.clear();
+        work.rowHorizons.clear();
+        for (size_t row = kept; row < work.candidateThreats.size(); ++row) {
+            const ThreatReport& threat = threats[work.candidateThreats[row]];
+            work.rowPositions.push_back(threat.enemyPosition);
+            work.rowVelocities.push_back(threat.enemyVelocity);
+            work.rowHorizons.push_back(threat.timeToImpact);
+        }
+        work.timesToGo.resize((kept + batch) * cols);
+        work.interceptSolver.solve(work.rowPositions.data(), work.rowVelocities.data(), work.rowHorizons.data(),
+                                   batch, work.timesToGo.data() + kept * cols);
+
+        size_t solved = kept;
+        for (size_t row = solved; row < solved + batch; ++row) {
+            const double* rowTimes = work.timesToGo.data() + row * cols;
+            bool reachable = false;
+            for (size_t col = 0; col < cols; ++col) {
+                if (std::isfinite(rowTimes[col])) {
+                    reachable = true;
+                    longest = std::max(longest, rowTimes[col]);
+                }
+            }
+            if (reachable) {
+                std::copy(rowTimes, rowTimes + cols, work.timesToGo.begin() + kept * cols);
+                work.candidateThreats[kept++] = work.candidateThreats[row];
+            }
+        }
+        work.candidateThreats.resize(kept);
+        work.timesToGo.resize(kept * cols);
+        fillCandidates();
+    }
+    if (kept == 0) {
+        return;
+    }
+    rows = kept;
+
+    // The rest cost their time to go, with unreachable pairs priced above any
+    // reachable one so they are never picked
+
+    double unreachableCost = 2.0 * longest + 1.0;
+    work.assignmentCosts.resize(rows * cols);
+    for (size_t i = 0; i < rows * cols; ++i) {
+        work.assignmentCosts[i] = std::isfinite(work.timesToGo[i]) ? work.timesToGo[i] : unreachableCost;
+    }
+
+    work.assigner.solve(work.assignmentCosts.data(), rows, cols, assignmentBudget);
+
+    if (verbose && work.assigner.timedOut()) {
+        std::cout << YELLOW << "Auto-intercept: assignment budget exceeded, remaining pairs matched greedily"
+                  << RESET << std::endl;
+    }
+
+    // Launching reshuffles the inventory, so resolve every pair to a stable handle first
+    const auto& assignments = work.assigner.getAssignments();
+    work.pendingLaunches.reserve(assignments.size());
+    for (size_t i = 0; i < assignments.size(); ++i) {
+        if (std::isfinite(work.timesToGo[assignments[i].row * cols + assignments[i].col])) {
+            work.pendingLaunches.emplace_back(missiles.handleAt(work.assignmentColumns[assignments[i].col].missileIndex), i);
+        }
+    }
+
+    for (const auto& launch : work.pendingLaunches) {
+        Missile* interceptor = missiles.get(launch.first);
+        if (interceptor) {
+            const auto& assignment = assignments[launch.second];
+            launchAutoInterceptor(*interceptor, threats[work.candidateThreats[assignment.row]],
+                                  work.timesToGo[assignment.row * cols + assignment.col]);
+        }
+    }
+}
+
+void MissileController::launchAutoInterceptor(Missile& interceptor, const ThreatReport& threat, double timeToGo) {
+    if (verbose) {
+        std::cout << BOLD << MAGENTA << "🤖 AUTO-INTERCEPT ENGAGED: " 
+                  << "Launching " << interceptor.getName() 
+                  << " against threat #" << threat.detectionId 
+                  << " (Enemy ID: " << threat.enemyId << ")" << RESET << std::endl;
+    }
+
+    // Aim where the track will be, arriving after the time to go; the enemy is destroyed on arrival
+    launchMissile(interceptor, leadPoint(threat, timeToGo), threat.enemyId, flightStepsFor(timeToGo));
+    usedAutoInterceptMissiles++;
+
+    // Add this enemy ID to our intercepted list
+    scratch->working->engagedThisCall.push_back(threat.enemyId);
+}
+
+void MissileController::setAssignmentMode(AssignmentMode mode) {
+    assignmentMode = mode;
+}
+
+MissileController::AssignmentMode MissileController::getAssignmentMode() const {
+    return assignmentMode;
+}
+
+void MissileController::setAssignmentLimits(size_t maxPairs, std::chrono::microseconds budget) {
+    maxAssignmentPairs = maxPairs;
+    assignmentBudget = budget;
+}
+
+size_t MissileController::getMaxAssignmentPairs() const {
+    return maxAssignmentPairs;
+}
+
+const WeaponTargetAssigner& MissileController::getAssigner() const {
+    return scratch->working->assigner;
+}
+
+const TickArena& MissileController::getScratchArena() const {
+    return scratch->arena;
 }
+
+void MissileController::reserveScratch(size_t bytes) {
+    scratch->working.reset();
+    scratch->arena.reserve(bytes);
+    scratch->working.emplace(&scratch->arena);
+}
+
+MissileController::WorkingSet::WorkingSet(std::pmr::memory_resource* resource)
+    : engagedThisCall(resource), candidateThreats(resource), inventoryColumns(resource),
+      assignmentColumns(resource), assignmentCosts(resource), interceptSolver(resource),
+      rowPositions(resource), rowVelocities(resource), rowHorizons(resource), timesToGo(resource),
+      pendingLaunches(resource), assigner(resource) {
+}
+
+MissileController::WorkingSet& MissileController::beginScratch() {
+    // The working set goes first: its containers still point into the arena
+    scratch->working.reset();
+    scratch->arena.reset();
+    return scratch->working.emplace(&scratch->arena);
+}
+
 void MissileController::printAutoInterceptStatus() const {
     std::cout << CYAN << "Auto-Intercept Status:" << RESET << std::endl;
     std::cout << "  Enabled: " << (autoInterceptEnabled ? GREEN "YES" : RED "NO") << RESET << std::endl;
     std::cout << "  Threshold: " << autoInterceptThreshold << " km" << std::endl;
+    std::cout << "  Assignment: " << (assignmentMode == AssignmentMode::Global ? "global (all threats per tick)" : "greedy (one threat per tick)") << std::endl;
     std::cout << "  Missiles Used: " << usedAutoInterceptMissiles << "/" << maxAutoInterceptMissiles << std::endl;
     std::cout << "  Available Missiles: " << getAvailableMissileCount() << std::endl;
 }
 
+void MissileController::setVerbose(bool enabled) {
+    verbose = enabled;
+}
+
+bool MissileController::isVerbose() const {
+    return verbose;
+}
+
+const std::vector<Missile>& MissileController::getMissiles() const {
+    return missiles.data();
+}
+
 int MissileController::getAvailableMissileCount() const {
     return missiles.size();
 }
@@ -193,37 +620,43 @@ bool MissileController::hasAvailableMissiles() const {
 
 // PRIVATE HELPER METHODS
 
-std::vector<ThreatReport> MissileController::prioritizeThreats(const std::vector<ThreatReport>& threats) const {
-    std::vector<ThreatReport> prioritized = threats;
-    
-    // Sort by distance to target (closest threats first)
-    std::sort(prioritized.begin(), prioritized.end(), 
+void MissileController::prioritizeThreats(std::vector<ThreatReport>& threats) const {
+    // Soonest impact first: the estimated velocity decides, so a fast track
+    // further out can outrank a slow one close in. Distance breaks ties.
+    std::sort(threats.begin(), threats.end(), 
               [](const ThreatReport& a, const ThreatReport& b) {
+                  if (a.timeToImpact != b.timeToImpact) {
+                      return a.timeToImpact < b.timeToImpact;
+                  }
                   return a.distanceToTarget < b.distanceToTarget;
               });
-    
-    return prioritized;
 }
 
 bool MissileController::shouldInterceptThreat(const ThreatReport& threat) const {
-    // Only intercept if threat is within our threshold distance
-    return threat.distanceToTarget <= autoInterceptThreshold;
+    // Only intercept if threat is within our threshold distance and nothing is already on its way
+    return threat.distanceToTarget <= autoInterceptThreshold && !isEnemyEngaged(threat.enemyId);
 }
 
-Missile* MissileController::selectBestInterceptor(const ThreatReport& threat) {
+Missile* MissileController::selectBestInterceptor(const ThreatReport& threat, double& timeToGo) {
     if (missiles.empty()) {
         return nullptr;
     }
 
-    // For now, select the fastest available missile
-    // You could enhance this with more sophisticated logic
-    Missile* bestMissile = &missiles[0];
-    
-    for (auto& missile : missiles) {
-        if (missile.getSpeed() > bestMissile->getSpeed()) {
-            bestMissile = &missile;
-        }
+    // One solver row: this threat against the whole inventory
+    WorkingSet& work = *scratch->working;
+    work.interceptSolver.clearInterceptors();
+    work.interceptSolver.reserveInterceptors(missiles.size());
+    for (const auto& missile : missiles.data()) {
+        work.interceptSolver.addInterceptor(missile.getCurrentPosition(), missile.getSpeed());
     }
-    
-    return bestMissile;
-}
\ No newline at end of file
+    work.timesToGo.resize(missiles.size());
+    work.interceptSolver.solve(&threat.enemyPosition, &threat.enemyVelocity, &threat.timeToImpact, 1,
+                               work.timesToGo.data());
+
+    auto best = std::min_element(work.timesToGo.begin(), work.timesToGo.end());
+    if (!std::isfinite(*best)) {
+        return nullptr;
+    }
+    timeToGo = *best;
+    return &missiles.data()[best - work.timesToGo.begin()];
+}
@@ -0,0 +1,264 @@
+#include "monte_carlo.h"
+#include "scenario_file.h"
+#include "simulation.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <random>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace
+{
+    // What one replicate hands back, kept apart per replicate until the
+    // report is assembled in replicate order
+    struct ReplicateOutput
+    {
+        ReplicateResult result;
+        std::vector<uint32_t> timesToEngage;
+    };
+
+    // The stream depends on the replicate number only, never on which thread runs it
+    std::mt19937_64 replicateStream(uint64_t seed, size_t replicate)
+    {
+        uint64_t index = replicate;
+        std::seed_seq sequence{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32),
+                               static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32)};
+        return std::mt19937_64(sequence);
+    }
+
+    // Tracks of the scenario as plain missiles, binary scenario tracks included
+    std::vector<EnemyMissile> baseTracks(const Scenario &scenario)
+    {
+        std::vector<EnemyMissile> tracks(scenario.enemies);
+        if (scenario.trackFile)
+        {
+            TrackStore mapped;
+            mapped.adopt(scenario.trackFile->mapTracks());
+            tracks.reserve(tracks.size() + mapped.size());
+            for (size_t i = 0; i < mapped.size(); ++i)
+            {
+                tracks.push_back(mapped.toEnemyMissile(i));
+            }
+        }
+        return tracks;
+    }
+
+    EnemyMissile perturb(const EnemyMissile &track, const MonteCarloConfig &config, std::mt19937_64 &rng)
+    {
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        std::uniform_real_distribution<double> bearing(0.0, 2.0 * M_PI);
+        std::uniform_real_distribution<double> speedScale(1.0 - config.speedJitter, 1.0 + config.speedJitter);
+        std::uniform_int_distribution<long> delay(0, std::max(0L, config.maxLaunchDelay));
+
+        // Uniform over the disk: radius grows with the square root
+        double offset = config.launchJitter * std::sqrt(unit(rng));
+        double angle = bearing(rng);
+        Position start = track.getCurrentPosition();
+        start.x += offset * std::cos(angle);
+        start.y += offset * std::sin(angle);
+
+        double speed = std::max(0.0, track.getSpeed() * speedScale(rng));
+
+        // A late launch is the same straight flight started further back
+        const Position &target = track.getTargetPosition();
+        double dx = start.x - target.x;
+        double dy = start.y - target.y;
+        double dz = start.z - target.z;
+        double distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+        double setBack = speed * static_cast<double>(delay(rng));
+        if (distance > 0.0)
+        {
+            start.x += dx / distance * setBack;
+            start.y += dy / distance * setBack;
+            start.z += dz / distance * setBack;
+        }
+
+        return EnemyMissile(track.getId(), start, target, speed, track.getTargetId());
+    }
+
+    void runReplicate(const Scenario &scenario, const std::vector<EnemyMissile> &tracks,
+                      const MonteCarloConfig &config, size_t replicate, ReplicateOutput &output)
+    {
+        Scenario perturbed;
+        perturbed.frame = scenario.frame;
+        perturbed.pads = scenario.pads;
+        perturbed.interceptors = scenario.interceptors;
+        perturbed.targets = scenario.targets;
+        perturbed.radars = scenario.radars;
+        perturbed.radarNoise = scenario.radarNoise;
+        perturbed.enemies.reserve(tracks.size());
+        std::mt19937_64 rng = replicateStream(config.seed, replicate);
+        for (const EnemyMissile &track : tracks)
+        {
+            perturbed.enemies.push_back(perturb(track, config, rng));
+        }
+
+        Simulation sim(perturbed);
+        MissileController &controller = sim.getController();
+        controller.setVerbose(false);
+        controller.setAutoIntercept(true);
+        controller.setMaxAutoInterceptMissiles(config.maxAutoIntercept);
+        controller.setAutoInterceptThreshold(config.autoInterceptThreshold);
+        controller.setAssignmentMode(config.assignmentMode);
+        // A wall-clock budget would make the result depend on machine load
+        controller.setAssignmentLimits(controller.getMaxAssignmentPairs(), std::chrono::microseconds::max());
+
+        std::unordered_map<int, long> firstReported; // Track ID -> tick of its first threat report
+        firstReported.reserve(tracks.size());
+        for (long i = 0; i < config.ticks && !sim.getEnemies().empty(); ++i)
+        {
+            sim.tick();
+            long now = sim.getStats().ticks;
+            for (const ThreatReport &threat : sim.getThreats())
+            {
+                firstReported.emplace(threat.enemyId, now);
+            }
+            // Launched this tick: flights advance before auto-intercept runs
+            for (const Missile &missile : controller.getInFlightMissiles())
+            {
+                auto reported = firstReported.find(missile.getTargetEnemyId());
+                if (missile.getFlightStep() == 0 && reported != firstReported.end())
+                {
+                    output.timesToEngage.push_back(static_cast<uint32_t>(now - reported->second));
+                }
+            }
+        }
+
+        const SimulationStats &stats = sim.getStats();
+        output.result.leakers = stats.impacts;
+        output.result.expended = stats.interceptsLaunched;
+        output.result.destroyed = stats.enemiesDestroyed;
+        output.result.survivors = sim.getEnemies().size();
+        output.result.ticks = stats.ticks;
+    }
+}
+
+SampleSummary SampleSummary::of(std::vector<uint64_t> values)
+{
+    SampleSummary summary;
+    if (values.empty())
+    {
+        return summary;
+    }
+    std::sort(values.begin(), values.end());
+
+    // Summed in sorted order, so the result doesn't depend on who produced what first
+    double sum = 0.0;
+    for (uint64_t value : values)
+    {
+        sum += static_cast<double>(value);
+    }
+    summary.mean = sum / values.size();
+    double squares = 0.0;
+    for (uint64_t value : values)
+    {
+        double deviation = static_cast<double>(value) - summary.mean;
+        squares += deviation * deviation;
+    }
+    summary.stddev = values.size() > 1 ? std::sqrt(squares / (values.size() - 1)) : 0.0;
+
+    auto rank = [&](double quantile)
+    {
+        size_t index = static_cast<size_t>(std::ceil(quantile * values.size()));
+        return values[std::min(values.size(), std::max<size_t>(index, 1)) - 1];
+    };
+    summary.min = values.front();
+    summary.p50 = rank(0.50);
+    summary.p90 = rank(0.90);
+    summary.p99 = rank(0.99);
+    summary.max = values.back();
+    return summary;
+}
+
+SampleSummary MonteCarloReport::leakers() const
+{
+    std::vector<uint64_t> values;
+    values.reserve(replicates.size());
+    for (const ReplicateResult &replicate : replicates)
+    {
+        values.push_back(replicate.leakers);
+    }
+    return SampleSummary::of(std::move(values));
+}
+
+SampleSummary MonteCarloReport::expended() const
+{
+    std::vector<uint64_t> values;
+    values.reserve(replicates.size());
+    for (const ReplicateResult &replicate : replicates)
+    {
+        values.push_back(replicate.expended);
+    }
+    return SampleSummary::of(std::move(values));
+}
+
+double MonteCarloReport::leakProbability() const
+{
+    if (replicates.empty())
+    {
+        return 0.0;
+    }
+    size_t leaked = std::count_if(replicates.begin(), replicates.end(), [](const ReplicateResult &replicate)
+                                  { return replicate.leakers > 0; });
+    return static_cast<double>(leaked) / replicates.size();
+}
+
+void MonteCarloReport::print(std::ostream &out) const
+{
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+
+    auto row = [&](const char *label, const SampleSummary &summary)
+    {
+        out << label << std::fixed << std::setprecision(2) << summary.mean << " mean, "
+            << summary.stddev << " sd; p50 " << summary.p50 << ", p90 " << summary.p90
+            << ", p99 " << summary.p99 << ", max " << summary.max << "\n";
+    };
+    row("  Leakers:        ", leakers());
+    out << "  Leak chance:    " << std::setprecision(1) << leakProbability() * 100.0 << "% of replicates\n";
+    row("  Expended:       ", expended());
+    out << "  Time to engage: " << timeToEngage.getCount() << " engagements, " << std::setprecision(2)
+        << timeToEngage.getMean() << " ticks mean; p50 " << timeToEngage.percentile(0.50)
+        << ", p90 " << timeToEngage.percentile(0.90) << ", p99 " << timeToEngage.percentile(0.99)
+        << ", max " << timeToEngage.getMax() << "\n";
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+MonteCarloReport runMonteCarlo(const Scenario &scenario, const MonteCarloConfig &config)
+{
+    using Clock = std::chrono::steady_clock;
+
+    if (config.replicates == 0)
+    {
+        throw std::invalid_argument("Monte Carlo needs at least one replicate");
+    }
+
+    auto start = Clock::now();
+    const std::vector<EnemyMissile> tracks = baseTracks(scenario);
+
+    // One chunk per replicate; the pool hands them out dynamically, but every
+    // replicate writes only its own slot
+    std::vector<ReplicateOutput> outputs(config.replicates);
+    ThreadPool pool(std::max<size_t>(config.workers, 1));
+    pool.parallelFor(config.replicates, [&](size_t replicate)
+                     { runReplicate(scenario, tracks, config, replicate, outputs[replicate]); });
+
+    MonteCarloReport report;
+    report.config = config;
+    report.replicates.reserve(outputs.size());
+    for (const ReplicateOutput &output : outputs)
+    {
+        report.replicates.push_back(output.result);
+        for (uint32_t ticks : output.timesToEngage)
+        {
+            report.timeToEngage.record(ticks);
+        }
+    }
+    report.elapsedSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return report;
+}
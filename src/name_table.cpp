@@ -0,0 +1,25 @@
+#include "name_table.h"
+
+int NameTable::intern(const std::string &name)
+{
+    auto found = idsByName.find(name);
+    if (found != idsByName.end())
+    {
+        return found->second;
+    }
+
+    int id = static_cast<int>(names.size());
+    names.push_back(name);
+    idsByName.emplace(name, id);
+    return id;
+}
+
+const std::string &NameTable::getName(int nameId) const
+{
+    static const std::string unknown = "Unknown";
+    if (nameId < 0 || static_cast<size_t>(nameId) >= names.size())
+    {
+        return unknown;
+    }
+    return names[nameId];
+}
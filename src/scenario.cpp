@@ -0,0 +1,175 @@
+#include "scenario.h"
+#include "scenario_file.h"
+#include "interceptor_types.h"
+#include <random>
+#include <cmath>
+
+namespace
+{
+    // The demo theater: a launch pad a couple of kilometres from each city
+    const GeodeticPosition newYork = {40.7128, -74.0060, 0.0};
+    const GeodeticPosition washington = {38.9072, -77.0369, 0.0};
+    const GeodeticPosition losAngeles = {34.0522, -118.2437, 0.0};
+
+    struct DefaultPad
+    {
+        const char *name;
+        GeodeticPosition location;
+    };
+    const DefaultPad defaultPads[] = {
+        {"Pad A", {40.7060, -74.0190, 0.0}},
+        {"Pad B", {38.8900, -77.0200, 0.0}},
+        {"Pad C", {34.0400, -118.2600, 0.0}}};
+
+    // Interceptor classes (interceptor_types.h), by pad
+    struct DefaultInterceptor
+    {
+        InterceptorClass kind;
+        size_t pad;
+    };
+    const DefaultInterceptor defaultInterceptors[] = {
+        {InterceptorClass::Patriot, 0},
+        {InterceptorClass::Patriot, 2},
+        {InterceptorClass::Tomahawk, 1},
+        {InterceptorClass::Stinger, 1},
+        {InterceptorClass::Javelin, 0}};
+    const size_t DEFAULT_INTERCEPTOR_KINDS = sizeof(defaultInterceptors) / sizeof(defaultInterceptors[0]);
+
+    // Pads, targets and `interceptorCount` interceptors cycling through the defaults
+    Scenario defaultTheater(size_t interceptorCount)
+    {
+        Scenario scenario;
+        scenario.setOrigin(newYork);
+        for (const DefaultPad &pad : defaultPads)
+        {
+            scenario.addPad(pad.name, pad.location);
+        }
+        scenario.interceptors.reserve(interceptorCount);
+        for (size_t i = 0; i < interceptorCount; ++i)
+        {
+            const DefaultInterceptor &entry = defaultInterceptors[i % DEFAULT_INTERCEPTOR_KINDS];
+            const InterceptorSpec &spec = *interceptorSpec(entry.kind);
+            scenario.interceptors.push_back({spec.damage, std::string(spec.name), spec.speed,
+                                             scenario.pads[entry.pad].position});
+        }
+        scenario.addTarget(1, "New York", newYork);
+        scenario.addTarget(2, "Washington DC", washington);
+        scenario.addTarget(3, "Los Angeles", losAngeles);
+        return scenario;
+    }
+}
+
+Scenario Scenario::makeDefault()
+{
+    Scenario scenario = defaultTheater(DEFAULT_INTERCEPTOR_KINDS);
+
+    // One track a few kilometres out from each city
+    const std::vector<Target> &targets = scenario.targets;
+    const LocalFrame &frame = scenario.frame;
+    scenario.enemies.push_back(EnemyMissile(101, frame.fromGeodetic({40.7400, -73.9500, 0.0}), targets[0].position, 50.0, targets[0].id));
+    scenario.enemies.push_back(EnemyMissile(102, frame.fromGeodetic({38.9430, -76.9670, 0.0}), targets[1].position, 75.0, targets[1].id));
+    scenario.enemies.push_back(EnemyMissile(103, frame.fromGeodetic({34.0750, -118.1950, 0.0}), targets[2].position, 60.0, targets[2].id));
+    return scenario;
+}
+
+Scenario Scenario::makeSalvo(size_t trackCount, size_t interceptorCount, unsigned seed)
+{
+    Scenario scenario = defaultTheater(interceptorCount);
+    scenario.addSalvo(trackCount, seed);
+    return scenario;
+}
+
+void Scenario::setOrigin(const GeodeticPosition &origin)
+{
+    frame = LocalFrame(origin);
+}
+
+void Scenario::addPad(const std::string &name, const GeodeticPosition &location)
+{
+    pads.push_back({name, location, frame.fromGeodetic(location)});
+}
+
+void Scenario::addTarget(int id, const std::string &name, const GeodeticPosition &location)
+{
+    targets.push_back({id, name, location, frame.fromGeodetic(location)});
+}
+
+void Scenario::addSalvo(size_t trackCount, unsigned seed, int firstId)
+{
+    if (targets.empty())
+    {
+        return;
+    }
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> bearing(0.0, 2.0 * M_PI);
+    std::uniform_real_distribution<double> range(6000.0, 15000.0);
+    std::uniform_real_distribution<double> speed(40.0, 120.0);
+    std::uniform_int_distribution<size_t> pickTarget(0, targets.size() - 1);
+
+    // Each target's ground plane, once
+    std::vector<LocalFrame::Axes> axes;
+    axes.reserve(targets.size());
+    for (const Target &target : targets)
+    {
+        axes.push_back(frame.axesAt(target.location));
+    }
+
+    // Tracks spawn on a ring around their target so they enter radar range at different times
+    enemies.reserve(enemies.size() + trackCount);
+    for (size_t i = 0; i < trackCount; ++i)
+    {
+        size_t pick = pickTarget(rng);
+        const Target &target = targets[pick];
+        const LocalFrame::Axes &ground = axes[pick];
+        double angle = bearing(rng);
+        double distance = range(rng);
+        double east = distance * std::cos(angle);
+        double north = distance * std::sin(angle);
+        Position start = {target.position.x + east * ground.east.x + north * ground.north.x,
+                          target.position.y + east * ground.east.y + north * ground.north.y,
+                          target.position.z + east * ground.east.z + north * ground.north.z};
+        enemies.push_back(EnemyMissile(static_cast<int>(firstId + i), start, target.position, speed(rng), target.id));
+    }
+}
+
+void Scenario::addRadarNetwork(size_t count, double coverRadius)
+{
+    if (count == 0 || targets.empty())
+    {
+        return;
+    }
+
+    // Sunflower layout around each target: even density over the disk, no
+    // rings or gaps. Three sites' worth of area per site gives about
+    // threefold coverage.
+    const double goldenAngle = M_PI * (3.0 - std::sqrt(5.0));
+    for (size_t t = 0; t < targets.size() && t < count; ++t)
+    {
+        const Target &target = targets[t];
+        const LocalFrame::Axes ground = frame.axesAt(target.location);
+        size_t sites = count / targets.size() + (t < count % targets.size() ? 1 : 0);
+        double range = coverRadius * std::sqrt(3.0 / static_cast<double>(sites));
+        for (size_t j = 0; j < sites; ++j)
+        {
+            double radius = coverRadius * std::sqrt((j + 0.5) / static_cast<double>(sites));
+            double angle = goldenAngle * static_cast<double>(j);
+            double east = radius * std::cos(angle);
+            double north = radius * std::sin(angle);
+
+            RadarSite site;
+            site.name = "Radar " + std::to_string(radars.size() + 1);
+            site.position = {target.position.x + east * ground.east.x + north * ground.north.x,
+                             target.position.y + east * ground.east.y + north * ground.north.y,
+                             target.position.z + east * ground.east.z + north * ground.north.z};
+            site.range = range;
+            site.scanInterval = 1 + static_cast<int>(j % 3);
+            radars.push_back(site);
+        }
+    }
+}
+
+size_t Scenario::trackCount() const
+{
+    return enemies.size() + (trackFile ? trackFile->trackCount() : 0);
+}
@@ -0,0 +1,564 @@
+#include "scenario_file.h"
+#include "scenario.h"
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace scenario_file;
+
+namespace
+{
+    std::runtime_error fileError(const std::string &path, const std::string &message)
+    {
+        return std::runtime_error(path + ": " + message);
+    }
+
+    // offset + length <= limit, without overflowing
+    bool fits(uint64_t offset, uint64_t length, uint64_t limit)
+    {
+        return offset <= limit && length <= limit - offset;
+    }
+
+    bool fitsRecords(uint64_t offset, uint64_t count, uint64_t recordSize, uint64_t limit)
+    {
+        return count <= limit / recordSize && fits(offset, count * recordSize, limit);
+    }
+
+    uint64_t alignUp(uint64_t value, uint64_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    size_t columnElementSize(int column)
+    {
+        switch (column)
+        {
+        case COLUMN_IDS:
+        case COLUMN_TARGET_ID:
+        case COLUMN_INDEX_BY_ID:
+            return sizeof(int32_t);
+        default:
+            return sizeof(double);
+        }
+    }
+
+    std::string nameAt(const MappedScenarioFile &file, uint32_t offset, uint32_t length)
+    {
+        const Header &header = file.header();
+        if (!fits(offset, length, header.stringsSize))
+        {
+            throw fileError(file.getPath(), "name outside the string table");
+        }
+        return std::string(reinterpret_cast<const char *>(file.bytes() + header.stringsOffset + offset), length);
+    }
+
+    // The mapped tracks index rows through these columns unchecked: every ID must be
+    // in the index and point back at its own row, and every other entry must be -1
+    std::string checkTrackIndex(const Header &h, const unsigned char *section)
+    {
+        const int32_t *ids = reinterpret_cast<const int32_t *>(section + h.columnOffsets[COLUMN_IDS]);
+        const int32_t *indexById = reinterpret_cast<const int32_t *>(section + h.columnOffsets[COLUMN_INDEX_BY_ID]);
+        for (uint64_t i = 0; i < h.trackCount; ++i)
+        {
+            if (ids[i] < 0 || static_cast<uint64_t>(ids[i]) >= h.trackIndexSize)
+            {
+                return "track ID " + std::to_string(ids[i]) + " outside the ID index";
+            }
+            if (indexById[ids[i]] != static_cast<int64_t>(i))
+            {
+                return "ID index does not point track ID " + std::to_string(ids[i]) + " at its row";
+            }
+        }
+        uint64_t listed = 0;
+        for (uint64_t id = 0; id < h.trackIndexSize; ++id)
+        {
+            if (indexById[id] != -1)
+            {
+                ++listed;
+            }
+        }
+        // Each track claimed exactly one entry above, anything more is a stray row
+        return listed == h.trackCount ? std::string() : "ID index lists rows with no track";
+    }
+}
+
+MappedScenarioFile::MappedScenarioFile(const std::string &path) : path(path)
+{
+    fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        throw fileError(path, std::strerror(errno));
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(Header)))
+    {
+        ::close(fd);
+        throw fileError(path, "not a binary scenario file (too small)");
+    }
+    size = static_cast<size_t>(info.st_size);
+
+    void *mapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED)
+    {
+        int error = errno;
+        ::close(fd);
+        throw fileError(path, std::string("mmap failed: ") + std::strerror(error));
+    }
+    base = static_cast<unsigned char *>(mapping);
+
+    // The layout first, then the ID index the track columns are found through
+    const Header &h = header();
+    std::string problem;
+    if (std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0)
+    {
+        problem = "not a binary scenario file (bad magic; text scenarios need norad_scenario_convert)";
+    }
+    else if (h.byteOrder != BYTE_ORDER_MARK)
+    {
+        problem = "written on a machine with a different byte order";
+    }
+    else if (h.version != VERSION)
+    {
+        problem = "unsupported format version " + std::to_string(h.version) + " (expected " + std::to_string(VERSION) + ")";
+    }
+    else if (h.headerSize != sizeof(Header) || h.fileSize != size)
+    {
+        problem = "truncated or corrupt header";
+    }
+    else if (!fitsRecords(h.padOffset, h.padCount, sizeof(PadRecord), size) ||
+             !fitsRecords(h.interceptorOffset, h.interceptorCount, sizeof(InterceptorRecord), size) ||
+             !fitsRecords(h.targetOffset, h.targetCount, sizeof(TargetRecord), size) ||
+             !fits(h.stringsOffset, h.stringsSize, size))
+    {
+        problem = "record section outside the file";
+    }
+    else if (h.trackSectionOffset % static_cast<uint64_t>(::sysconf(_SC_PAGESIZE)) != 0 ||
+             !fits(h.trackSectionOffset, h.trackSectionSize, size))
+    {
+        problem = "track section misaligned or outside the file";
+    }
+    else
+    {
+        for (int column = 0; column < TRACK_COLUMN_COUNT && problem.empty(); ++column)
+        {
+            uint64_t count = column == COLUMN_INDEX_BY_ID ? h.trackIndexSize : h.trackCount;
+            if (h.columnOffsets[column] % COLUMN_ALIGNMENT != 0 ||
+                !fitsRecords(h.columnOffsets[column], count, columnElementSize(column), h.trackSectionSize))
+            {
+                problem = "track column outside the track section";
+            }
+        }
+        if (problem.empty() && h.trackSectionSize != 0)
+        {
+            problem = checkTrackIndex(h, base + h.trackSectionOffset);
+        }
+    }
+
+    if (!problem.empty())
+    {
+        ::munmap(base, size);
+        ::close(fd);
+        throw fileError(path, problem);
+    }
+}
+
+MappedScenarioFile::~MappedScenarioFile()
+{
+    ::munmap(base, size);
+    ::close(fd);
+}
+
+TrackStore::ExternalColumns MappedScenarioFile::mapTracks() const
+{
+    const Header &h = header();
+    TrackStore::ExternalColumns columns;
+    if (h.trackSectionSize == 0)
+    {
+        return columns;
+    }
+
+    // Private and writable: the simulation moves and removes tracks in place,
+    // copy-on-write keeps the file and other mappings untouched
+    size_t length = static_cast<size_t>(h.trackSectionSize);
+    void *mapping = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd,
+                           static_cast<off_t>(h.trackSectionOffset));
+    if (mapping == MAP_FAILED)
+    {
+        throw fileError(path, std::string("mmap of track section failed: ") + std::strerror(errno));
+    }
+    unsigned char *section = static_cast<unsigned char *>(mapping);
+    columns.owner = std::shared_ptr<void>(mapping, [length](void *memory)
+                                          { ::munmap(memory, length); });
+
+    auto column = [&](int id)
+    { return section + h.columnOffsets[id]; };
+
+    columns.count = static_cast<size_t>(h.trackCount);
+    columns.ids = reinterpret_cast<int *>(column(COLUMN_IDS));
+    columns.xs = reinterpret_cast<double *>(column(COLUMN_X));
+    columns.ys = reinterpret_cast<double *>(column(COLUMN_Y));
+    columns.zs = reinterpret_cast<double *>(column(COLUMN_Z));
+    columns.targetXs = reinterpret_cast<double *>(column(COLUMN_TARGET_X));
+    columns.targetYs = reinterpret_cast<double *>(column(COLUMN_TARGET_Y));
+    columns.targetZs = reinterpret_cast<double *>(column(COLUMN_TARGET_Z));
+    columns.speeds = reinterpret_cast<double *>(column(COLUMN_SPEED));
+    columns.targetIds = reinterpret_cast<int *>(column(COLUMN_TARGET_ID));
+    columns.indexById = reinterpret_cast<int32_t *>(column(COLUMN_INDEX_BY_ID));
+    columns.indexSize = static_cast<size_t>(h.trackIndexSize);
+    return columns;
+}
+
+Scenario Scenario::loadBinary(const std::string &path)
+{
+    auto file = std::make_shared<MappedScenarioFile>(path);
+    const Header &h = file->header();
+
+    Scenario scenario;
+    scenario.setOrigin({h.originLatitude, h.originLongitude, h.originAltitude});
+    const PadRecord *pads = reinterpret_cast<const PadRecord *>(file->bytes() + h.padOffset);
+    for (uint64_t i = 0; i < h.padCount; ++i)
+    {
+        scenario.addPad(nameAt(*file, pads[i].nameOffset, pads[i].nameLength),
+                        {pads[i].latitude, pads[i].longitude, pads[i].altitude});
+    }
+
+    const InterceptorRecord *interceptors = reinterpret_cast<const InterceptorRecord *>(file->bytes() + h.interceptorOffset);
+    for (uint64_t i = 0; i < h.interceptorCount; ++i)
+    {
+        const InterceptorRecord &record = interceptors[i];
+        if (record.padIndex >= scenario.pads.size())
+        {
+            throw fileError(path, "interceptor refers to a missing launch pad");
+        }
+        scenario.interceptors.push_back({record.damage, nameAt(*file, record.nameOffset, record.nameLength),
+                                         record.speed, scenario.pads[record.padIndex].position});
+    }
+
+    const TargetRecord *targets = reinterpret_cast<const TargetRecord *>(file->bytes() + h.targetOffset);
+    for (uint64_t i = 0; i < h.targetCount; ++i)
+    {
+        scenario.addTarget(targets[i].id, nameAt(*file, targets[i].nameOffset, targets[i].nameLength),
+                           {targets[i].latitude, targets[i].longitude, targets[i].altitude});
+    }
+
+    scenario.trackFile = file;
+    return scenario;
+}
+
+void Scenario::saveBinary(const std::string &path) const
+{
+    // Gather every track (mapped and in memory) into one store to write its columns
+    TrackStore tracks;
+    if (trackFile)
+    {
+        tracks.adopt(trackFile->mapTracks());
+    }
+    for (const auto &enemy : enemies)
+    {
+        tracks.add(enemy);
+    }
+
+    std::string strings;
+    auto addString = [&strings](const std::string &text, uint32_t &offset, uint32_t &length)
+    {
+        offset = static_cast<uint32_t>(strings.size());
+        length = static_cast<uint32_t>(text.size());
+        strings += text;
+    };
+
+    // Interceptors refer to pads by index; positions without a named pad get one
+    std::vector<LaunchPad> allPads = pads;
+    std::vector<InterceptorRecord> interceptorRecords;
+    for (const auto &config : interceptors)
+    {
+        uint32_t padIndex = 0;
+        while (padIndex < allPads.size() && !(allPads[padIndex].position.x == config.position.x &&
+                                              allPads[padIndex].position.y == config.position.y &&
+                                              allPads[padIndex].position.z == config.position.z))
+        {
+            ++padIndex;
+        }
+        if (padIndex == allPads.size())
+        {
+            allPads.push_back({"Pad " + std::to_string(padIndex + 1), frame.toGeodetic(config.position), config.position});
+        }
+
+        InterceptorRecord record = {};
+        record.damage = config.damage;
+        record.padIndex = padIndex;
+        record.speed = config.speed;
+        addString(config.name, record.nameOffset, record.nameLength);
+        interceptorRecords.push_back(record);
+    }
+
+    std::vector<PadRecord> padRecords;
+    for (const auto &pad : allPads)
+    {
+        PadRecord record = {};
+        record.latitude = pad.location.latitude;
+        record.longitude = pad.location.longitude;
+        record.altitude = pad.location.altitude;
+        addString(pad.name, record.nameOffset, record.nameLength);
+        padRecords.push_back(record);
+    }
+
+    std::vector<TargetRecord> targetRecords;
+    for (const auto &target : targets)
+    {
+        TargetRecord record = {};
+        record.id = target.id;
+        record.latitude = target.location.latitude;
+        record.longitude = target.location.longitude;
+        record.altitude = target.location.altitude;
+        addString(target.name, record.nameOffset, record.nameLength);
+        targetRecords.push_back(record);
+    }
+
+    // The dense ID -> row index, exactly as TrackStore keeps it
+    size_t trackCount = tracks.size();
+    int maxId = -1;
+    for (size_t i = 0; i < trackCount; ++i)
+    {
+        maxId = std::max(maxId, tracks.idAt(i));
+    }
+    std::vector<int32_t> indexById(static_cast<size_t>(maxId + 1), -1);
+    for (size_t i = 0; i < trackCount; ++i)
+    {
+        indexById[tracks.idAt(i)] = static_cast<int32_t>(i);
+    }
+
+    const void *columnData[TRACK_COLUMN_COUNT] = {
+        tracks.idData(), tracks.xData(), tracks.yData(), tracks.zData(),
+        tracks.targetXData(), tracks.targetYData(), tracks.targetZData(),
+        tracks.speedData(), tracks.targetIdData(), indexById.data()};
+
+    Header header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.headerSize = sizeof(Header);
+    header.originLatitude = frame.getOrigin().latitude;
+    header.originLongitude = frame.getOrigin().longitude;
+    header.originAltitude = frame.getOrigin().altitude;
+
+    uint64_t offset = sizeof(Header);
+    header.padCount = padRecords.size();
+    header.padOffset = offset = alignUp(offset, alignof(PadRecord));
+    offset += padRecords.size() * sizeof(PadRecord);
+    header.interceptorCount = interceptorRecords.size();
+    header.interceptorOffset = offset = alignUp(offset, alignof(InterceptorRecord));
+    offset += interceptorRecords.size() * sizeof(InterceptorRecord);
+    header.targetCount = targetRecords.size();
+    header.targetOffset = offset = alignUp(offset, alignof(TargetRecord));
+    offset += targetRecords.size() * sizeof(TargetRecord);
+    header.stringsSize = strings.size();
+    header.stringsOffset = offset;
+    offset += strings.size();
+
+    header.trackCount = trackCount;
+    header.trackIndexSize = indexById.size();
+    header.trackSectionOffset = alignUp(offset, static_cast<uint64_t>(::sysconf(_SC_PAGESIZE)));
+    uint64_t columnOffset = 0;
+    for (int column = 0; column < TRACK_COLUMN_COUNT; ++column)
+    {
+        uint64_t count = column == COLUMN_INDEX_BY_ID ? indexById.size() : trackCount;
+        header.columnOffsets[column] = columnOffset = alignUp(columnOffset, COLUMN_ALIGNMENT);
+        columnOffset += count * columnElementSize(column);
+    }
+    header.trackSectionSize = columnOffset;
+    header.fileSize = header.trackSectionOffset + header.trackSectionSize;
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        throw fileError(path, "cannot open for writing");
+    }
+
+    uint64_t written = 0;
+    auto writeAt = [&](uint64_t position, const void *data, size_t length)
+    {
+        static const char zeros[COLUMN_ALIGNMENT * 64] = {};
+        while (written < position)
+        {
+            size_t gap = static_cast<size_t>(std::min<uint64_t>(position - written, sizeof(zeros)));
+            out.write(zeros, gap);
+            written += gap;
+        }
+        out.write(static_cast<const char *>(data), static_cast<std::streamsize>(length));
+        written += length;
+    };
+
+    writeAt(0, &header, sizeof(header));
+    writeAt(header.padOffset, padRecords.data(), padRecords.size() * sizeof(PadRecord));
+    writeAt(header.interceptorOffset, interceptorRecords.data(), interceptorRecords.size() * sizeof(InterceptorRecord));
+    writeAt(header.targetOffset, targetRecords.data(), targetRecords.size() * sizeof(TargetRecord));
+    writeAt(header.stringsOffset, strings.data(), strings.size());
+    for (int column = 0; column < TRACK_COLUMN_COUNT; ++column)
+    {
+        uint64_t count = column == COLUMN_INDEX_BY_ID ? indexById.size() : trackCount;
+        writeAt(header.trackSectionOffset + header.columnOffsets[column], columnData[column],
+                static_cast<size_t>(count * columnElementSize(column)));
+    }
+    writeAt(header.fileSize, nullptr, 0);
+
+    if (!out.flush())
+    {
+        throw fileError(path, "write failed");
+    }
+}
+
+Scenario Scenario::loadText(const std::string &path)
+{
+    std::ifstream in(path);
+    if (!in)
+    {
+        throw fileError(path, "cannot open");
+    }
+
+    Scenario scenario;
+    std::unordered_map<std::string, size_t> padByName;
+    std::unordered_map<int, size_t> targetById;
+    int nextTrackId = 1000;
+    bool located = false; // Something placed in the frame, the origin is fixed
+
+    // Without an `origin` entry the first location becomes the origin
+    auto place = [&](const GeodeticPosition &location)
+    {
+        if (!located)
+        {
+            scenario.setOrigin(location);
+            located = true;
+        }
+    };
+
+    std::string line;
+    for (int lineNumber = 1; std::getline(in, line); ++lineNumber)
+    {
+        auto fail = [&](const std::string &message)
+        {
+            return fileError(path, "line " + std::to_string(lineNumber) + ": " + message);
+        };
+
+        std::istringstream fields(line.substr(0, line.find('#')));
+        std::string kind;
+        if (!(fields >> kind))
+        {
+            continue;
+        }
+
+        if (kind == "origin")
+        {
+            GeodeticPosition origin;
+            if (!(fields >> origin.latitude >> origin.longitude >> origin.altitude))
+            {
+                throw fail("expected: origin <lat> <lon> <alt>");
+            }
+            if (located)
+            {
+                throw fail("origin must come before any pad, target or track");
+            }
+            scenario.setOrigin(origin);
+            located = true;
+        }
+        else if (kind == "pad")
+        {
+            std::string name;
+            GeodeticPosition location;
+            if (!(fields >> std::quoted(name) >> location.latitude >> location.longitude >> location.altitude))
+            {
+                throw fail("expected: pad \"<name>\" <lat> <lon> <alt>");
+            }
+            place(location);
+            padByName[name] = scenario.pads.size();
+            scenario.addPad(name, location);
+        }
+        else if (kind == "interceptor")
+        {
+            MissileConfig config;
+            std::string padName;
+            size_t count = 1;
+            if (!(fields >> std::quoted(config.name) >> config.damage >> config.speed >> std::quoted(padName)))
+            {
+                throw fail("expected: interceptor \"<name>\" <damage> <speed> \"<pad name>\" [count]");
+            }
+            size_t repeat;
+            if (fields >> repeat)
+            {
+                count = repeat;
+            }
+            auto pad = padByName.find(padName);
+            if (pad == padByName.end())
+            {
+                throw fail("unknown launch pad \"" + padName + "\"");
+            }
+            config.position = scenario.pads[pad->second].position;
+            scenario.interceptors.insert(scenario.interceptors.end(), count, config);
+        }
+        else if (kind == "target")
+        {
+            int id;
+            std::string name;
+            GeodeticPosition location;
+            if (!(fields >> id >> std::quoted(name) >> location.latitude >> location.longitude >> location.altitude))
+            {
+                throw fail("expected: target <id> \"<name>\" <lat> <lon> <alt>");
+            }
+            place(location);
+            targetById[id] = scenario.targets.size();
+            scenario.addTarget(id, name, location);
+        }
+        else if (kind == "track")
+        {
+            int id;
+            int targetId;
+            double speed;
+            GeodeticPosition launch;
+            if (!(fields >> id >> launch.latitude >> launch.longitude >> launch.altitude >> speed >> targetId))
+            {
+                throw fail("expected: track <id> <lat> <lon> <alt> <speed> <target id>");
+            }
+            auto target = targetById.find(targetId);
+            if (target == targetById.end())
+            {
+                throw fail("unknown target " + std::to_string(targetId));
+            }
+            scenario.enemies.push_back(EnemyMissile(id, scenario.frame.fromGeodetic(launch),
+                                                    scenario.targets[target->second].position, speed, targetId));
+            nextTrackId = std::max(nextTrackId, id + 1);
+        }
+        else if (kind == "salvo")
+        {
+            size_t count;
+            unsigned seed = 1;
+            if (!(fields >> count))
+            {
+                throw fail("expected: salvo <count> [seed]");
+            }
+            unsigned givenSeed;
+            if (fields >> givenSeed)
+            {
+                seed = givenSeed;
+            }
+            if (scenario.targets.empty())
+            {
+                throw fail("salvo needs at least one target");
+            }
+            scenario.addSalvo(count, seed, nextTrackId);
+            nextTrackId += static_cast<int>(count);
+        }
+        else
+        {
+            throw fail("unknown entry \"" + kind + "\"");
+        }
+    }
+    return scenario;
+}
@@ -0,0 +1,134 @@
+#include "sensor_network.h"
+#include "measurement_noise.h"
+#include "track_store.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+    FusionSettings fusionSettings(const std::vector<RadarSite> &sites)
+    {
+        FusionSettings settings;
+        settings.positionNoise = 0.0;
+        settings.velocityNoise = 0.0;
+        settings.maxScanInterval = 1;
+        for (const RadarSite &site : sites)
+        {
+            settings.positionNoise = std::max(settings.positionNoise, site.noise);
+            settings.velocityNoise = std::max(settings.velocityNoise, site.velocityNoise);
+            settings.maxScanInterval = std::max(settings.maxScanInterval, static_cast<long>(site.scanInterval));
+        }
+        return settings;
+    }
+}
+
+SensorNetwork::SensorNetwork(const TrackStore &truth, std::vector<RadarSite> sites)
+    : truth(truth), sites(std::move(sites)), fusion(fusionSettings(this->sites)), sitePlots(this->sites.size())
+{
+    for (const RadarSite &site : this->sites)
+    {
+        if (site.range <= 0.0 || site.scanInterval < 1 || site.noise < 0.0 || site.velocityNoise < 0.0)
+        {
+            throw std::invalid_argument("Radar site \"" + site.name + "\" needs a positive range and scan interval");
+        }
+    }
+}
+
+SensorNetwork::~SensorNetwork() = default;
+
+void SensorNetwork::setWorkerCount(size_t workers)
+{
+    if (workers <= 1)
+    {
+        pool.reset();
+    }
+    else if (!pool || pool->size() != workers)
+    {
+        pool = std::make_unique<ThreadPool>(workers);
+    }
+}
+
+const std::vector<SystemTrack> &SensorNetwork::update(long tick)
+{
+    dueSites.clear();
+    for (size_t site = 0; site < sites.size(); ++site)
+    {
+        if ((tick + static_cast<long>(site)) % sites[site].scanInterval == 0)
+        {
+            dueSites.push_back(site);
+        }
+    }
+
+    auto scan = [&](size_t due)
+    { scanSite(dueSites[due], tick, sitePlots[dueSites[due]]); };
+    if (pool)
+    {
+        pool->parallelFor(dueSites.size(), scan);
+    }
+    else
+    {
+        for (size_t due = 0; due < dueSites.size(); ++due)
+        {
+            scan(due);
+        }
+    }
+
+    plots.clear();
+    for (size_t site : dueSites)
+    {
+        plots.insert(plots.end(), sitePlots[site].begin(), sitePlots[site].end());
+    }
+    plotCount += plots.size();
+
+    fusion.fuse(tick, plots);
+    return fusion.getTracks();
+}
+
+void SensorNetwork::scanSite(size_t site, long tick, std::vector<Plot> &out) const
+{
+    const RadarSite &radar = sites[site];
+    const double rangeSquared = radar.range * radar.range;
+    // Uniform noise with the site's standard deviations
+    const double spread = radar.noise * std::sqrt(3.0);
+    const double velocitySpread = radar.velocityNoise * std::sqrt(3.0);
+
+    const double *xs = truth.xData();
+    const double *ys = truth.yData();
+    const double *zs = truth.zData();
+    const double *targetXs = truth.targetXData();
+    const double *targetYs = truth.targetYData();
+    const double *targetZs = truth.targetZData();
+    const double *speeds = truth.speedData();
+    const int *ids = truth.idData();
+
+    out.clear();
+    for (size_t i = 0; i < truth.size(); ++i)
+    {
+        double dx = xs[i] - radar.position.x;
+        double dy = ys[i] - radar.position.y;
+        double dz = zs[i] - radar.position.z;
+        if (dx * dx + dy * dy + dz * dz > rangeSquared)
+        {
+            continue;
+        }
+        Plot plot;
+        plot.radar = static_cast<uint32_t>(site);
+        plot.enemyId = ids[i];
+        plot.position = {xs[i] + spread * uniformNoise(site, ids[i], tick, 0),
+                         ys[i] + spread * uniformNoise(site, ids[i], tick, 1),
+                         zs[i] + spread * uniformNoise(site, ids[i], tick, 2)};
+
+        // Straight at the target, the last step only as long as what is left
+        double tx = targetXs[i] - xs[i];
+        double ty = targetYs[i] - ys[i];
+        double tz = targetZs[i] - zs[i];
+        double remaining = std::sqrt(tx * tx + ty * ty + tz * tz);
+        double step = remaining > 0.0 ? std::min(speeds[i], remaining) / remaining : 0.0;
+        plot.velocity = {tx * step + velocitySpread * uniformNoise(site, ids[i], tick, 3),
+                         ty * step + velocitySpread * uniformNoise(site, ids[i], tick, 4),
+                         tz * step + velocitySpread * uniformNoise(site, ids[i], tick, 5)};
+        out.push_back(plot);
+    }
+}
@@ -0,0 +1,698 @@
+#include "sharded_theater.h"
+#include "scenario_file.h"
+#include "track_store.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <csignal>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// ShardMap
+
+ShardMap ShardMap::balanced(std::vector<Position> points, size_t shards)
+{
+    if (shards == 0)
+    {
+        throw std::invalid_argument("ShardMap: need at least one shard");
+    }
+    ShardMap map;
+    map.shardCount = shards;
+    if (shards > 1)
+    {
+        map.build(points.data(), points.data() + points.size(), 0, shards);
+    }
+    return map;
+}
+
+int32_t ShardMap::build(Position *begin, Position *end, size_t firstShard, size_t shards)
+{
+    if (shards == 1)
+    {
+        return ~static_cast<int32_t>(firstShard);
+    }
+
+    // Cut across the widest axis, at the share of points the low side's shards get
+    Position low = {0.0, 0.0, 0.0};
+    Position high = {0.0, 0.0, 0.0};
+    if (begin != end)
+    {
+        low = high = *begin;
+        for (const Position *point = begin; point != end; ++point)
+        {
+            low = {std::min(low.x, point->x), std::min(low.y, point->y), std::min(low.z, point->z)};
+            high = {std::max(high.x, point->x), std::max(high.y, point->y), std::max(high.z, point->z)};
+        }
+    }
+    double extent[3] = {high.x - low.x, high.y - low.y, high.z - low.z};
+    int axis = static_cast<int>(std::max_element(extent, extent + 3) - extent);
+    auto coordinate = [axis](const Position &point)
+    { return axis == 0 ? point.x : axis == 1 ? point.y : point.z; };
+
+    size_t lowShards = shards / 2;
+    Position *middle = begin + static_cast<size_t>(end - begin) * lowShards / shards;
+    double split = 0.0;
+    if (middle != end)
+    {
+        std::nth_element(begin, middle, end, [&](const Position &a, const Position &b)
+                         { return coordinate(a) < coordinate(b); });
+        split = coordinate(*middle);
+    }
+
+    size_t index = nodes.size();
+    nodes.push_back({axis, split, 0, 0});
+    int32_t lowChild = build(begin, middle, firstShard, lowShards);
+    int32_t highChild = build(middle, end, firstShard + lowShards, shards - lowShards);
+    nodes[index].low = lowChild;
+    nodes[index].high = highChild;
+    return static_cast<int32_t>(index);
+}
+
+size_t ShardMap::shardOf(const Position &position) const
+{
+    if (nodes.empty())
+    {
+        return 0;
+    }
+    int32_t child = 0;
+    while (child >= 0)
+    {
+        const Node &node = nodes[child];
+        double value = node.axis == 0 ? position.x : node.axis == 1 ? position.y : position.z;
+        child = value < node.split ? node.low : node.high;
+    }
+    return static_cast<size_t>(~child);
+}
+
+namespace
+{
+    // One track changing shard, with everything the receiver needs to fly it on
+    struct Handover
+    {
+        int32_t id;
+        int32_t targetId;
+        long tick; // Tick it left on; the receiver takes it before the next one
+        Position position;
+        Position target;
+        double speed;
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+                  "shared-memory counters must be lock-free to work across processes");
+
+    struct alignas(64) RingIndex
+    {
+        std::atomic<uint64_t> value;
+    };
+
+    // Single-producer single-consumer ring over shared memory. Only the
+    // sending shard moves head and only the receiving one moves tail.
+    class HandoverRing
+    {
+    public:
+        HandoverRing(void *memory, uint64_t capacity)
+            : head(&static_cast<RingIndex *>(memory)[0].value), tail(&static_cast<RingIndex *>(memory)[1].value),
+              records(reinterpret_cast<Handover *>(static_cast<RingIndex *>(memory) + 2)), mask(capacity - 1)
+        {
+        }
+
+        static size_t bytesFor(uint64_t capacity) { return 2 * sizeof(RingIndex) + capacity * sizeof(Handover); }
+
+        bool push(const Handover &record)
+        {
+            uint64_t position = head->load(std::memory_order_relaxed);
+            if (position - tail->load(std::memory_order_acquire) > mask)
+            {
+                return false;
+            }
+            records[position & mask] = record;
+            head->store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Takes the oldest record if it left before `tick`; records sent
+        // during the current tick stay for the next one
+        bool popBefore(long tick, Handover &record)
+        {
+            uint64_t position = tail->load(std::memory_order_relaxed);
+            if (position == head->load(std::memory_order_acquire) || records[position & mask].tick >= tick)
+            {
+                return false;
+            }
+            record = records[position & mask];
+            tail->store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+    private:
+        std::atomic<uint64_t> *head;
+        std::atomic<uint64_t> *tail;
+        Handover *records;
+        uint64_t mask;
+    };
+
+    long futex(std::atomic<uint32_t> *word, int operation, uint32_t value, const timespec *timeout)
+    {
+        return ::syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), operation, value, timeout, nullptr, 0);
+    }
+
+    // Sense-counting barrier for the coordinator and every shard. Waiters
+    // spin briefly, then sleep on the generation word, waking every 50 ms to
+    // run `poll`; a false poll or the abort flag gives up the wait.
+    struct TickBarrier
+    {
+        std::atomic<uint32_t> arrived;
+        std::atomic<uint32_t> generation;
+        std::atomic<uint32_t> aborted;
+        uint32_t parties;
+
+        template <typename Poll>
+        bool wait(Poll poll)
+        {
+            uint32_t current = generation.load(std::memory_order_acquire);
+            if (arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == parties)
+            {
+                arrived.store(0, std::memory_order_relaxed);
+                generation.fetch_add(1, std::memory_order_release);
+                futex(&generation, FUTEX_WAKE, INT_MAX, nullptr);
+                return true;
+            }
+
+            const timespec timeout = {0, 50 * 1000 * 1000};
+            for (int spins = 0; generation.load(std::memory_order_acquire) == current; ++spins)
+            {
+                if (aborted.load(std::memory_order_acquire))
+                {
+                    return false;
+                }
+                if (spins < 64)
+                {
+                    std::this_thread::yield();
+                }
+                else if (futex(&generation, FUTEX_WAIT, current, &timeout) != 0 && errno == ETIMEDOUT &&
+                         generation.load(std::memory_order_acquire) == current && !poll())
+                {
+                    // Still short of a party, so nobody has left this barrier normally
+                    return false;
+                }
+            }
+            return aborted.load(std::memory_order_acquire) == 0;
+        }
+
+        void abort()
+        {
+            aborted.store(1, std::memory_order_release);
+            generation.fetch_add(1, std::memory_order_release);
+            futex(&generation, FUTEX_WAKE, INT_MAX, nullptr);
+        }
+    };
+
+    // What a shard publishes at every barrier, double-buffered by tick parity:
+    // a slot is rewritten two barriers later, after everyone has read it
+    struct ShardSlot
+    {
+        uint64_t live; // Tracks in the shard's store
+        uint64_t sent; // Handed over during this tick, in flight until the next
+        int32_t failed;
+        char error[160];
+    };
+
+    // The whole shared mapping: barrier, slots, results, then the rings
+    class SharedState
+    {
+    public:
+        SharedState(size_t shards, uint64_t ringCapacity) : shards(shards), ringCapacity(ringCapacity)
+        {
+            slotOffset = align(sizeof(TickBarrier));
+            resultOffset = align(slotOffset + 2 * shards * sizeof(ShardSlot));
+            ringOffset = align(resultOffset + shards * sizeof(ShardResult));
+            ringStride = align(HandoverRing::bytesFor(ringCapacity));
+            size = ringOffset + shards * shards * ringStride;
+
+            // Shared with the forked workers; pages are only backed once touched
+            void *mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+            if (mapping == MAP_FAILED)
+            {
+                throw std::runtime_error(std::string("sharded theater: shared memory mmap failed: ") + std::strerror(errno));
+            }
+            base = static_cast<unsigned char *>(mapping);
+
+            TickBarrier *control = new (base) TickBarrier();
+            control->parties = static_cast<uint32_t>(shards + 1);
+            for (size_t i = 0; i < 2 * shards; ++i)
+            {
+                new (base + slotOffset + i * sizeof(ShardSlot)) ShardSlot();
+            }
+            for (size_t i = 0; i < shards; ++i)
+            {
+                new (base + resultOffset + i * sizeof(ShardResult)) ShardResult();
+            }
+            for (size_t i = 0; i < shards * shards; ++i)
+            {
+                RingIndex *indices = reinterpret_cast<RingIndex *>(base + ringOffset + i * ringStride);
+                new (&indices[0]) RingIndex();
+                new (&indices[1]) RingIndex();
+            }
+        }
+
+        ~SharedState() { ::munmap(base, size); }
+        SharedState(const SharedState &) = delete;
+        SharedState &operator=(const SharedState &) = delete;
+
+        TickBarrier &barrier() { return *reinterpret_cast<TickBarrier *>(base); }
+        ShardSlot &slot(long phase, size_t shard)
+        {
+            return reinterpret_cast<ShardSlot *>(base + slotOffset)[(phase & 1) * shards + shard];
+        }
+        ShardResult &result(size_t shard) { return reinterpret_cast<ShardResult *>(base + resultOffset)[shard]; }
+        HandoverRing ring(size_t from, size_t to)
+        {
+            return HandoverRing(base + ringOffset + (from * shards + to) * ringStride, ringCapacity);
+        }
+
+        // Every process reads the same slots after a barrier and so takes the same decision
+        bool finished(long phase, long ticks)
+        {
+            uint64_t tracks = 0;
+            for (size_t shard = 0; shard < shards; ++shard)
+            {
+                const ShardSlot &published = slot(phase, shard);
+                if (published.failed)
+                {
+                    return true;
+                }
+                tracks += published.live + published.sent;
+            }
+            return phase >= ticks || tracks == 0;
+        }
+
+    private:
+        size_t shards;
+        uint64_t ringCapacity;
+        size_t slotOffset = 0;
+        size_t resultOffset = 0;
+        size_t ringOffset = 0;
+        size_t ringStride = 0;
+        size_t size = 0;
+        unsigned char *base = nullptr;
+
+        static size_t align(size_t bytes) { return (bytes + 4095) & ~static_cast<size_t>(4095); }
+    };
+
+    // Binary-file tracks first, then the listed ones: the order Simulation adds them in
+    template <typename Visit>
+    void forEachTrack(const Scenario &scenario, Visit visit)
+    {
+        if (scenario.trackFile)
+        {
+            TrackStore mapped;
+            mapped.adopt(scenario.trackFile->mapTracks());
+            for (size_t i = 0; i < mapped.size(); ++i)
+            {
+                visit(mapped.toEnemyMissile(i));
+            }
+        }
+        for (const EnemyMissile &enemy : scenario.enemies)
+        {
+            visit(enemy);
+        }
+    }
+
+    // Launch points to balance the shards on; a sample is plenty for the medians
+    std::vector<Position> launchPoints(const Scenario &scenario)
+    {
+        const size_t MAX_POINTS = 1 << 18;
+        size_t stride = std::max<size_t>(1, scenario.trackCount() / MAX_POINTS);
+        std::vector<Position> points;
+        points.reserve(std::min(scenario.trackCount(), MAX_POINTS + 1));
+        size_t index = 0;
+        forEachTrack(scenario, [&](const EnemyMissile &enemy)
+                     {
+                         if (index++ % stride == 0)
+                         {
+                             points.push_back(enemy.getCurrentPosition());
+                         } });
+        return points;
+    }
+
+    // One shard, run inside its worker process
+    class ShardWorker
+    {
+    public:
+        ShardWorker(size_t shard, const Scenario &scenario, const ShardMap &map, const ShardedConfig &config,
+                    SharedState &shared)
+            : shard(shard), scenario(scenario), map(map), config(config), shared(shared)
+        {
+        }
+
+        // Exit status of the worker process
+        int run()
+        {
+            using Clock = std::chrono::steady_clock;
+
+            long phase = 0;
+            attempt(phase, [this]()
+                    { build(); });
+            while (true)
+            {
+                auto waitStart = Clock::now();
+                if (!shared.barrier().wait([]()
+                                           { return true; }))
+                {
+                    return 2; // The coordinator gave up
+                }
+                result.barrierWaitSeconds += std::chrono::duration<double>(Clock::now() - waitStart).count();
+                if (shared.finished(phase, config.ticks))
+                {
+                    break;
+                }
+
+                ++phase;
+                auto tickStart = Clock::now();
+                attempt(phase, [this, phase]()
+                        { tick(phase); });
+                result.stats.elapsedSeconds += std::chrono::duration<double>(Clock::now() - tickStart).count();
+            }
+
+            if (sim)
+            {
+                double busy = result.stats.elapsedSeconds;
+                result.stats = sim->getStats();
+                result.stats.elapsedSeconds = busy;
+            }
+            shared.result(shard) = result;
+            return failed ? 1 : 0;
+        }
+
+    private:
+        size_t shard;
+        const Scenario &scenario;
+        const ShardMap &map;
+        const ShardedConfig &config;
+        SharedState &shared;
+
+        std::unique_ptr<Simulation> sim;
+        ShardResult result;
+        uint64_t sent = 0;
+        bool failed = false;
+
+        // Runs one phase's work and publishes its slot; after a failure the
+        // shard idles through the barriers until everyone has seen it
+        template <typename Work>
+        void attempt(long phase, Work work)
+        {
+            ShardSlot &slot = shared.slot(phase, shard);
+            sent = 0;
+            if (!failed)
+            {
+                try
+                {
+                    work();
+                }
+                catch (const std::exception &error)
+                {
+                    failed = true;
+                    std::strncpy(slot.error, error.what(), sizeof(slot.error) - 1);
+                    slot.error[sizeof(slot.error) - 1] = '\0';
+                }
+            }
+            slot.live = sim ? sim->getEnemies().size() : 0;
+            slot.sent = sent;
+            slot.failed = failed;
+        }
+
+        void build()
+        {
+            Scenario local;
+            local.frame = scenario.frame;
+            local.targets = scenario.targets;
+            for (const LaunchPad &pad : scenario.pads)
+            {
+                if (map.shardOf(pad.position) == shard)
+                {
+                    local.pads.push_back(pad);
+                }
+            }
+            for (const MissileConfig &interceptor : scenario.interceptors)
+            {
+                if (map.shardOf(interceptor.position) == shard)
+                {
+                    local.interceptors.push_back(interceptor);
+                }
+            }
+            forEachTrack(scenario, [&](const EnemyMissile &enemy)
+                         {
+                             if (map.shardOf(enemy.getCurrentPosition()) == shard)
+                             {
+                                 local.enemies.push_back(enemy);
+                             } });
+            result.initialTracks = local.enemies.size();
+            result.interceptors = local.interceptors.size();
+
+            sim = std::make_unique<Simulation>(local);
+            MissileController &controller = sim->getController();
+            controller.setVerbose(false);
+            controller.setAutoIntercept(true);
+            controller.setMaxAutoInterceptMissiles(config.maxAutoIntercept);
+            controller.setAutoInterceptThreshold(config.autoInterceptThreshold);
+            controller.setAssignmentMode(config.assignmentMode);
+            sim->getRadar().setWorkerCount(config.scanWorkers);
+        }
+
+        void tick(long phase)
+        {
+            TrackStore &enemies = sim->getEnemies();
+
+            // Arrivals from the last tick, in shard order so the run is deterministic
+            Handover record;
+            for (size_t from = 0; from < map.size(); ++from)
+            {
+                HandoverRing ring = shared.ring(from, shard);
+                while (ring.popBefore(phase, record))
+                {
+                    enemies.add(EnemyMissile(record.id, record.position, record.target, record.speed, record.targetId));
+                    ++result.handedIn;
+                }
+            }
+
+            sim->tick();
+
+            // Hand over what left; backwards, so swap-and-pop only moves rows already checked
+            for (size_t i = enemies.size(); i-- > 0;)
+            {
+                size_t owner = map.shardOf(enemies.positionAt(i));
+                if (owner == shard)
+                {
+                    continue;
+                }
+                Handover leaving = {enemies.idAt(i), enemies.targetIdAt(i), phase,
+                                    enemies.positionAt(i), enemies.targetAt(i), enemies.speedAt(i)};
+                if (!shared.ring(shard, owner).push(leaving))
+                {
+                    ++result.handoverRetries; // Flies on here and tries again after the next tick
+                    continue;
+                }
+                enemies.removeById(leaving.id);
+                ++sent;
+                ++result.handedOut;
+            }
+        }
+    };
+
+    uint64_t roundUpToPowerOfTwo(uint64_t value)
+    {
+        uint64_t power = 16;
+        while (power < value)
+        {
+            power <<= 1;
+        }
+        return power;
+    }
+}
+
+uint64_t ShardedReport::handovers() const
+{
+    uint64_t total = 0;
+    for (const ShardResult &shard : shards)
+    {
+        total += shard.handedOut;
+    }
+    return total;
+}
+
+void ShardedReport::print(std::ostream &out) const
+{
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+
+    uint64_t retries = 0;
+    for (const ShardResult &shard : shards)
+    {
+        retries += shard.handoverRetries;
+    }
+    out << "  Setup:          " << std::fixed << std::setprecision(3) << setupSeconds << " s\n"
+        << "  Ticks:          " << total.ticks << "\n"
+        << "  Elapsed:        " << total.elapsedSeconds << " s\n"
+        << "  Ticks/sec:      " << std::setprecision(1) << total.ticksPerSecond() << "\n"
+        << "  Tracks/sec:     " << total.tracksPerSecond() << "\n"
+        << "  Threat reports: " << total.threatReports << "\n"
+        << "  Intercepts:     " << total.interceptsLaunched << " launched, "
+        << total.enemiesDestroyed << " enemies destroyed\n"
+        << "  Impacts:        " << total.impacts << "\n"
+        << "  Handovers:      " << handovers() << " tracks, " << retries << " retried after a full ring\n\n"
+        << "Shard     Tracks  Interceptors    Track steps     Out      In    Busy s    Barrier s\n";
+    for (size_t i = 0; i < shards.size(); ++i)
+    {
+        const ShardResult &shard = shards[i];
+        out << std::left << std::setw(6) << i << std::right
+            << std::setw(10) << shard.initialTracks
+            << std::setw(14) << shard.interceptors
+            << std::setw(15) << shard.stats.trackSteps
+            << std::setw(8) << shard.handedOut
+            << std::setw(8) << shard.handedIn
+            << std::setprecision(3) << std::setw(10) << shard.stats.elapsedSeconds
+            << std::setw(13) << shard.barrierWaitSeconds << "\n";
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+ShardedReport runSharded(const Scenario &scenario, const ShardedConfig &config)
+{
+    using Clock = std::chrono::steady_clock;
+
+    if (config.shards == 0)
+    {
+        throw std::invalid_argument("Sharded runs need at least one shard");
+    }
+    if (!scenario.radars.empty() || scenario.radarNoise > 0.0)
+    {
+        throw std::invalid_argument("Sharded runs need the ideal radar, not radar sites or a noisy radar");
+    }
+
+    auto setupStart = Clock::now();
+    ShardMap map = ShardMap::balanced(launchPoints(scenario), config.shards);
+    SharedState shared(config.shards, roundUpToPowerOfTwo(config.ringCapacity));
+
+    // Workers inherit the scenario and the map through fork's copy-on-write pages
+    std::cout.flush();
+    std::cerr.flush();
+    pid_t coordinator = ::getpid();
+    std::vector<pid_t> workers;
+    for (size_t shard = 0; shard < config.shards; ++shard)
+    {
+        pid_t pid = ::fork();
+        if (pid < 0)
+        {
+            int error = errno;
+            shared.barrier().abort();
+            for (pid_t worker : workers)
+            {
+                ::waitpid(worker, nullptr, 0);
+            }
+            throw std::runtime_error(std::string("sharded theater: fork failed: ") + std::strerror(error));
+        }
+        if (pid == 0)
+        {
+            // Don't outlive a coordinator that died without aborting the barrier
+            ::prctl(PR_SET_PDEATHSIG, SIGKILL);
+            int status = ::getppid() == coordinator ? ShardWorker(shard, scenario, map, config, shared).run() : 2;
+            ::_exit(status);
+        }
+        workers.push_back(pid);
+    }
+
+    // A worker that exits before the run is over would leave everyone at the barrier
+    size_t exited = 0;
+    auto workersAlive = [&]()
+    {
+        for (pid_t &worker : workers)
+        {
+            if (worker > 0 && ::waitpid(worker, nullptr, WNOHANG) == worker)
+            {
+                worker = -1;
+                ++exited;
+            }
+        }
+        return exited == 0;
+    };
+    auto fail = [&](const std::string &message)
+    {
+        shared.barrier().abort();
+        for (pid_t worker : workers)
+        {
+            if (worker > 0)
+            {
+                ::kill(worker, SIGKILL);
+                ::waitpid(worker, nullptr, 0);
+            }
+        }
+        throw std::runtime_error("sharded theater: " + message);
+    };
+
+    ShardedReport report;
+    report.config = config;
+    long phase = 0;
+    Clock::time_point ticksStart;
+    while (true)
+    {
+        if (!shared.barrier().wait(workersAlive))
+        {
+            fail("a shard worker exited mid-run");
+        }
+        if (phase == 0)
+        {
+            ticksStart = Clock::now();
+            report.setupSeconds = std::chrono::duration<double>(ticksStart - setupStart).count();
+        }
+        if (shared.finished(phase, config.ticks))
+        {
+            break;
+        }
+        ++phase;
+    }
+    report.total.elapsedSeconds = std::chrono::duration<double>(Clock::now() - ticksStart).count();
+
+    for (pid_t worker : workers)
+    {
+        if (worker > 0)
+        {
+            ::waitpid(worker, nullptr, 0);
+        }
+    }
+    for (size_t shard = 0; shard < config.shards; ++shard)
+    {
+        const ShardSlot &slot = shared.slot(phase, shard);
+        if (slot.failed)
+        {
+            throw std::runtime_error("sharded theater: shard " + std::to_string(shard) + ": " + slot.error);
+        }
+    }
+
+    for (size_t shard = 0; shard < config.shards; ++shard)
+    {
+        const ShardResult &result = shared.result(shard);
+        report.shards.push_back(result);
+        report.total.trackSteps += result.stats.trackSteps;
+        report.total.threatReports += result.stats.threatReports;
+        report.total.interceptsLaunched += result.stats.interceptsLaunched;
+        report.total.enemiesDestroyed += result.stats.enemiesDestroyed;
+        report.total.impacts += result.stats.impacts;
+    }
+    report.total.ticks = phase;
+    return report;
+}
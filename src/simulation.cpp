@@ -0,0 +1,575 @@
+#include "simulation.h"
+#include "command_channel.h"
+#include "scenario_file.h"
+#include "tick_recorder.h"
+#include "world_publisher.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+    // " (2 Patriot, 1 Stinger)", empty with nothing ready
+    std::string describeReady(const MissileController &controller)
+    {
+        std::string text;
+        for (size_t i = 0; i < INTERCEPTOR_CLASS_COUNT; ++i)
+        {
+            InterceptorClass kind = static_cast<InterceptorClass>(i);
+            if (size_t count = controller.getReadyCount(kind))
+            {
+                const InterceptorSpec *spec = interceptorSpec(kind);
+                text += (text.empty() ? " (" : ", ") + std::to_string(count) + " " +
+                        (spec ? std::string(spec->name) : std::string("custom"));
+            }
+        }
+        return text.empty() ? text : text + ")";
+    }
+}
+
+double SimulationStats::ticksPerSecond() const
+{
+    return elapsedSeconds > 0.0 ? ticks / elapsedSeconds : 0.0;
+}
+
+double SimulationStats::tracksPerSecond() const
+{
+    return elapsedSeconds > 0.0 ? trackSteps / elapsedSeconds : 0.0;
+}
+
+Simulation::Simulation(const Scenario &scenario)
+    : targets(scenario.targets), origin(scenario.frame.getOrigin()), radar(enemies, targets)
+{
+    int missileId = 1;
+    for (const auto &config : scenario.interceptors)
+    {
+        controller.addMissile(Missile(
+            missileId++,
+            config.damage,
+            config.name,
+            config.speed,
+            config.position));
+    }
+
+    // Tracks from a binary scenario are used in place, straight from the mapping
+    if (scenario.trackFile)
+    {
+        enemies.adopt(scenario.trackFile->mapTracks());
+    }
+
+    if (!scenario.enemies.empty())
+    {
+        enemies.reserve(enemies.size() + scenario.enemies.size());
+    }
+    for (const auto &enemy : scenario.enemies)
+    {
+        enemies.add(enemy);
+    }
+
+    if (!scenario.radars.empty())
+    {
+        sensors = std::make_unique<SensorNetwork>(enemies, scenario.radars);
+    }
+    radar.setMeasurementNoise(scenario.radarNoise);
+}
+
+Simulation::~Simulation() = default;
+
+void Simulation::startRecording(const std::string &path, int keyframeInterval)
+{
+    if (sensors || radar.getMeasurementNoise() > 0.0)
+    {
+        throw std::runtime_error("Runs with radar sites or a noisy radar can't be recorded");
+    }
+    recorder.reset(); // Flush any previous log first
+    enemies.setJournaling(true);
+    recorder.reset(new TickRecorder(path, targets, controller, keyframeInterval));
+}
+
+void Simulation::stopRecording()
+{
+    recorder.reset();
+    enemies.setJournaling(false);
+}
+
+void Simulation::startPublishing(const std::string &name)
+{
+    publisher.reset(); // Unlink any previous region first
+    size_t interceptors = controller.getMissiles().size() + controller.getInFlightMissiles().size();
+    publisher.reset(new WorldPublisher(name, origin, targets, enemies.size(), interceptors));
+}
+
+void Simulation::stopPublishing()
+{
+    publisher.reset();
+}
+
+void Simulation::tick()
+{
+    NORAD_PROFILE_PHASE(profiler, TickPhase::Tick);
+
+    // Update enemy missile positions
+    stats.trackSteps += enemies.size();
+    {
+        NORAD_PROFILE_PHASE(profiler, TickPhase::Move);
+        enemies.moveAll();
+    }
+
+    // Interceptors in the air take one step, arrivals destroy their enemy
+    {
+        NORAD_PROFILE_PHASE(profiler, TickPhase::Flights);
+        for (const Missile &arrived : controller.updateFlights())
+        {
+            if (enemies.removeById(arrived.getTargetEnemyId()))
+            {
+                ++stats.enemiesDestroyed;
+            }
+        }
+    }
+
+    // Scan for threats
+    std::vector<ThreatReport> *threats;
+    {
+        NORAD_PROFILE_PHASE(profiler, TickPhase::Scan);
+        threats = &scan();
+    }
+    stats.threatReports += threats->size();
+    removeImpacts(*threats);
+
+    if (!threats->empty() && controller.isAutoInterceptEnabled())
+    {
+        NORAD_PROFILE_PHASE(profiler, TickPhase::AutoIntercept);
+        const std::pmr::vector<int> &engagedIds = controller.autoInterceptThreats(*threats);
+        stats.interceptsLaunched += engagedIds.size();
+    }
+
+    ++stats.ticks;
+
+    if (recorder)
+    {
+        NORAD_PROFILE_PHASE(profiler, TickPhase::Record);
+        recorder->recordTick(stats.ticks, enemies, controller);
+    }
+    if (publisher)
+    {
+        NORAD_PROFILE_PHASE(profiler, TickPhase::Publish);
+        publisher->publish(stats.ticks, enemies, *threats, controller.getMissiles(), controller.getInFlightMissiles());
+    }
+}
+
+std::vector<ThreatReport> &Simulation::scan()
+{
+    // The scan belongs to the tick being run, stats.ticks counts it afterwards
+    return sensors ? radar.reportTracks(sensors->update(stats.ticks + 1), stats.ticks + 1) : radar.scanForThreats();
+}
+
+void Simulation::removeImpacts(std::vector<ThreatReport> &threats)
+{
+    if (sensors || radar.getFilter())
+    {
+        // Fused or filtered positions never sit exactly on the target, the truth decides
+        for (size_t i = enemies.size(); i-- > 0;)
+        {
+            Position position = enemies.positionAt(i);
+            Position target = enemies.targetAt(i);
+            if (position.x == target.x && position.y == target.y && position.z == target.z &&
+                enemies.removeById(enemies.idAt(i)))
+            {
+                ++stats.impacts;
+            }
+        }
+        threats.erase(std::remove_if(threats.begin(), threats.end(), [this](const ThreatReport &threat)
+                                     { return !enemies.contains(threat.enemyId); }),
+                      threats.end());
+        return;
+    }
+
+
+    // Tracks sitting on their target have hit it: out of the store and the report list
+    size_t kept = 0;
+    for (size_t i = 0; i < threats.size(); ++i)
+    {
+        if (threats[i].distanceToTarget > 0)
+        {
+            threats[kept++] = threats[i];
+        }
+        else if (enemies.removeById(threats[i].enemyId))
+        {
+            ++stats.impacts;
+        }
+    }
+    threats.resize(kept);
+}
+
+void Simulation::removeDestroyed(const std::vector<int> &destroyedIds)
+{
+    for (int id : destroyedIds)
+    {
+        if (enemies.removeById(id))
+        {
+            ++stats.enemiesDestroyed;
+        }
+    }
+}
+
+std::vector<ThreatReport> &Simulation::senseTick(const std::vector<int> &destroyedIds)
+{
+    NORAD_PROFILE_PHASE(profiler, TickPhase::Tick);
+
+    removeDestroyed(destroyedIds);
+
+    stats.trackSteps += enemies.size();
+    {
+        NORAD_PROFILE_PHASE(profiler, TickPhase::Move);
+        enemies.moveAll();
+    }
+
+    std::vector<ThreatReport> *threats;
+    {
+        NORAD_PROFILE_PHASE(profiler, TickPhase::Scan);
+        threats = &scan();
+    }
+    stats.threatReports += threats->size();
+    removeImpacts(*threats);
+
+    ++stats.ticks;
+    return *threats;
+}
+
+void Simulation::engageTick(std::vector<ThreatReport> &threats, std::vector<int> &destroyedIds, int steps)
+{
+    {
+        NORAD_PROFILE_PHASE(profiler, TickPhase::Flights);
+        for (const Missile &arrived : controller.updateFlights(steps))
+        {
+            destroyedIds.push_back(arrived.getTargetEnemyId());
+        }
+    }
+
+    if (!threats.empty() && controller.isAutoInterceptEnabled())
+    {
+        NORAD_PROFILE_PHASE(profiler, TickPhase::AutoIntercept);
+        stats.interceptsLaunched += controller.autoInterceptThreats(threats).size();
+    }
+}
+
+std::string Simulation::applyCommand(const OperatorCommand &command, const std::vector<ThreatReport> &threats)
+{
+    using Type = OperatorCommand::Type;
+    using Switch = OperatorCommand::Switch;
+    using Mode = MissileController::AssignmentMode;
+
+    switch (command.type)
+    {
+    case Type::Launch:
+    {
+        Missile *missile = command.missileClass == InterceptorClass::Custom
+                               ? controller.getMissileById(command.id)
+                               : controller.getReadyMissile(command.missileClass);
+        if (!missile)
+        {
+            throw std::invalid_argument(command.missileClass == InterceptorClass::Custom
+                                            ? "missile #" + std::to_string(command.id) + " is not in the inventory"
+                                            : "no " + std::string(interceptorSpec(command.missileClass)->name) + " ready");
+        }
+        std::string name(missile->getName());
+        int id = missile->getId();
+        controller.launchMissile(*missile, command.aim);
+        return name + " #" + std::to_string(id) + " launched at target " + std::to_string(command.target);
+    }
+    case Type::Intercept:
+    {
+        auto threat = std::find_if(threats.begin(), threats.end(), [&](const ThreatReport &report)
+                                   { return report.detectionId == command.id; });
+        if (threat == threats.end())
+        {
+            throw std::invalid_argument("no threat #" + std::to_string(command.id));
+        }
+        if (controller.isEnemyEngaged(threat->enemyId))
+        {
+            throw std::invalid_argument("threat #" + std::to_string(command.id) + " is already engaged");
+        }
+        if (controller.interceptThreat(*threat) < 0)
+        {
+            throw std::invalid_argument("no interceptor can reach threat #" + std::to_string(command.id));
+        }
+        ++stats.interceptsLaunched;
+        return "interceptor launched at threat #" + std::to_string(command.id);
+    }
+    case Type::AutoIntercept:
+    {
+        bool enabled = command.setting == Switch::Toggle ? !controller.isAutoInterceptEnabled()
+                                                         : command.setting == Switch::On;
+        controller.setAutoIntercept(enabled);
+        return std::string("auto-intercept ") + (enabled ? "on" : "off");
+    }
+    case Type::Threshold:
+        controller.setAutoInterceptThreshold(command.value);
+        return "auto-intercept threshold " + std::to_string(static_cast<long>(command.value)) + " m";
+    case Type::MaxAuto:
+        controller.setMaxAutoInterceptMissiles(command.id);
+        return "auto-intercept budget " + std::to_string(command.id) + " missiles";
+    case Type::Assignment:
+    {
+        bool global = command.setting == Switch::Toggle ? controller.getAssignmentMode() != Mode::Global
+                                                        : command.setting == Switch::On;
+        controller.setAssignmentMode(global ? Mode::Global : Mode::Greedy);
+        return std::string("assignment ") + (global ? "global" : "greedy");
+    }
+    case Type::Status:
+        return std::string("auto-intercept ") + (controller.isAutoInterceptEnabled() ? "on" : "off") + " within " +
+               std::to_string(static_cast<long>(controller.getAutoInterceptThreshold())) + " m, " +
+               (controller.getAssignmentMode() == Mode::Global ? "global" : "greedy") + ", " +
+               std::to_string(controller.getMissiles().size()) + " interceptors ready" + describeReady(controller) +
+               ", " + std::to_string(controller.getInFlightCount()) + " in flight";
+    default:
+        throw std::invalid_argument("not a controller command");
+    }
+}
+
+SimulationStats Simulation::runHeadless(long ticks)
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Headless runs never print and always let the auto-intercept logic fight
+    bool wasVerbose = controller.isVerbose();
+    bool wasAutoIntercept = controller.isAutoInterceptEnabled();
+    controller.setVerbose(false);
+    controller.setAutoIntercept(true);
+
+    SimulationStats before = stats;
+    auto start = Clock::now();
+    for (long i = 0; i < ticks && !enemies.empty(); ++i)
+    {
+        tick();
+    }
+    stats.elapsedSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+
+    controller.setAutoIntercept(wasAutoIntercept);
+    controller.setVerbose(wasVerbose);
+    return statsSince(before);
+}
+
+SimulationStats Simulation::runEventDriven(long ticks)
+{
+    using Clock = std::chrono::steady_clock;
+
+    if (recorder)
+    {
+        throw std::runtime_error("Event-driven runs can't be recorded, stop recording first");
+    }
+    if (sensors || radar.getMeasurementNoise() > 0.0)
+    {
+        throw std::runtime_error("Event-driven runs need the ideal radar, not radar sites or a noisy radar");
+    }
+
+    bool wasVerbose = controller.isVerbose();
+    bool wasAutoIntercept = controller.isAutoInterceptEnabled();
+    controller.setVerbose(false);
+    controller.setAutoIntercept(true);
+
+    SimulationStats before = stats;
+    auto start = Clock::now();
+
+    // Store positions stay as they were at startTick until the end; in between
+    // a track's position at tick t is predicted with positionAfter(t - startTick)
+    const long startTick = stats.ticks;
+    const long endTick = startTick + ticks;
+    const double threshold = controller.getAutoInterceptThreshold();
+
+    int maxId = -1;
+    for (size_t i = 0; i < enemies.size(); ++i)
+    {
+        maxId = std::max(maxId, enemies.idAt(i));
+    }
+    std::vector<uint8_t> inRange(static_cast<size_t>(maxId + 1), 0); // By track ID
+    size_t inRangeCount = 0;
+    // Reported tracks, stepped with moveAll's arithmetic so their reports match the
+    // tick core's exactly: position and the tick it is at, by track ID (-1 not yet)
+    std::vector<Position> stepped(static_cast<size_t>(maxId + 1));
+    std::vector<long> steppedTick(static_cast<size_t>(maxId + 1), -1);
+
+    // Every track's events are known up front from its straight-line flight
+    // (tick mode sees a threat once distance < range, engages once distance <= threshold)
+    events.clear();
+    events.reserve(enemies.size() * 3);
+    for (size_t i = 0; i < enemies.size(); ++i)
+    {
+        int id = enemies.idAt(i);
+
+        // Counted in moveAll's own steps, so each event fires on the tick the
+        // tick core would see it; at the earliest the next tick
+        auto schedule = [&](long steps, SimEventType type)
+        {
+            if (steps >= 0)
+            {
+                events.schedule(startTick + std::max(1L, steps), type, id);
+            }
+        };
+        schedule(enemies.stepsUntilWithin(i, DetectionSystem::THREAT_RANGE, false, ticks), SimEventType::EnterThreatRange);
+        schedule(enemies.stepsUntilWithin(i, threshold, true, ticks), SimEventType::CrossInterceptThreshold);
+        schedule(enemies.stepsUntilWithin(i, 0.0, true, ticks), SimEventType::Impact);
+    }
+
+    auto scheduleArrival = [&](const Missile &missile, long now)
+    {
+        events.schedule(now + missile.getFlightSteps() - missile.getFlightStep(),
+                        SimEventType::InterceptorArrival, missile.getTargetEnemyId());
+    };
+    for (const Missile &missile : controller.getInFlightMissiles())
+    {
+        scheduleArrival(missile, startTick);
+    }
+
+    auto removeTrack = [&](int id)
+    {
+        if (!enemies.removeById(id))
+        {
+            return false;
+        }
+        if (inRange[id])
+        {
+            inRange[id] = 0;
+            --inRangeCount;
+        }
+        return true;
+    };
+
+    std::vector<int> eligible; // Within the threshold and not yet engaged
+    std::vector<int> impacted;
+    std::vector<ThreatReport> reports;
+    long now = startTick;
+
+    while (!events.empty() && events.next().tick <= endTick && !enemies.empty())
+    {
+        long tick = events.next().tick;
+        long elapsed = tick - now;
+
+        // Nothing changed on the ticks skipped over
+        stats.trackSteps += enemies.size() * elapsed;
+        stats.threatReports += inRangeCount * (elapsed - 1);
+
+        for (const Missile &arrived : controller.updateFlights(static_cast<int>(elapsed)))
+        {
+            if (removeTrack(arrived.getTargetEnemyId()))
+            {
+                ++stats.enemiesDestroyed;
+            }
+        }
+
+        impacted.clear();
+        while (!events.empty() && events.next().tick == tick)
+        {
+            SimEvent event = events.pop();
+            ++stats.eventsProcessed;
+
+            bool trackEvent = event.type == SimEventType::EnterThreatRange ||
+                              event.type == SimEventType::CrossInterceptThreshold ||
+                              event.type == SimEventType::Impact;
+            if (trackEvent && !enemies.contains(event.id))
+            {
+                continue; // Destroyed before it got there
+            }
+
+            switch (event.type)
+            {
+            case SimEventType::EnterThreatRange:
+                inRange[event.id] = 1;
+                ++inRangeCount;
+                break;
+            case SimEventType::CrossInterceptThreshold:
+                eligible.push_back(event.id);
+                break;
+            case SimEventType::Impact:
+                impacted.push_back(event.id);
+                break;
+            default:
+                break; // Arrivals and retries only wake the core up
+            }
+        }
+
+        // The radar still reports impacting tracks on their last tick
+        stats.threatReports += inRangeCount;
+        for (int id : impacted)
+        {
+            if (removeTrack(id))
+            {
+                ++stats.impacts;
+            }
+        }
+
+        eligible.erase(std::remove_if(eligible.begin(), eligible.end(), [&](int id)
+                                      { return !enemies.contains(id) || controller.isEnemyEngaged(id); }),
+                       eligible.end());
+
+        if (!eligible.empty() && controller.canAutoIntercept())
+        {
+            reports.clear();
+            for (int id : eligible)
+            {
+                size_t index = static_cast<size_t>(enemies.indexOf(id));
+                if (steppedTick[id] < 0)
+                {
+                    stepped[id] = enemies.positionAt(index);
+                    steppedTick[id] = startTick;
+                }
+                stepped[id] = enemies.stepAlong(index, stepped[id], tick - steppedTick[id]);
+                steppedTick[id] = tick;
+                reports.push_back(radar.reportAt(index, stepped[id]));
+            }
+
+            stats.interceptsLaunched += controller.autoInterceptThreats(reports).size();
+            for (const Missile &missile : controller.getInFlightMissiles())
+            {
+                if (missile.getFlightStep() == 0)
+                {
+                    scheduleArrival(missile, tick); // Launched just now
+                }
+            }
+
+            eligible.erase(std::remove_if(eligible.begin(), eligible.end(), [&](int id)
+                                          { return controller.isEnemyEngaged(id); }),
+                           eligible.end());
+            if (!eligible.empty() && controller.canAutoIntercept())
+            {
+                events.schedule(tick + 1, SimEventType::EngagementRetry);
+            }
+        }
+
+        now = tick;
+    }
+
+    // Ran out of events (or hit the horizon) with tracks left: idle to the end
+    if (!enemies.empty() && now < endTick)
+    {
+        long elapsed = endTick - now;
+        stats.trackSteps += enemies.size() * elapsed;
+        stats.threatReports += inRangeCount * elapsed;
+        controller.updateFlights(static_cast<int>(elapsed));
+        now = endTick;
+    }
+
+    enemies.advanceAll(now - startTick);
+    stats.ticks = now;
+    events.clear();
+    stats.elapsedSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+
+    controller.setAutoIntercept(wasAutoIntercept);
+    controller.setVerbose(wasVerbose);
+    return statsSince(before);
+}
+
+SimulationStats Simulation::statsSince(const SimulationStats &before) const
+{
+    SimulationStats run;
+    run.ticks = stats.ticks - before.ticks;
+    run.trackSteps = stats.trackSteps - before.trackSteps;
+    run.threatReports = stats.threatReports - before.threatReports;
+    run.interceptsLaunched = stats.interceptsLaunched - before.interceptsLaunched;
+    run.enemiesDestroyed = stats.enemiesDestroyed - before.enemiesDestroyed;
+    run.impacts = stats.impacts - before.impacts;
+    run.eventsProcessed = stats.eventsProcessed - before.eventsProcessed;
+    run.elapsedSeconds = stats.elapsedSeconds - before.elapsedSeconds;
+    return run;
+}
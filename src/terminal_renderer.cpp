@@ -0,0 +1,267 @@
+#include "terminal_renderer.h"
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <cerrno>
+
+namespace
+{
+    // Decodes one UTF-8 sequence starting at text[i] and advances i
+    uint32_t decodeUtf8(const std::string &text, size_t &i)
+    {
+        unsigned char lead = static_cast<unsigned char>(text[i++]);
+        int extra = 0;
+        uint32_t codepoint = lead;
+
+        if (lead >= 0xF0)
+        {
+            codepoint = lead & 0x07;
+            extra = 3;
+        }
+        else if (lead >= 0xE0)
+        {
+            codepoint = lead & 0x0F;
+            extra = 2;
+        }
+        else if (lead >= 0xC0)
+        {
+            codepoint = lead & 0x1F;
+            extra = 1;
+        }
+
+        for (; extra > 0 && i < text.size(); --extra)
+        {
+            codepoint = (codepoint << 6) | (static_cast<unsigned char>(text[i++]) & 0x3F);
+        }
+        return codepoint;
+    }
+
+    // Terminal column width of a codepoint; only covers the glyphs this program draws
+    int glyphWidth(uint32_t codepoint)
+    {
+        // Variation selectors, zero-width joiner and combining marks
+        if ((codepoint >= 0xFE00 && codepoint <= 0xFE0F) || codepoint == 0x200D ||
+            (codepoint >= 0x0300 && codepoint <= 0x036F))
+        {
+            return 0;
+        }
+        // Emoji and CJK ranges render double width
+        if ((codepoint >= 0x1F300 && codepoint <= 0x1FAFF) ||
+            codepoint == 0x2705 || codepoint == 0x274C || codepoint == 0x26A0 ||
+            (codepoint >= 0x1100 && codepoint <= 0x115F) ||
+            (codepoint >= 0x2E80 && codepoint <= 0xA4CF) ||
+            (codepoint >= 0xAC00 && codepoint <= 0xD7A3) ||
+            (codepoint >= 0xF900 && codepoint <= 0xFAFF) ||
+            (codepoint >= 0xFF00 && codepoint <= 0xFF60))
+        {
+            return 2;
+        }
+        return 1;
+    }
+}
+
+TerminalRenderer::TerminalRenderer(int fd) : fd(fd)
+{
+}
+
+void TerminalRenderer::beginFrame()
+{
+    int newRows = 24;
+    int newCols = 80;
+    winsize size{};
+    if (ioctl(fd, TIOCGWINSZ, &size) == 0 && size.ws_row > 0 && size.ws_col > 0)
+    {
+        newRows = size.ws_row;
+        newCols = size.ws_col;
+    }
+
+    if (newRows != rows || newCols != cols)
+    {
+        rows = newRows;
+        cols = newCols;
+        front.assign(static_cast<size_t>(rows) * cols, Cell());
+        frontValid = false;
+    }
+    back.assign(static_cast<size_t>(rows) * cols, Cell());
+}
+
+int TerminalRenderer::print(int row, int col, const std::string &text, Style style)
+{
+    if (row < 0 || row >= rows)
+    {
+        return col;
+    }
+
+    size_t i = 0;
+    while (i < text.size() && col < cols)
+    {
+        uint32_t codepoint = decodeUtf8(text, i);
+        int width = glyphWidth(codepoint);
+        if (width == 0 || col < 0)
+        {
+            col += width;
+            continue;
+        }
+        // A wide glyph that doesn't fit in the last column is dropped
+        if (col + width > cols)
+        {
+            break;
+        }
+
+        // Overwriting half of an existing wide glyph blanks its other half
+        size_t index = static_cast<size_t>(row) * cols + col;
+        if (back[index].codepoint == 0 && col > 0)
+        {
+            back[index - 1].codepoint = ' ';
+        }
+        size_t end = index + width;
+        if (end < back.size() && col + width < cols && back[end].codepoint == 0)
+        {
+            back[end].codepoint = ' ';
+        }
+
+        Cell &cell = back[index];
+        cell.codepoint = codepoint;
+        cell.style = style;
+        if (width == 2)
+        {
+            Cell &tail = back[index + 1];
+            tail.codepoint = 0;
+            tail.style = style;
+        }
+        col += width;
+    }
+    return col;
+}
+
+void TerminalRenderer::invalidate()
+{
+    frontValid = false;
+}
+
+bool TerminalRenderer::sameCell(const Cell &a, const Cell &b)
+{
+    return a.codepoint == b.codepoint && a.style.color == b.style.color && a.style.bold == b.style.bold;
+}
+
+void TerminalRenderer::appendStyle(Style style)
+{
+    static const char *const colorCodes[] = {"", ";31", ";32", ";33", ";34", ";35", ";36"};
+    output += "\033[0";
+    if (style.bold)
+    {
+        output += ";1";
+    }
+    output += colorCodes[static_cast<int>(style.color)];
+    output += 'm';
+}
+
+void TerminalRenderer::appendCodepoint(uint32_t codepoint)
+{
+    if (codepoint < 0x80)
+    {
+        output += static_cast<char>(codepoint);
+    }
+    else if (codepoint < 0x800)
+    {
+        output += static_cast<char>(0xC0 | (codepoint >> 6));
+        output += static_cast<char>(0x80 | (codepoint & 0x3F));
+    }
+    else if (codepoint < 0x10000)
+    {
+        output += static_cast<char>(0xE0 | (codepoint >> 12));
+        output += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+        output += static_cast<char>(0x80 | (codepoint & 0x3F));
+    }
+    else
+    {
+        output += static_cast<char>(0xF0 | (codepoint >> 18));
+        output += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+        output += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+        output += static_cast<char>(0x80 | (codepoint & 0x3F));
+    }
+}
+
+void TerminalRenderer::present()
+{
+    output.clear();
+
+    if (!frontValid)
+    {
+        // Unknown screen contents: clear it and treat every cell as changed
+        output += "\033[0m\033[2J";
+        front.assign(back.size(), Cell());
+        for (Cell &cell : front)
+        {
+            cell.codepoint = 0xFFFFFFFF;
+        }
+    }
+
+    Style currentStyle;
+    bool styleKnown = false;
+
+    for (int row = 0; row < rows; ++row)
+    {
+        int cursorCol = -1; // Column the terminal cursor sits at, -1 if unknown
+        size_t rowStart = static_cast<size_t>(row) * cols;
+
+        for (int col = 0; col < cols; ++col)
+        {
+            const Cell &cell = back[rowStart + col];
+            if (cell.codepoint == 0 || sameCell(cell, front[rowStart + col]))
+            {
+                continue;
+            }
+
+            // A glyph whose right half changed is redrawn through its left half, which is skipped above
+            if (cursorCol != col)
+            {
+                output += "\033[";
+                output += std::to_string(row + 1);
+                output += ';';
+                output += std::to_string(col + 1);
+                output += 'H';
+            }
+            if (!styleKnown || cell.style.color != currentStyle.color || cell.style.bold != currentStyle.bold)
+            {
+                appendStyle(cell.style);
+                currentStyle = cell.style;
+                styleKnown = true;
+            }
+            appendCodepoint(cell.codepoint);
+
+            bool wide = col + 1 < cols && back[rowStart + col + 1].codepoint == 0;
+            cursorCol = col + (wide ? 2 : 1);
+        }
+    }
+
+    if (!output.empty())
+    {
+        // Park the cursor at the bottom left so stray output doesn't land mid-frame
+        output += "\033[0m\033[";
+        output += std::to_string(rows);
+        output += ";1H";
+    }
+
+    front = back;
+    frontValid = true;
+    lastPresentBytes = output.size();
+    writeOutput();
+}
+
+void TerminalRenderer::writeOutput()
+{
+    size_t written = 0;
+    while (written < output.size())
+    {
+        ssize_t result = ::write(fd, output.data() + written, output.size() - written);
+        if (result < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return;
+        }
+        written += static_cast<size_t>(result);
+    }
+}
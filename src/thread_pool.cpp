@@ -0,0 +1,106 @@
+#include "thread_pool.h"
+
+ThreadPool::ThreadPool(size_t workerCount)
+{
+    size_t background = workerCount > 1 ? workerCount - 1 : 0;
+    threads.reserve(background);
+    for (size_t i = 0; i < background; ++i)
+    {
+        threads.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+}
+
+void ThreadPool::run(size_t chunkCount, TaskFn task, void *context)
+{
+    if (chunkCount == 0)
+    {
+        return;
+    }
+
+    // Nothing to share the work with, stay on this thread
+    if (threads.empty() || chunkCount == 1)
+    {
+        for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+        {
+            task(context, chunk);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        currentTask = task;
+        currentContext = context;
+        chunkTotal = chunkCount;
+        nextChunk = 0;
+        chunksDone = 0;
+        ++generation;
+    }
+    wake.notify_all();
+
+    runChunks();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this]() { return chunksDone == chunkTotal; });
+    currentTask = nullptr;
+    currentContext = nullptr;
+}
+
+void ThreadPool::workerLoop()
+{
+    unsigned long seenGeneration = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&]() { return stopping || generation != seenGeneration; });
+            if (stopping)
+            {
+                return;
+            }
+            seenGeneration = generation;
+        }
+        runChunks();
+    }
+}
+
+void ThreadPool::runChunks()
+{
+    while (true)
+    {
+        size_t chunk;
+        TaskFn task;
+        void *context;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (currentTask == nullptr || nextChunk >= chunkTotal)
+            {
+                return;
+            }
+            chunk = nextChunk++;
+            task = currentTask;
+            context = currentContext;
+        }
+
+        task(context, chunk);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (++chunksDone == chunkTotal)
+        {
+            finished.notify_one();
+        }
+    }
+}
@@ -0,0 +1,60 @@
+#include "tick_arena.h"
+#include <algorithm>
+
+namespace
+{
+    const size_t BLOCK_GRANULE = 4096;
+}
+
+TickArena::TickArena(size_t initialBytes)
+    : block(new std::byte[std::max(initialBytes, BLOCK_GRANULE)]), capacity(std::max(initialBytes, BLOCK_GRANULE))
+{
+}
+
+size_t TickArena::getHighWater() const
+{
+    return std::max(highWater, getUsed());
+}
+
+void *TickArena::do_allocate(size_t bytes, size_t alignment)
+{
+    uintptr_t base = reinterpret_cast<uintptr_t>(block.get());
+    size_t start = static_cast<size_t>(((base + offset + alignment - 1) & ~(uintptr_t(alignment) - 1)) - base);
+    if (start + bytes <= capacity)
+    {
+        offset = start + bytes;
+        return block.get() + start;
+    }
+
+    spilledBytes += bytes;
+    return spill.allocate(bytes, alignment);
+}
+
+void TickArena::reset()
+{
+    highWater = getHighWater();
+    ++resets;
+
+    if (spilledBytes > 0)
+    {
+        // Regrow with headroom so a slowly growing workload doesn't spill every tick
+        ++overflows;
+        spill.release();
+        size_t wanted = highWater + highWater / 2;
+        capacity = (wanted + BLOCK_GRANULE - 1) / BLOCK_GRANULE * BLOCK_GRANULE;
+        block.reset(new std::byte[capacity]);
+    }
+
+    offset = 0;
+    spilledBytes = 0;
+}
+
+void TickArena::reserve(size_t bytes)
+{
+    reset();
+    if (bytes > capacity)
+    {
+        capacity = (bytes + BLOCK_GRANULE - 1) / BLOCK_GRANULE * BLOCK_GRANULE;
+        block.reset(new std::byte[capacity]);
+    }
+}
@@ -0,0 +1,306 @@
+#include "tick_pipeline.h"
+#include "tick_recorder.h"
+#include "world_publisher.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+    // Frames buffered between stages: minutes of slack at live view tick rates
+    const size_t FRAME_QUEUE_CAPACITY = 256;
+    const size_t KILL_QUEUE_CAPACITY = 4096;
+    const size_t COMMAND_QUEUE_CAPACITY = 256;
+    const auto IDLE_WAIT = std::chrono::milliseconds(1);
+}
+
+TickPipeline::TickPipeline(Simulation &sim, std::chrono::milliseconds tickInterval)
+    : sim(sim), tickInterval(tickInterval), sensorFrames(FRAME_QUEUE_CAPACITY),
+      worldFrames(FRAME_QUEUE_CAPACITY), kills(KILL_QUEUE_CAPACITY),
+      commands(COMMAND_QUEUE_CAPACITY), results(COMMAND_QUEUE_CAPACITY)
+{
+}
+
+TickPipeline::~TickPipeline()
+{
+    stop();
+}
+
+void TickPipeline::start()
+{
+    if (running.exchange(true))
+    {
+        return;
+    }
+    lastEngagedTick = sim.getStats().ticks;
+    sensorThread = std::thread(&TickPipeline::runSensor, this);
+    engagementThread = std::thread(&TickPipeline::runEngagement, this);
+}
+
+void TickPipeline::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(stopMutex);
+        if (!running.exchange(false))
+        {
+            return;
+        }
+    }
+    stopSignal.notify_all();
+    sensorThread.join();
+    engagementThread.join();
+
+    int id;
+    while (kills.tryPop(id))
+    {
+        unsentKills.push_back(id);
+    }
+    sim.removeDestroyed(unsentKills);
+    unsentKills.clear();
+
+    poll();
+    std::shared_ptr<const SensorFrame> unengaged;
+    while (sensorFrames.tryPop(unengaged))
+    {
+    }
+    OperatorCommand unapplied;
+    while (commands.tryPop(unapplied))
+    {
+    }
+    if (TickRecorder *recorder = sim.getRecorder())
+    {
+        recorder->requestKeyframe();
+    }
+}
+
+void TickPipeline::runSensor()
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<int> destroyed;
+    bool gap = false;
+    auto nextTick = Clock::now();
+
+    while (running.load(std::memory_order_acquire))
+    {
+        if (paused.load(std::memory_order_acquire))
+        {
+            std::unique_lock<std::mutex> lock(stopMutex);
+            stopSignal.wait(lock, [this]
+                            { return !running.load(std::memory_order_acquire) ||
+                                     !paused.load(std::memory_order_acquire) || pendingSteps > 0; });
+            if (!running.load(std::memory_order_acquire))
+            {
+                break;
+            }
+            if (paused.load(std::memory_order_acquire))
+            {
+                --pendingSteps;
+            }
+            nextTick = Clock::now(); // No catching up on the ticks spent paused
+        }
+
+        destroyed.clear();
+        int id;
+        while (kills.tryPop(id))
+        {
+            destroyed.push_back(id);
+        }
+
+        const std::vector<ThreatReport> &threats = sim.senseTick(destroyed);
+
+        auto frame = std::make_shared<SensorFrame>();
+        frame->tick = sim.getStats().ticks;
+        frame->afterGap = gap;
+        frame->tracks = sim.getEnemies();
+        frame->threats = threats;
+        sim.getEnemies().clearJournal(); // The frame owns this tick's changes now
+
+        gap = !sensorFrames.tryPush(std::move(frame));
+        if (gap)
+        {
+            droppedFrames.fetch_add(1, std::memory_order_relaxed);
+        }
+        sensorTicks.fetch_add(1, std::memory_order_relaxed);
+
+        nextTick += tickInterval;
+        std::unique_lock<std::mutex> lock(stopMutex);
+        stopSignal.wait_until(lock, nextTick, [this]
+                              { return !running.load(std::memory_order_acquire); });
+    }
+}
+
+void TickPipeline::runEngagement()
+{
+    std::shared_ptr<const SensorFrame> sensor;
+    std::vector<ThreatReport> threats;
+    std::vector<int> destroyed;
+    std::vector<int> pendingKills; // Sorted, hit but maybe not yet removed by the sensor
+    bool gap = false;
+
+    while (running.load(std::memory_order_acquire))
+    {
+        if (!sensorFrames.tryPop(sensor))
+        {
+            // Between ticks: the controller is idle and the last engaged picture current
+            applyCommands(threats);
+            std::this_thread::sleep_for(IDLE_WAIT);
+            continue;
+        }
+
+        // Decide on the newest picture only: when engagement falls behind, the
+        // frames it never got to are skipped rather than answered late
+        std::shared_ptr<const SensorFrame> newer;
+        while (sensorFrames.tryPop(newer))
+        {
+            sensor = std::move(newer);
+            gap = true;
+            droppedFrames.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // A kill sent after the sensor started this tick still shows up here,
+        // it must not be engaged a second time. Gone from the frame = removed.
+        pendingKills.erase(std::remove_if(pendingKills.begin(), pendingKills.end(), [&](int id)
+                                          { return std::none_of(sensor->threats.begin(), sensor->threats.end(),
+                                                                [id](const ThreatReport &threat)
+                                                                { return threat.enemyId == id; }); }),
+                           pendingKills.end());
+        threats.clear();
+        for (const ThreatReport &threat : sensor->threats)
+        {
+            if (!std::binary_search(pendingKills.begin(), pendingKills.end(), threat.enemyId))
+            {
+                threats.push_back(threat);
+            }
+        }
+
+        applyCommands(threats);
+        destroyed.clear();
+        // Flights keep pace with the sensor even across dropped frames
+        sim.engageTick(threats, destroyed, static_cast<int>(sensor->tick - lastEngagedTick));
+        lastEngagedTick = sensor->tick;
+        for (int id : destroyed)
+        {
+            unsentKills.push_back(id);
+            pendingKills.insert(std::lower_bound(pendingKills.begin(), pendingKills.end(), id), id);
+        }
+        size_t sent = 0;
+        while (sent < unsentKills.size() && kills.tryPush(unsentKills[sent]))
+        {
+            ++sent;
+        }
+        unsentKills.erase(unsentKills.begin(), unsentKills.begin() + sent);
+
+        const MissileController &controller = sim.getController();
+        auto frame = std::make_shared<WorldFrame>();
+        frame->sensor = std::move(sensor);
+        frame->afterGap = gap || frame->sensor->afterGap;
+        frame->threats = threats;
+        frame->inventory = controller.getMissiles();
+        frame->inFlight = controller.getInFlightMissiles();
+        frame->autoIntercept = controller.isAutoInterceptEnabled();
+        frame->autoInterceptThreshold = controller.getAutoInterceptThreshold();
+        frame->assignmentMode = controller.getAssignmentMode();
+
+        gap = !worldFrames.tryPush(std::move(frame));
+        if (gap)
+        {
+            droppedFrames.fetch_add(1, std::memory_order_relaxed);
+        }
+        engagedTicks.fetch_add(1, std::memory_order_relaxed);
+
+        // Commands until the next frame must not go after what this tick hit
+        threats.erase(std::remove_if(threats.begin(), threats.end(), [&](const ThreatReport &threat)
+                                     { return std::binary_search(pendingKills.begin(), pendingKills.end(), threat.enemyId); }),
+                      threats.end());
+    }
+}
+
+void TickPipeline::applyCommands(const std::vector<ThreatReport> &threats)
+{
+    OperatorCommand command;
+    while (commands.tryPop(command))
+    {
+        CommandResult result = {command.client, std::string()};
+        try
+        {
+            result.text = sim.applyCommand(command, threats);
+            result.text = command.type == OperatorCommand::Type::Status
+                              ? std::string(isPaused() ? "PAUSED" : "OPERATIONAL") + "  tick " +
+                                    std::to_string(lastEngagedTick) + ", " + result.text
+                              : "ok: " + result.text;
+        }
+        catch (const std::invalid_argument &error)
+        {
+            result.text = std::string("error: ") + error.what();
+        }
+        unsentResults.push_back(std::move(result));
+    }
+
+    size_t sent = 0;
+    while (sent < unsentResults.size() && results.tryPush(unsentResults[sent]))
+    {
+        ++sent;
+    }
+    unsentResults.erase(unsentResults.begin(), unsentResults.begin() + sent);
+}
+
+std::shared_ptr<const TickPipeline::WorldFrame> TickPipeline::poll()
+{
+    TickRecorder *recorder = sim.getRecorder();
+    WorldPublisher *publisher = sim.getPublisher();
+    std::shared_ptr<const WorldFrame> frame;
+    while (worldFrames.tryPop(frame))
+    {
+        if (recorder)
+        {
+            NORAD_PROFILE_PHASE(sim.getProfiler(), TickPhase::Record);
+            if (frame->afterGap)
+            {
+                recorder->requestKeyframe();
+            }
+            recorder->recordTick(frame->sensor->tick, frame->sensor->tracks, frame->inventory, frame->inFlight);
+        }
+        if (publisher)
+        {
+            NORAD_PROFILE_PHASE(sim.getProfiler(), TickPhase::Publish);
+            publisher->publish(frame->sensor->tick, frame->sensor->tracks, frame->threats, frame->inventory, frame->inFlight);
+        }
+        latest = std::move(frame);
+    }
+    return latest;
+}
+
+std::vector<TickPipeline::CommandResult> TickPipeline::takeResults()
+{
+    std::vector<CommandResult> taken;
+    CommandResult result;
+    while (results.tryPop(result))
+    {
+        taken.push_back(std::move(result));
+    }
+    return taken;
+}
+
+bool TickPipeline::submit(const OperatorCommand &command)
+{
+    return commands.tryPush(command);
+}
+
+void TickPipeline::setPaused(bool pause)
+{
+    {
+        std::lock_guard<std::mutex> lock(stopMutex);
+        paused.store(pause, std::memory_order_release);
+        pendingSteps = 0;
+    }
+    stopSignal.notify_all();
+}
+
+void TickPipeline::step()
+{
+    {
+        std::lock_guard<std::mutex> lock(stopMutex);
+        ++pendingSteps;
+    }
+    stopSignal.notify_all();
+}
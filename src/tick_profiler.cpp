@@ -0,0 +1,121 @@
+#include "tick_profiler.h"
+#include <cmath>
+#include <iomanip>
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t bucket)
+{
+    if (bucket < SUB_BUCKETS)
+    {
+        return bucket;
+    }
+    // Inverse of bucketOf: row r >= 1 covers [2^(r+4), 2^(r+5)) in steps of 2^(r-1)
+    size_t row = bucket / SUB_BUCKETS;
+    size_t sub = bucket % SUB_BUCKETS;
+    int shift = static_cast<int>(row) - 1;
+    return ((static_cast<uint64_t>(SUB_BUCKETS + sub + 1)) << shift) - 1;
+}
+
+uint64_t LatencyHistogram::percentile(double quantile) const
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    uint64_t wanted = static_cast<uint64_t>(std::ceil(quantile * static_cast<double>(count)));
+    wanted = wanted < 1 ? 1 : (wanted > count ? count : wanted);
+
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < BUCKET_COUNT; ++bucket)
+    {
+        seen += counts[bucket];
+        if (seen >= wanted)
+        {
+            uint64_t bound = bucketUpperBound(bucket);
+            return bound < max ? bound : max;
+        }
+    }
+    return max;
+}
+
+void LatencyHistogram::reset()
+{
+    counts.fill(0);
+    count = 0;
+    sum = 0;
+    min = UINT64_MAX;
+    max = 0;
+}
+
+const char *tickPhaseName(TickPhase phase)
+{
+    switch (phase)
+    {
+    case TickPhase::Move:
+        return "move";
+    case TickPhase::Flights:
+        return "flights";
+    case TickPhase::Scan:
+        return "scan";
+    case TickPhase::AutoIntercept:
+        return "auto_intercept";
+    case TickPhase::Render:
+        return "render";
+    case TickPhase::Record:
+        return "record";
+    case TickPhase::Publish:
+        return "publish";
+    case TickPhase::Tick:
+        return "tick";
+    default:
+        return "unknown";
+    }
+}
+
+void TickProfiler::reset()
+{
+    for (auto &histogram : phases)
+    {
+        histogram.reset();
+    }
+}
+
+void TickProfiler::print(std::ostream &out) const
+{
+    out << std::left << std::setw(16) << "Phase" << std::right
+        << std::setw(10) << "Count" << std::setw(12) << "p50 us" << std::setw(12) << "p99 us"
+        << std::setw(12) << "p999 us" << std::setw(12) << "max us" << "\n";
+
+    std::ios::fmtflags flags = out.flags();
+    out << std::fixed << std::setprecision(1);
+    for (size_t i = 0; i < phases.size(); ++i)
+    {
+        const LatencyHistogram &histogram = phases[i];
+        out << std::left << std::setw(16) << tickPhaseName(static_cast<TickPhase>(i)) << std::right
+            << std::setw(10) << histogram.getCount()
+            << std::setw(12) << histogram.percentile(0.50) / 1000.0
+            << std::setw(12) << histogram.percentile(0.99) / 1000.0
+            << std::setw(12) << histogram.percentile(0.999) / 1000.0
+            << std::setw(12) << histogram.getMax() / 1000.0 << "\n";
+    }
+    out.flags(flags);
+}
+
+void TickProfiler::writeJson(std::ostream &out) const
+{
+    out << "{\n  \"enabled\": " << (ENABLED ? "true" : "false") << ",\n  \"phases\": {";
+    for (size_t i = 0; i < phases.size(); ++i)
+    {
+        const LatencyHistogram &histogram = phases[i];
+        out << (i == 0 ? "\n" : ",\n")
+            << "    \"" << tickPhaseName(static_cast<TickPhase>(i)) << "\": {"
+            << "\"count\": " << histogram.getCount()
+            << ", \"min_ns\": " << histogram.getMin()
+            << ", \"mean_ns\": " << static_cast<uint64_t>(histogram.getMean())
+            << ", \"p50_ns\": " << histogram.percentile(0.50)
+            << ", \"p99_ns\": " << histogram.percentile(0.99)
+            << ", \"p999_ns\": " << histogram.percentile(0.999)
+            << ", \"max_ns\": " << histogram.getMax() << "}";
+    }
+    out << "\n  }\n}\n";
+}
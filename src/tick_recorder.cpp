@@ -0,0 +1,658 @@
+#include "tick_recorder.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+using namespace tick_log;
+
+namespace
+{
+    uint64_t zigzag(int64_t value)
+    {
+        return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    }
+
+    int64_t unzigzag(uint64_t value)
+    {
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    uint8_t *writeVarint(uint8_t *out, uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            *out++ = static_cast<uint8_t>(value) | 0x80;
+            value >>= 7;
+        }
+        *out++ = static_cast<uint8_t>(value);
+        return out;
+    }
+
+    const size_t MAX_VARINT_BYTES = 10;
+
+    // Frame header on disk: type, tick, payload size
+    const size_t FRAME_HEADER_BYTES = 1 + 8 + 4;
+
+    // Bounds-checked cursor over one frame payload
+    class ByteReader
+    {
+    public:
+        ByteReader(const uint8_t *data, const uint8_t *end) : data(data), end(end) {}
+
+        uint64_t varint()
+        {
+            uint64_t value = 0;
+            for (int shift = 0; shift < 64; shift += 7)
+            {
+                need(1);
+                uint8_t byte = *data++;
+                value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+                if (!(byte & 0x80))
+                {
+                    return value;
+                }
+            }
+            throw std::runtime_error("replay log: malformed varint");
+        }
+
+        int64_t signedVarint() { return unzigzag(varint()); }
+
+        double f64()
+        {
+            need(sizeof(double));
+            double value;
+            std::memcpy(&value, data, sizeof(value));
+            data += sizeof(value);
+            return value;
+        }
+
+        Position position() { return {f64(), f64(), f64()}; }
+
+        std::string string()
+        {
+            uint64_t length = varint();
+            need(length);
+            std::string text(reinterpret_cast<const char *>(data), static_cast<size_t>(length));
+            data += length;
+            return text;
+        }
+
+    private:
+        const uint8_t *data;
+        const uint8_t *end;
+
+        void need(uint64_t bytes) const
+        {
+            if (bytes > static_cast<uint64_t>(end - data))
+            {
+                throw std::runtime_error("replay log: truncated frame");
+            }
+        }
+    };
+}
+
+// ---------------------------------------------------------------------------
+// TickRecorder
+
+TickRecorder::TickRecorder(const std::string &path, const std::vector<Target> &targets,
+                           const MissileController &controller, int keyframeInterval)
+    : out(path, std::ios::binary | std::ios::trunc), path(path), keyframeInterval(std::max(keyframeInterval, 1))
+{
+    if (!out)
+    {
+        throw std::runtime_error(path + ": cannot open for writing");
+    }
+
+    used = 0;
+    uint32_t version = VERSION;
+    out.write(MAGIC, sizeof(MAGIC));
+    out.write(reinterpret_cast<const char *>(&version), sizeof(version));
+
+    // Targets and the interceptor catalog: everything a replay needs besides the frames
+    putVarint(targets.size());
+    for (const auto &target : targets)
+    {
+        putSigned(target.id);
+        putVarint(target.name.size());
+        std::memcpy(reserve(target.name.size()), target.name.data(), target.name.size());
+        used += target.name.size();
+        putDouble(target.location.latitude);
+        putDouble(target.location.longitude);
+        putDouble(target.location.altitude);
+        putDouble(target.position.x);
+        putDouble(target.position.y);
+        putDouble(target.position.z);
+    }
+
+    const std::vector<Missile> &inventory = controller.getMissiles();
+    const std::vector<Missile> &inFlight = controller.getInFlightMissiles();
+    putVarint(inventory.size() + inFlight.size());
+    for (const auto *list : {&inventory, &inFlight})
+    {
+        for (const auto &missile : *list)
+        {
+            std::string_view name = missile.getName();
+            Position position = missile.isInFlight() ? missile.getLaunchPosition() : missile.getCurrentPosition();
+            putSigned(missile.getId());
+            putSigned(missile.getDamage());
+            putVarint(name.size());
+            std::memcpy(reserve(name.size()), name.data(), name.size());
+            used += name.size();
+            putDouble(missile.getSpeed());
+            putDouble(position.x);
+            putDouble(position.y);
+            putDouble(position.z);
+        }
+    }
+
+    uint32_t headerBytes = static_cast<uint32_t>(used);
+    out.write(reinterpret_cast<const char *>(&headerBytes), sizeof(headerBytes));
+    out.write(reinterpret_cast<const char *>(payload.data()), static_cast<std::streamsize>(used));
+    bytesWritten = sizeof(MAGIC) + sizeof(version) + sizeof(headerBytes) + used;
+    if (!out)
+    {
+        throw std::runtime_error(path + ": write failed");
+    }
+}
+
+uint8_t *TickRecorder::reserve(size_t bytes)
+{
+    if (payload.size() < used + bytes)
+    {
+        payload.resize(std::max(used + bytes, payload.size() * 2));
+    }
+    return payload.data() + used;
+}
+
+void TickRecorder::putVarint(uint64_t value)
+{
+    used = writeVarint(reserve(MAX_VARINT_BYTES), value) - payload.data();
+}
+
+void TickRecorder::putSigned(int64_t value)
+{
+    putVarint(zigzag(value));
+}
+
+void TickRecorder::putDouble(double value)
+{
+    std::memcpy(reserve(sizeof(value)), &value, sizeof(value));
+    used += sizeof(value);
+}
+
+void TickRecorder::putPosition(const Position &position)
+{
+    putDouble(position.x);
+    putDouble(position.y);
+    putDouble(position.z);
+}
+
+void TickRecorder::putTrack(const TrackStore &enemies, long index)
+{
+    // A track added and removed again within one frame is written as a placeholder
+    bool live = index >= 0;
+    Position position = live ? enemies.positionAt(index) : Position{0.0, 0.0, 0.0};
+    Position target = live ? enemies.targetAt(index) : Position{0.0, 0.0, 0.0};
+    const double values[] = {position.x, position.y, position.z, target.x, target.y, target.z,
+                             live ? enemies.speedAt(index) : 0.0};
+
+    // One reservation per row, keyframes write 100k+ of these
+    uint8_t *cursor = reserve(2 * MAX_VARINT_BYTES + sizeof(values));
+    cursor = writeVarint(cursor, zigzag(live ? enemies.idAt(index) : -1));
+    std::memcpy(cursor, values, sizeof(values));
+    cursor = writeVarint(cursor + sizeof(values), zigzag(live ? enemies.targetIdAt(index) : -1));
+    used = cursor - payload.data();
+}
+
+void TickRecorder::recordTick(long tick, TrackStore &enemies, const MissileController &controller)
+{
+    recordTick(tick, static_cast<const TrackStore &>(enemies), controller.getMissiles(), controller.getInFlightMissiles());
+    enemies.clearJournal();
+}
+
+void TickRecorder::recordTick(long tick, const TrackStore &enemies,
+                              const std::vector<Missile> &inventory, const std::vector<Missile> &inFlight)
+{
+    // A store changed behind the journal's back (clear/adopt) can't be diffed
+    size_t expected = trackCount;
+    for (const auto &change : enemies.getJournal())
+    {
+        expected += change.removed ? -1 : 1;
+    }
+    bool inSync = framesWritten > 0 && expected == enemies.size();
+    bool keyframe = !inSync || keyframeRequested || framesWritten % keyframeInterval == 0;
+    keyframeRequested = false;
+
+    used = 0;
+    encodeTracks(enemies, keyframe);
+    encodeFlights(inventory, inFlight, keyframe);
+    writeFrame(keyframe ? FRAME_KEY : FRAME_DELTA, tick);
+    trackCount = enemies.size();
+}
+
+void TickRecorder::encodeTracks(const TrackStore &enemies, bool keyframe)
+{
+    if (keyframe)
+    {
+        // Every row in store order, exact positions included
+        size_t count = enemies.size();
+        putVarint(count);
+        reserve(count * (2 * MAX_VARINT_BYTES + 7 * sizeof(double)));
+        for (size_t i = 0; i < count; ++i)
+        {
+            putTrack(enemies, static_cast<long>(i));
+        }
+        return;
+    }
+
+    // Structural changes since the last frame, in order. Movement is left to
+    // the replayer's moveAll, so this is the whole per-tick cost.
+    const auto &journal = enemies.getJournal();
+    putVarint(journal.size());
+    for (const auto &change : journal)
+    {
+        if (change.removed)
+        {
+            putSigned(-static_cast<int64_t>(change.id) - 1);
+            continue;
+        }
+        putSigned(change.id);
+        putTrack(enemies, enemies.indexOf(change.id));
+    }
+}
+
+void TickRecorder::encodeFlights(const std::vector<Missile> &inventory, const std::vector<Missile> &inFlight,
+                                 bool keyframe)
+{
+    if (keyframe)
+    {
+        putVarint(inventory.size());
+        for (const auto &missile : inventory)
+        {
+            putSigned(missile.getId());
+        }
+    }
+
+    // New launches since the last frame carry their full flight plan (every one on a keyframe)
+    currentFlights.clear();
+    for (const auto &missile : inFlight)
+    {
+        currentFlights.push_back(missile.getId());
+    }
+    std::sort(currentFlights.begin(), currentFlights.end());
+
+    size_t launches = 0;
+    for (const auto &missile : inFlight)
+    {
+        if (keyframe || !std::binary_search(knownFlights.begin(), knownFlights.end(), missile.getId()))
+        {
+            ++launches;
+        }
+    }
+    putVarint(launches);
+    for (const auto &missile : inFlight)
+    {
+        if (keyframe || !std::binary_search(knownFlights.begin(), knownFlights.end(), missile.getId()))
+        {
+            putSigned(missile.getId());
+            putDouble(missile.getLaunchPosition().x);
+            putDouble(missile.getLaunchPosition().y);
+            putDouble(missile.getLaunchPosition().z);
+            putDouble(missile.getFlightTarget().x);
+            putDouble(missile.getFlightTarget().y);
+            putDouble(missile.getFlightTarget().z);
+            putSigned(missile.getTargetEnemyId());
+            putVarint(static_cast<uint64_t>(missile.getFlightSteps()));
+        }
+    }
+    knownFlights.swap(currentFlights);
+
+    // Where every interceptor in the air is along its path
+    putVarint(inFlight.size());
+    for (const auto &missile : inFlight)
+    {
+        putSigned(missile.getId());
+        putVarint(static_cast<uint64_t>(missile.getFlightStep()));
+    }
+}
+
+void TickRecorder::writeFrame(FrameType type, long tick)
+{
+    uint8_t header[FRAME_HEADER_BYTES];
+    int64_t tickValue = tick;
+    uint32_t size = static_cast<uint32_t>(used);
+    header[0] = type;
+    std::memcpy(header + 1, &tickValue, sizeof(tickValue));
+    std::memcpy(header + 9, &size, sizeof(size));
+
+    out.write(reinterpret_cast<const char *>(header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(payload.data()), static_cast<std::streamsize>(used));
+    if (!out)
+    {
+        throw std::runtime_error(path + ": write failed");
+    }
+    bytesWritten += sizeof(header) + used;
+    ++framesWritten;
+}
+
+// ---------------------------------------------------------------------------
+// TickReplayer
+
+TickReplayer::TickReplayer(const std::string &path)
+    : in(path, std::ios::binary), path(path), targets(readHeader()), radar(enemies, targets)
+{
+    controller.setVerbose(false);
+
+    // Index the frames by their headers only: keyframe offsets for seeking,
+    // the last tick for progress
+    firstFrameOffset = in.tellg();
+    in.seekg(0, std::ios::end);
+    std::streamoff fileEnd = in.tellg();
+    in.seekg(firstFrameOffset);
+
+    std::streamoff offset = firstFrameOffset;
+    uint8_t header[FRAME_HEADER_BYTES];
+    while (offset + static_cast<std::streamoff>(FRAME_HEADER_BYTES) <= fileEnd &&
+           in.read(reinterpret_cast<char *>(header), sizeof(header)))
+    {
+        int64_t tick;
+        uint32_t size;
+        std::memcpy(&tick, header + 1, sizeof(tick));
+        std::memcpy(&size, header + 9, sizeof(size));
+        std::streamoff frameEnd = offset + static_cast<std::streamoff>(FRAME_HEADER_BYTES) + size;
+        if (frameEnd > fileEnd || (header[0] != FRAME_KEY && header[0] != FRAME_DELTA))
+        {
+            break; // A recording cut short (crash, Ctrl+C) ends at its last complete frame
+        }
+        if (header[0] == FRAME_KEY)
+        {
+            keyframes.push_back({static_cast<long>(tick), offset});
+        }
+        lastTick = static_cast<long>(tick);
+        ++frameCount;
+        offset = frameEnd;
+        in.seekg(offset);
+    }
+    in.clear();
+    in.seekg(firstFrameOffset);
+}
+
+std::vector<Target> TickReplayer::readHeader()
+{
+    if (!in)
+    {
+        throw std::runtime_error(path + ": cannot open");
+    }
+
+    char magic[sizeof(MAGIC)];
+    uint32_t version = 0;
+    uint32_t headerBytes = 0;
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char *>(&version), sizeof(version));
+    in.read(reinterpret_cast<char *>(&headerBytes), sizeof(headerBytes));
+    if (!in || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0)
+    {
+        throw std::runtime_error(path + ": not a replay log");
+    }
+    if (version != VERSION)
+    {
+        throw std::runtime_error(path + ": unsupported replay log version " + std::to_string(version));
+    }
+
+    payload.resize(headerBytes);
+    in.read(reinterpret_cast<char *>(payload.data()), headerBytes);
+    if (!in)
+    {
+        throw std::runtime_error(path + ": truncated header");
+    }
+
+    ByteReader header(payload.data(), payload.data() + headerBytes);
+    std::vector<Target> targets;
+    uint64_t targetCount = header.varint();
+    for (uint64_t i = 0; i < targetCount; ++i)
+    {
+        Target target;
+        target.id = static_cast<int>(header.signedVarint());
+        target.name = header.string();
+        target.location.latitude = header.f64();
+        target.location.longitude = header.f64();
+        target.location.altitude = header.f64();
+        target.position = header.position();
+        targets.push_back(target);
+    }
+    uint64_t missileCount = header.varint();
+    for (uint64_t i = 0; i < missileCount; ++i)
+    {
+        int id = static_cast<int>(header.signedVarint());
+        CatalogEntry entry;
+        entry.damage = static_cast<int>(header.signedVarint());
+        entry.name = header.string();
+        entry.speed = header.f64();
+        entry.position = header.position();
+        catalog[id] = entry;
+    }
+    return targets;
+}
+
+const std::vector<ThreatReport> &TickReplayer::getThreats()
+{
+    // Priority order is only needed for display, sort on demand
+    if (!threatsSorted)
+    {
+        controller.prioritizeThreats(threats);
+        threatsSorted = true;
+    }
+    return threats;
+}
+
+long TickReplayer::getFirstTick() const
+{
+    return keyframes.empty() ? -1 : keyframes.front().tick;
+}
+
+bool TickReplayer::readFrame(uint8_t &type, long &tick)
+{
+    uint8_t header[FRAME_HEADER_BYTES];
+    if (!in.read(reinterpret_cast<char *>(header), sizeof(header)))
+    {
+        return false;
+    }
+    int64_t tickValue;
+    uint32_t size;
+    type = header[0];
+    std::memcpy(&tickValue, header + 1, sizeof(tickValue));
+    std::memcpy(&size, header + 9, sizeof(size));
+    tick = static_cast<long>(tickValue);
+
+    payload.resize(size);
+    if (!in.read(reinterpret_cast<char *>(payload.data()), size))
+    {
+        return false;
+    }
+    return type == FRAME_KEY || type == FRAME_DELTA;
+}
+
+bool TickReplayer::next()
+{
+    uint8_t type;
+    long tick;
+    if (!readFrame(type, tick))
+    {
+        return false;
+    }
+    if (type == FRAME_DELTA && currentTick < 0)
+    {
+        throw std::runtime_error(path + ": log does not start with a keyframe");
+    }
+
+    const uint8_t *data = payload.data();
+    if (type == FRAME_KEY)
+    {
+        applyKeyframe(data, data + payload.size());
+    }
+    else
+    {
+        applyDelta(data, data + payload.size());
+    }
+    currentTick = tick;
+    return true;
+}
+
+void TickReplayer::seek(long tick)
+{
+    auto keyframe = std::upper_bound(keyframes.begin(), keyframes.end(), tick,
+                                     [](long wanted, const KeyframeEntry &entry)
+                                     { return wanted < entry.tick; });
+    if (keyframe != keyframes.begin())
+    {
+        --keyframe;
+    }
+    if (keyframe == keyframes.end())
+    {
+        return;
+    }
+
+    in.clear();
+    in.seekg(keyframe->offset);
+    currentTick = -1;
+    while (next() && currentTick < tick)
+    {
+    }
+}
+
+namespace
+{
+    void readTrack(ByteReader &reader, TrackStore &enemies)
+    {
+        int id = static_cast<int>(reader.signedVarint());
+        Position position = reader.position();
+        Position target = reader.position();
+        double speed = reader.f64();
+        int targetId = static_cast<int>(reader.signedVarint());
+        if (id >= 0)
+        {
+            enemies.add(EnemyMissile(id, position, target, speed, targetId));
+        }
+    }
+}
+
+void TickReplayer::applyKeyframe(const uint8_t *data, const uint8_t *end)
+{
+    ByteReader reader(data, end);
+
+    enemies.clear();
+    uint64_t trackCount = reader.varint();
+    enemies.reserve(static_cast<size_t>(trackCount));
+    for (uint64_t i = 0; i < trackCount; ++i)
+    {
+        readTrack(reader, enemies);
+    }
+
+    // Inventory as listed, flights rebuilt from their launch records
+    controller = MissileController();
+    controller.setVerbose(false);
+    uint64_t inventoryCount = reader.varint();
+    for (uint64_t i = 0; i < inventoryCount; ++i)
+    {
+        int id = static_cast<int>(reader.signedVarint());
+        auto entry = catalog.find(id);
+        if (entry != catalog.end())
+        {
+            controller.addMissile(Missile(id, entry->second.damage, entry->second.name, entry->second.speed,
+                                          entry->second.position));
+        }
+    }
+
+    launches.clear();
+    uint64_t launchCount = reader.varint();
+    for (uint64_t i = 0; i < launchCount; ++i)
+    {
+        int id = static_cast<int>(reader.signedVarint());
+        Launch launch;
+        launch.from = reader.position();
+        launch.to = reader.position();
+        launch.enemyId = static_cast<int>(reader.signedVarint());
+        launch.flightSteps = static_cast<int>(reader.varint());
+        launches[id] = launch;
+    }
+
+    flights.clear();
+    uint64_t flightCount = reader.varint();
+    for (uint64_t i = 0; i < flightCount; ++i)
+    {
+        int id = static_cast<int>(reader.signedVarint());
+        addFlight(id, static_cast<int>(reader.varint()));
+    }
+    controller.restoreFlights(flights);
+
+    rescan();
+}
+
+void TickReplayer::applyDelta(const uint8_t *data, const uint8_t *end)
+{
+    ByteReader reader(data, end);
+
+    // The tick's movement, then its adds/removes in recorded order
+    enemies.moveAll();
+    uint64_t changeCount = reader.varint();
+    for (uint64_t i = 0; i < changeCount; ++i)
+    {
+        int64_t code = reader.signedVarint();
+        if (code < 0)
+        {
+            enemies.removeById(static_cast<int>(-code - 1));
+            continue;
+        }
+        readTrack(reader, enemies);
+    }
+
+    uint64_t launchCount = reader.varint();
+    for (uint64_t i = 0; i < launchCount; ++i)
+    {
+        int id = static_cast<int>(reader.signedVarint());
+        Launch launch;
+        launch.from = reader.position();
+        launch.to = reader.position();
+        launch.enemyId = static_cast<int>(reader.signedVarint());
+        launch.flightSteps = static_cast<int>(reader.varint());
+        launches[id] = launch;
+        controller.removeMissileById(id);
+    }
+
+    flights.clear();
+    uint64_t flightCount = reader.varint();
+    for (uint64_t i = 0; i < flightCount; ++i)
+    {
+        int id = static_cast<int>(reader.signedVarint());
+        addFlight(id, static_cast<int>(reader.varint()));
+    }
+    controller.restoreFlights(flights);
+
+    rescan();
+}
+
+void TickReplayer::addFlight(int missileId, int step)
+{
+    auto entry = catalog.find(missileId);
+    auto launch = launches.find(missileId);
+    if (entry == catalog.end() || launch == launches.end())
+    {
+        return;
+    }
+
+    // Re-fly the recorded path up to the recorded step
+    Missile missile(missileId, entry->second.damage, entry->second.name, entry->second.speed, launch->second.from);
+    missile.launch(launch->second.to, launch->second.enemyId, launch->second.flightSteps);
+    for (int i = 0; i < step; ++i)
+    {
+        missile.advanceFlight();
+    }
+    flights.push_back(missile);
+}
+
+void TickReplayer::rescan()
+{
+    // Threat reports are a function of the track state, the recorder doesn't store them
+    threats = radar.scanForThreats();
+    threatsSorted = false;
+}
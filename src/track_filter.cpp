@@ -0,0 +1,288 @@
+#include "track_filter.h"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define TRACK_FILTER_HAS_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    // Position variance of a track before its first measurement: nothing
+    // known, so the first update lands on the measurement and takes its variance
+    const double UNKNOWN_POSITION_VARIANCE = 1e12;
+
+    struct FilterColumns
+    {
+        double *x, *y, *z;
+        double *vx, *vy, *vz;
+        double *p00, *p01, *p11;
+        double *lastTime;
+        const double *zx, *zy, *zz;
+        double r;  // Measurement variance
+        double qa; // Acceleration variance
+    };
+
+    inline void axisScalar(double *x, double *v, const double *measured, size_t i, double dt, double k0, double k1)
+    {
+        double predicted = x[i] + v[i] * dt;
+        double residual = measured[i] - predicted;
+        x[i] = predicted + k0 * residual;
+        v[i] = v[i] + k1 * residual;
+    }
+
+    // Shared by both kernels so the vector path and the tail produce identical results
+    void filterRangeScalar(const FilterColumns &c, double time, size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            double dt = time - c.lastTime[i];
+            double dt2 = dt * dt;
+
+            // Predict
+            double p00 = c.p00[i] + dt * (2.0 * c.p01[i] + dt * c.p11[i]) + c.qa * (0.25 * dt2 * dt2);
+            double p01 = c.p01[i] + dt * c.p11[i] + c.qa * (0.5 * dt2 * dt);
+            double p11 = c.p11[i] + c.qa * dt2;
+
+            // Update with the gain shared by all three axes
+            double inverse = 1.0 / (p00 + c.r);
+            double k0 = p00 * inverse;
+            double k1 = p01 * inverse;
+            double keep = c.r * inverse; // 1 - k0
+
+            axisScalar(c.x, c.vx, c.zx, i, dt, k0, k1);
+            axisScalar(c.y, c.vy, c.zy, i, dt, k0, k1);
+            axisScalar(c.z, c.vz, c.zz, i, dt, k0, k1);
+
+            c.p11[i] = p11 - k1 * p01;
+            c.p01[i] = keep * p01;
+            c.p00[i] = keep * p00;
+            c.lastTime[i] = time;
+        }
+    }
+
+#ifdef TRACK_FILTER_HAS_AVX2
+    __attribute__((target("avx2"))) inline void axisAvx2(double *x, double *v, const double *measured, size_t i,
+                                                         __m256d dt, __m256d k0, __m256d k1)
+    {
+        __m256d position = _mm256_loadu_pd(x + i);
+        __m256d velocity = _mm256_loadu_pd(v + i);
+        __m256d predicted = _mm256_add_pd(position, _mm256_mul_pd(velocity, dt));
+        __m256d residual = _mm256_sub_pd(_mm256_loadu_pd(measured + i), predicted);
+        _mm256_storeu_pd(x + i, _mm256_add_pd(predicted, _mm256_mul_pd(k0, residual)));
+        _mm256_storeu_pd(v + i, _mm256_add_pd(velocity, _mm256_mul_pd(k1, residual)));
+    }
+
+    __attribute__((target("avx2"))) void filterRangeAvx2(const FilterColumns &c, double time, size_t count)
+    {
+        const __m256d now = _mm256_set1_pd(time);
+        const __m256d r = _mm256_set1_pd(c.r);
+        const __m256d qa = _mm256_set1_pd(c.qa);
+        const __m256d two = _mm256_set1_pd(2.0);
+        const __m256d half = _mm256_set1_pd(0.5);
+        const __m256d quarter = _mm256_set1_pd(0.25);
+        const __m256d one = _mm256_set1_pd(1.0);
+        size_t i = 0;
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m256d dt = _mm256_sub_pd(now, _mm256_loadu_pd(c.lastTime + i));
+            __m256d dt2 = _mm256_mul_pd(dt, dt);
+            __m256d p00 = _mm256_loadu_pd(c.p00 + i);
+            __m256d p01 = _mm256_loadu_pd(c.p01 + i);
+            __m256d p11 = _mm256_loadu_pd(c.p11 + i);
+
+            p00 = _mm256_add_pd(_mm256_add_pd(p00, _mm256_mul_pd(dt, _mm256_add_pd(_mm256_mul_pd(two, p01), _mm256_mul_pd(dt, p11)))),
+                                _mm256_mul_pd(qa, _mm256_mul_pd(_mm256_mul_pd(quarter, dt2), dt2)));
+            p01 = _mm256_add_pd(_mm256_add_pd(p01, _mm256_mul_pd(dt, p11)),
+                                _mm256_mul_pd(qa, _mm256_mul_pd(_mm256_mul_pd(half, dt2), dt)));
+            p11 = _mm256_add_pd(p11, _mm256_mul_pd(qa, dt2));
+
+            __m256d inverse = _mm256_div_pd(one, _mm256_add_pd(p00, r));
+            __m256d k0 = _mm256_mul_pd(p00, inverse);
+            __m256d k1 = _mm256_mul_pd(p01, inverse);
+            __m256d keep = _mm256_mul_pd(r, inverse);
+
+            axisAvx2(c.x, c.vx, c.zx, i, dt, k0, k1);
+            axisAvx2(c.y, c.vy, c.zy, i, dt, k0, k1);
+            axisAvx2(c.z, c.vz, c.zz, i, dt, k0, k1);
+
+            _mm256_storeu_pd(c.p11 + i, _mm256_sub_pd(p11, _mm256_mul_pd(k1, p01)));
+            _mm256_storeu_pd(c.p01 + i, _mm256_mul_pd(keep, p01));
+            _mm256_storeu_pd(c.p00 + i, _mm256_mul_pd(keep, p00));
+            _mm256_storeu_pd(c.lastTime + i, now);
+        }
+
+        filterRangeScalar(c, time, i, count);
+    }
+#endif
+}
+
+TrackFilter::TrackFilter(double measurementNoise, double accelerationNoise, double maxSpeed)
+    : measurementVariance(measurementNoise * measurementNoise),
+      accelerationVariance(accelerationNoise * accelerationNoise),
+      initialVelocityVariance(maxSpeed * maxSpeed)
+{
+    if (!(measurementNoise > 0.0) || !(accelerationNoise >= 0.0))
+    {
+        throw std::invalid_argument("TrackFilter: measurement noise must be positive and acceleration noise non-negative");
+    }
+}
+
+double TrackFilter::getMeasurementNoise() const
+{
+    return std::sqrt(measurementVariance);
+}
+
+bool TrackFilter::avx2Available()
+{
+#ifdef TRACK_FILTER_HAS_AVX2
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+long TrackFilter::rowOf(int id) const
+{
+    if (id < 0 || static_cast<size_t>(id) >= rowById.size())
+    {
+        return -1;
+    }
+    return rowById[id];
+}
+
+double TrackFilter::positionErrorAt(size_t row) const
+{
+    return std::sqrt(p00s[row]);
+}
+
+void TrackFilter::clear()
+{
+    for (int id : ids)
+    {
+        rowById[id] = -1;
+    }
+    for (auto *column : {&xs, &ys, &zs, &vxs, &vys, &vzs, &p00s, &p01s, &p11s, &lastTimes, &zxs, &zys, &zzs})
+    {
+        column->clear();
+    }
+    ids.clear();
+    measured.clear();
+    measuredCount = 0;
+}
+
+void TrackFilter::measure(int id, const Position &position)
+{
+    if (id < 0)
+    {
+        throw std::invalid_argument("TrackFilter: track IDs must be non-negative");
+    }
+    long row = rowOf(id);
+    if (row < 0)
+    {
+        if (static_cast<size_t>(id) >= rowById.size())
+        {
+            rowById.resize(static_cast<size_t>(id) + 1, -1);
+        }
+        row = static_cast<long>(ids.size());
+        rowById[id] = static_cast<int32_t>(row);
+        ids.push_back(id);
+        xs.push_back(position.x);
+        ys.push_back(position.y);
+        zs.push_back(position.z);
+        vxs.push_back(0.0);
+        vys.push_back(0.0);
+        vzs.push_back(0.0);
+        p00s.push_back(UNKNOWN_POSITION_VARIANCE);
+        p01s.push_back(0.0);
+        p11s.push_back(initialVelocityVariance);
+        lastTimes.push_back(std::numeric_limits<double>::quiet_NaN());
+        zxs.push_back(0.0);
+        zys.push_back(0.0);
+        zzs.push_back(0.0);
+        measured.push_back(0);
+    }
+
+    if (!measured[row])
+    {
+        measured[row] = 1;
+        ++measuredCount;
+    }
+    zxs[row] = position.x;
+    zys[row] = position.y;
+    zzs[row] = position.z;
+}
+
+void TrackFilter::dropUnmeasured()
+{
+    // Keeps the row order, so the batch stays in first-seen order
+    size_t kept = 0;
+    for (size_t row = 0; row < ids.size(); ++row)
+    {
+        if (!measured[row])
+        {
+            rowById[ids[row]] = -1;
+            continue;
+        }
+        if (kept != row)
+        {
+            ids[kept] = ids[row];
+            rowById[ids[kept]] = static_cast<int32_t>(kept);
+            for (auto *column : {&xs, &ys, &zs, &vxs, &vys, &vzs, &p00s, &p01s, &p11s, &lastTimes, &zxs, &zys, &zzs})
+            {
+                (*column)[kept] = (*column)[row];
+            }
+            measured[kept] = 1;
+        }
+        ++kept;
+    }
+    ids.resize(kept);
+    for (auto *column : {&xs, &ys, &zs, &vxs, &vys, &vzs, &p00s, &p01s, &p11s, &lastTimes, &zxs, &zys, &zzs})
+    {
+        column->resize(kept);
+    }
+    measured.resize(kept);
+}
+
+void TrackFilter::update(double time)
+{
+    if (measuredCount != ids.size())
+    {
+        dropUnmeasured();
+    }
+
+    // New tracks have nothing to predict from
+    for (double &lastTime : lastTimes)
+    {
+        if (std::isnan(lastTime))
+        {
+            lastTime = time;
+        }
+    }
+
+    FilterColumns columns{xs.data(), ys.data(), zs.data(),
+                          vxs.data(), vys.data(), vzs.data(),
+                          p00s.data(), p01s.data(), p11s.data(),
+                          lastTimes.data(),
+                          zxs.data(), zys.data(), zzs.data(),
+                          measurementVariance, accelerationVariance};
+    size_t count = ids.size();
+
+#ifdef TRACK_FILTER_HAS_AVX2
+    if (kernel != Kernel::Scalar && avx2Available())
+    {
+        filterRangeAvx2(columns, time, count);
+    }
+    else
+#endif
+    {
+        filterRangeScalar(columns, time, 0, count);
+    }
+
+    measured.assign(count, 0);
+    measuredCount = 0;
+}
@@ -0,0 +1,203 @@
+#include "track_fusion.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    // Filter gains: how far an update moves towards the measured position
+    // and velocity
+    const double ALPHA = 0.5;
+    const double BETA = 0.3;
+
+    double distanceBetween(const Position &a, const Position &b)
+    {
+        double dx = a.x - b.x;
+        double dy = a.y - b.y;
+        double dz = a.z - b.z;
+        return std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+}
+
+TrackFusion::TrackFusion(const FusionSettings &settings) : settings(settings)
+{
+    if (this->settings.coastLimit <= 0)
+    {
+        this->settings.coastLimit = 2 * std::max(1L, settings.maxScanInterval) + 1;
+    }
+}
+
+double TrackFusion::gate(long age) const
+{
+    // Four sigma of a 3D miss: the plot's own error plus the track's velocity
+    // error carried over `age` ticks
+    return 4.0 * std::sqrt(3.0) * (settings.positionNoise + settings.velocityNoise * static_cast<double>(age)) + 1.0;
+}
+
+void TrackFusion::fuse(long tick, const std::vector<Plot> &plots)
+{
+    dropStale(tick);
+    associate(tick, plots);
+    update(tick);
+    startTracks(tick, plots);
+}
+
+void TrackFusion::dropStale(long tick)
+{
+    size_t kept = 0;
+    for (size_t i = 0; i < tracks.size(); ++i)
+    {
+        if (tick - tracks[i].lastUpdate <= settings.coastLimit)
+        {
+            tracks[kept++] = tracks[i];
+        }
+    }
+    tracksDropped += tracks.size() - kept;
+    tracks.resize(kept);
+}
+
+void TrackFusion::associate(long tick, const std::vector<Plot> &plots)
+{
+    predicted.resize(tracks.size());
+    candidates.resize(tracks.size());
+    for (size_t i = 0; i < tracks.size(); ++i)
+    {
+        predicted[i] = tracks[i].positionAt(tick);
+        candidates[i] = Candidate{predicted[i], gate(tick - tracks[i].lastUpdate), UINT32_MAX};
+    }
+    // The oldest track still kept sets the widest gate; cells twice that wide
+    // keep every query to 2x2 cells
+    const double widestGate = gate(settings.coastLimit);
+    trackGrid.build(predicted.data(), predicted.size(), 2.0 * widestGate);
+
+    claims.assign(tracks.size(), Claim{0, {0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, 0.0, -1});
+    leftover.clear();
+    for (size_t i = 0; i < plots.size(); ++i)
+    {
+        const Plot &plot = plots[i];
+
+        long best = -1;
+        double bestDistance = std::numeric_limits<double>::max();
+        trackGrid.forEachNear(plot.position, widestGate, [&](size_t track)
+                              {
+                                  const Candidate &candidate = candidates[track];
+                                  if (candidate.claimedBy == plot.radar)
+                                  {
+                                      return; // One plot per radar and object
+                                  }
+                                  double distance = distanceBetween(plot.position, candidate.position);
+                                  if (distance <= candidate.gate && distance < bestDistance)
+                                  {
+                                      best = static_cast<long>(track);
+                                      bestDistance = distance;
+                                  } });
+        if (best < 0)
+        {
+            leftover.push_back(i);
+            continue;
+        }
+
+        Claim &claim = claims[best];
+        if (claim.plots == 0 || bestDistance < claim.bestDistance)
+        {
+            claim.bestDistance = bestDistance;
+            claim.bestEnemyId = plot.enemyId;
+        }
+        candidates[best].claimedBy = plot.radar;
+        ++claim.plots;
+        claim.positionSum.x += plot.position.x;
+        claim.positionSum.y += plot.position.y;
+        claim.positionSum.z += plot.position.z;
+        claim.velocitySum.x += plot.velocity.x;
+        claim.velocitySum.y += plot.velocity.y;
+        claim.velocitySum.z += plot.velocity.z;
+    }
+}
+
+void TrackFusion::update(long tick)
+{
+    for (size_t i = 0; i < claims.size(); ++i)
+    {
+        const Claim &claim = claims[i];
+        if (claim.plots == 0)
+        {
+            continue; // Coasting
+        }
+        SystemTrack &track = tracks[i];
+        double count = static_cast<double>(claim.plots);
+        Position measured = {claim.positionSum.x / count, claim.positionSum.y / count, claim.positionSum.z / count};
+        Position measuredVelocity = {claim.velocitySum.x / count, claim.velocitySum.y / count, claim.velocitySum.z / count};
+
+        Position prediction = predicted[i];
+        track.position = {prediction.x + ALPHA * (measured.x - prediction.x),
+                          prediction.y + ALPHA * (measured.y - prediction.y),
+                          prediction.z + ALPHA * (measured.z - prediction.z)};
+        track.velocity = {track.velocity.x + BETA * (measuredVelocity.x - track.velocity.x),
+                          track.velocity.y + BETA * (measuredVelocity.y - track.velocity.y),
+                          track.velocity.z + BETA * (measuredVelocity.z - track.velocity.z)};
+
+        if (claim.bestEnemyId != track.enemyId)
+        {
+            ++tagSwitches;
+            track.enemyId = claim.bestEnemyId;
+        }
+        track.lastUpdate = tick;
+        ++track.updates;
+    }
+}
+
+void TrackFusion::startTracks(long tick, const std::vector<Plot> &plots)
+{
+    leftoverPositions.clear();
+    for (size_t plot : leftover)
+    {
+        leftoverPositions.push_back(plots[plot].position);
+    }
+    const double clusterGate = gate(0);
+    plotGrid.build(leftoverPositions.data(), leftoverPositions.size(), 2.0 * clusterGate);
+    consumed.assign(leftover.size(), 0);
+
+    for (size_t i = 0; i < leftover.size(); ++i)
+    {
+        if (consumed[i])
+        {
+            continue;
+        }
+        consumed[i] = 1;
+        const Plot &seed = plots[leftover[i]];
+
+        // Other radars' plots of the same object: one each, within the gate
+        clusterRadars.clear();
+        clusterRadars.push_back(seed.radar);
+        Position positionSum = seed.position;
+        Position velocitySum = seed.velocity;
+        double count = 1.0;
+        plotGrid.forEachNear(seed.position, clusterGate, [&](size_t j)
+                             {
+                                 const Plot &plot = plots[leftover[j]];
+                                 if (consumed[j] || distanceBetween(plot.position, seed.position) > clusterGate ||
+                                     std::find(clusterRadars.begin(), clusterRadars.end(), plot.radar) != clusterRadars.end())
+                                 {
+                                     return;
+                                 }
+                                 consumed[j] = 1;
+                                 clusterRadars.push_back(plot.radar);
+                                 positionSum.x += plot.position.x;
+                                 positionSum.y += plot.position.y;
+                                 positionSum.z += plot.position.z;
+                                 velocitySum.x += plot.velocity.x;
+                                 velocitySum.y += plot.velocity.y;
+                                 velocitySum.z += plot.velocity.z;
+                                 count += 1.0; });
+
+        SystemTrack track;
+        track.id = nextTrackId++;
+        track.enemyId = seed.enemyId;
+        track.position = {positionSum.x / count, positionSum.y / count, positionSum.z / count};
+        track.velocity = {velocitySum.x / count, velocitySum.y / count, velocitySum.z / count};
+        track.lastUpdate = tick;
+        track.updates = 1;
+        tracks.push_back(track);
+        ++tracksCreated;
+    }
+}
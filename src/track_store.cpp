@@ -0,0 +1,364 @@
+#include "track_store.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define TRACK_STORE_HAS_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    // Shared by both kernels so the vector path and the tail produce identical results
+    void moveRangeScalar(double *x, double *y, double *z,
+                         const double *tx, const double *ty, const double *tz,
+                         const double *speed, size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            double dx = tx[i] - x[i];
+            double dy = ty[i] - y[i];
+            double dz = tz[i] - z[i];
+            double distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+
+            if (speed[i] >= distance)
+            {
+                // Arrives this step: land exactly on the target instead of overshooting
+                x[i] = tx[i];
+                y[i] = ty[i];
+                z[i] = tz[i];
+            }
+            else
+            {
+                double step = speed[i] / distance;
+                x[i] += dx * step;
+                y[i] += dy * step;
+                z[i] += dz * step;
+            }
+        }
+    }
+
+#ifdef TRACK_STORE_HAS_AVX2
+    __attribute__((target("avx2"))) void moveRangeAvx2(double *x, double *y, double *z,
+                                                       const double *tx, const double *ty, const double *tz,
+                                                       const double *speed, size_t count)
+    {
+        const __m256d zero = _mm256_setzero_pd();
+        size_t i = 0;
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m256d px = _mm256_loadu_pd(x + i);
+            __m256d py = _mm256_loadu_pd(y + i);
+            __m256d pz = _mm256_loadu_pd(z + i);
+
+            __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(tx + i), px);
+            __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(ty + i), py);
+            __m256d dz = _mm256_sub_pd(_mm256_loadu_pd(tz + i), pz);
+
+            __m256d distSq = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)),
+                                           _mm256_mul_pd(dz, dz));
+            __m256d distance = _mm256_sqrt_pd(distSq);
+
+            // Tracks sitting exactly on their target don't move (and must not divide by zero)
+            __m256d moving = _mm256_cmp_pd(distance, zero, _CMP_GT_OQ);
+            __m256d speeds = _mm256_loadu_pd(speed + i);
+            __m256d step = _mm256_and_pd(_mm256_div_pd(speeds, distance), moving);
+
+            // Tracks within one step land exactly on the target
+            __m256d arriving = _mm256_cmp_pd(speeds, distance, _CMP_GE_OQ);
+
+            _mm256_storeu_pd(x + i, _mm256_blendv_pd(_mm256_add_pd(px, _mm256_mul_pd(dx, step)), _mm256_loadu_pd(tx + i), arriving));
+            _mm256_storeu_pd(y + i, _mm256_blendv_pd(_mm256_add_pd(py, _mm256_mul_pd(dy, step)), _mm256_loadu_pd(ty + i), arriving));
+            _mm256_storeu_pd(z + i, _mm256_blendv_pd(_mm256_add_pd(pz, _mm256_mul_pd(dz, step)), _mm256_loadu_pd(tz + i), arriving));
+        }
+
+        moveRangeScalar(x, y, z, tx, ty, tz, speed, i, count);
+    }
+#endif
+}
+
+void TrackStore::adopt(const ExternalColumns &columns)
+{
+    clear();
+    ids.adopt(columns.ids, columns.count);
+    xs.adopt(columns.xs, columns.count);
+    ys.adopt(columns.ys, columns.count);
+    zs.adopt(columns.zs, columns.count);
+    targetXs.adopt(columns.targetXs, columns.count);
+    targetYs.adopt(columns.targetYs, columns.count);
+    targetZs.adopt(columns.targetZs, columns.count);
+    speeds.adopt(columns.speeds, columns.count);
+    targetIds.adopt(columns.targetIds, columns.count);
+    indexById.adopt(columns.indexById, columns.indexSize);
+    externalOwner = columns.owner;
+}
+
+size_t TrackStore::add(const EnemyMissile &enemy)
+{
+    int id = enemy.getId();
+    if (id < 0)
+    {
+        throw std::invalid_argument("TrackStore: track IDs must be non-negative");
+    }
+    if (contains(id))
+    {
+        throw std::invalid_argument("TrackStore: duplicate track ID " + std::to_string(id));
+    }
+
+    if (static_cast<size_t>(id) >= indexById.size())
+    {
+        indexById.resize(static_cast<size_t>(id) + 1, -1);
+    }
+
+    const Position &current = enemy.getCurrentPosition();
+    const Position &target = enemy.getTargetPosition();
+
+    size_t index = ids.size();
+    ids.push_back(id);
+    xs.push_back(current.x);
+    ys.push_back(current.y);
+    zs.push_back(current.z);
+    targetXs.push_back(target.x);
+    targetYs.push_back(target.y);
+    targetZs.push_back(target.z);
+    speeds.push_back(enemy.getSpeed());
+    targetIds.push_back(enemy.getTargetId());
+
+    indexById[id] = static_cast<int32_t>(index);
+    if (journaling)
+    {
+        journal.push_back({id, false});
+    }
+    return index;
+}
+
+bool TrackStore::removeById(int id)
+{
+    if (!contains(id))
+    {
+        return false;
+    }
+
+    // Swap-and-pop: move the last track into the freed slot
+    size_t index = static_cast<size_t>(indexById[id]);
+    size_t last = ids.size() - 1;
+
+    if (index != last)
+    {
+        ids[index] = ids[last];
+        xs[index] = xs[last];
+        ys[index] = ys[last];
+        zs[index] = zs[last];
+        targetXs[index] = targetXs[last];
+        targetYs[index] = targetYs[last];
+        targetZs[index] = targetZs[last];
+        speeds[index] = speeds[last];
+        targetIds[index] = targetIds[last];
+        indexById[ids[index]] = static_cast<int32_t>(index);
+    }
+
+    ids.pop_back();
+    xs.pop_back();
+    ys.pop_back();
+    zs.pop_back();
+    targetXs.pop_back();
+    targetYs.pop_back();
+    targetZs.pop_back();
+    speeds.pop_back();
+    targetIds.pop_back();
+
+    indexById[id] = -1;
+    if (journaling)
+    {
+        journal.push_back({id, true});
+    }
+    return true;
+}
+
+void TrackStore::clear()
+{
+    ids.clear();
+    xs.clear();
+    ys.clear();
+    zs.clear();
+    targetXs.clear();
+    targetYs.clear();
+    targetZs.clear();
+    speeds.clear();
+    targetIds.clear();
+    indexById.clear();
+    externalOwner.reset();
+}
+
+void TrackStore::reserve(size_t count)
+{
+    ids.reserve(count);
+    xs.reserve(count);
+    ys.reserve(count);
+    zs.reserve(count);
+    targetXs.reserve(count);
+    targetYs.reserve(count);
+    targetZs.reserve(count);
+    speeds.reserve(count);
+    targetIds.reserve(count);
+}
+
+bool TrackStore::contains(int id) const
+{
+    return id >= 0 && static_cast<size_t>(id) < indexById.size() && indexById[id] >= 0;
+}
+
+long TrackStore::indexOf(int id) const
+{
+    return contains(id) ? indexById[id] : -1;
+}
+
+void TrackStore::setJournaling(bool enabled)
+{
+    journaling = enabled;
+    journal.clear();
+}
+
+EnemyMissile TrackStore::toEnemyMissile(size_t index) const
+{
+    return EnemyMissile(ids[index], positionAt(index), targetAt(index), speeds[index], targetIds[index]);
+}
+
+Position TrackStore::positionAfter(size_t index, long ticks) const
+{
+    Position position = positionAt(index);
+    if (ticks <= 0)
+    {
+        return position;
+    }
+
+    double dx = targetXs[index] - position.x;
+    double dy = targetYs[index] - position.y;
+    double dz = targetZs[index] - position.z;
+    double distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+    double travel = speeds[index] * static_cast<double>(ticks);
+
+    if (travel >= distance)
+    {
+        return targetAt(index);
+    }
+    double step = travel / distance;
+    return {position.x + dx * step, position.y + dy * step, position.z + dz * step};
+}
+
+Position TrackStore::stepAlong(size_t index, Position position, long steps) const
+{
+    double x[1] = {position.x}, y[1] = {position.y}, z[1] = {position.z};
+    const double tx[1] = {targetXs[index]}, ty[1] = {targetYs[index]}, tz[1] = {targetZs[index]};
+    const double speed[1] = {speeds[index]};
+    for (long step = 0; step < steps && (x[0] != tx[0] || y[0] != ty[0] || z[0] != tz[0]); ++step)
+    {
+        moveRangeScalar(x, y, z, tx, ty, tz, speed, 0, 1);
+    }
+    return {x[0], y[0], z[0]};
+}
+
+long TrackStore::stepsUntilWithin(size_t index, double radius, bool inclusive, long maxSteps) const
+{
+    double x[1] = {xs[index]}, y[1] = {ys[index]}, z[1] = {zs[index]};
+    const double tx[1] = {targetXs[index]}, ty[1] = {targetYs[index]}, tz[1] = {targetZs[index]};
+    const double speed[1] = {speeds[index]};
+
+    auto distance = [&]()
+    {
+        // The radar's formula (position minus target), so the comparison is the one it makes
+        double dx = x[0] - tx[0];
+        double dy = y[0] - ty[0];
+        double dz = z[0] - tz[0];
+        return std::sqrt(dx * dx + dy * dy + dz * dz);
+    };
+    auto within = [&](double d) { return inclusive ? d <= radius : d < radius; };
+
+    double start = distance();
+    if (within(start))
+    {
+        return 0;
+    }
+    if (speed[0] <= 0.0 || radius < 0.0 || (!inclusive && radius == 0.0))
+    {
+        return -1;
+    }
+
+    // Each step closes `speed` (the last one lands on the target). Rounding
+    // in the repeated steps drifts by orders of magnitude less than the margin.
+    const double MARGIN = 1e-6;
+    double estimate = std::max(start - radius, 0.0) / speed[0];
+    if (estimate > static_cast<double>(maxSteps) + 1.0)
+    {
+        return -1;
+    }
+    if (std::fabs(estimate - std::round(estimate)) > MARGIN)
+    {
+        long steps = static_cast<long>(inclusive ? std::ceil(estimate) : std::floor(estimate) + 1);
+        return steps <= maxSteps ? steps : -1;
+    }
+
+    for (long steps = 1; steps <= maxSteps; ++steps)
+    {
+        moveRangeScalar(x, y, z, tx, ty, tz, speed, 0, 1);
+        if (within(distance()))
+        {
+            return steps;
+        }
+    }
+    return -1;
+}
+
+void TrackStore::advanceAll(long ticks)
+{
+    if (ticks <= 0)
+    {
+        return;
+    }
+
+    size_t count = ids.size();
+    for (size_t i = 0; i < count; ++i)
+    {
+        Position position = positionAfter(i, ticks);
+        xs[i] = position.x;
+        ys[i] = position.y;
+        zs[i] = position.z;
+    }
+}
+
+void TrackStore::setMoveKernel(MoveKernel kernel)
+{
+    moveKernel = kernel;
+}
+
+bool TrackStore::avx2Available()
+{
+#ifdef TRACK_STORE_HAS_AVX2
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+void TrackStore::moveAll()
+{
+    size_t count = ids.size();
+
+#ifdef TRACK_STORE_HAS_AVX2
+    if (moveKernel != MoveKernel::Scalar && avx2Available())
+    {
+        moveRangeAvx2(xs.data(), ys.data(), zs.data(),
+                      targetXs.data(), targetYs.data(), targetZs.data(),
+                      speeds.data(), count);
+        return;
+    }
+#endif
+
+    moveRangeScalar(xs.data(), ys.data(), zs.data(),
+                    targetXs.data(), targetYs.data(), targetZs.data(),
+                    speeds.data(), 0, count);
+}
@@ -0,0 +1,199 @@
+#include "weapon_target_assignment.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+WeaponTargetAssigner::WeaponTargetAssigner(std::pmr::memory_resource *resource)
+    : prices(resource), ownerOfCol(resource), colOfRow(resource), unassigned(resource), assignments(resource)
+{
+}
+
+void WeaponTargetAssigner::solve(const double *costs, size_t rows, size_t cols,
+                                 std::chrono::microseconds budget)
+{
+    using Clock = std::chrono::steady_clock;
+
+    if (rows > cols)
+    {
+        throw std::invalid_argument("WeaponTargetAssigner: more rows than columns");
+    }
+
+    budgetExceeded = false;
+    bids = 0;
+    prices.assign(cols, 0.0);
+    ownerOfCol.assign(cols, -1);
+    colOfRow.assign(cols, -1);
+    unassigned.reserve(cols);
+    if (rows == 0)
+    {
+        assignments.clear();
+        return;
+    }
+
+    double minCost = std::numeric_limits<double>::max();
+    double maxCost = std::numeric_limits<double>::lowest();
+    for (size_t i = 0; i < rows * cols; ++i)
+    {
+        minCost = std::min(minCost, costs[i]);
+        maxCost = std::max(maxCost, costs[i]);
+    }
+
+    // The problem is made square with cols - rows virtual rows that cost
+    // nothing anywhere; they soak up the spare columns so every column ends
+    // up assigned and prices carried between scaling phases stay consistent.
+    const size_t bidders = cols;
+
+    // Final epsilon keeps the result within cols * epsilon of the optimum;
+    // start coarse and shrink so early phases settle prices cheaply
+    double range = std::max(maxCost - minCost, 1e-9);
+    const double finalEpsilon = range * 1e-4 / static_cast<double>(bidders);
+    double epsilon = std::max(range / 4.0, finalEpsilon);
+
+    const auto deadline = budget == std::chrono::microseconds::max() ? Clock::time_point::max() : Clock::now() + budget;
+
+    while (true)
+    {
+        // Each phase restarts the assignment but keeps the prices learned so far
+        std::fill(ownerOfCol.begin(), ownerOfCol.end(), -1);
+        std::fill(colOfRow.begin(), colOfRow.end(), -1);
+        unassigned.clear();
+        for (size_t row = bidders; row-- > 0;)
+        {
+            unassigned.push_back(row);
+        }
+
+        while (!unassigned.empty())
+        {
+            // Checking the clock on every bid would cost more than the bid itself
+            if ((bids & 63) == 0 && Clock::now() >= deadline)
+            {
+                budgetExceeded = true;
+                break;
+            }
+            ++bids;
+
+            size_t row = unassigned.back();
+            unassigned.pop_back();
+
+            // Best and second best net value (benefit = -cost, minus price)
+            const double *rowCosts = row < rows ? costs + row * cols : nullptr;
+            size_t bestCol = 0;
+            double bestValue = std::numeric_limits<double>::lowest();
+            double secondValue = std::numeric_limits<double>::lowest();
+            for (size_t col = 0; col < cols; ++col)
+            {
+                double value = (rowCosts ? -rowCosts[col] : 0.0) - prices[col];
+                if (value > bestValue)
+                {
+                    secondValue = bestValue;
+                    bestValue = value;
+                    bestCol = col;
+                }
+                else if (value > secondValue)
+                {
+                    secondValue = value;
+                }
+            }
+            if (cols == 1)
+            {
+                secondValue = bestValue;
+            }
+
+            prices[bestCol] += bestValue - secondValue + epsilon;
+
+            long previous = ownerOfCol[bestCol];
+            if (previous >= 0)
+            {
+                colOfRow[previous] = -1;
+                unassigned.push_back(static_cast<size_t>(previous));
+            }
+            ownerOfCol[bestCol] = static_cast<long>(row);
+            colOfRow[row] = static_cast<long>(bestCol);
+        }
+
+        if (budgetExceeded || epsilon <= finalEpsilon)
+        {
+            break;
+        }
+        epsilon = std::max(epsilon / 5.0, finalEpsilon);
+    }
+
+    if (budgetExceeded)
+    {
+        // Columns held by virtual rows are free for the real ones
+        for (size_t row = rows; row < bidders; ++row)
+        {
+            if (colOfRow[row] >= 0)
+            {
+                ownerOfCol[colOfRow[row]] = -1;
+            }
+        }
+        greedyFill(costs, rows, cols);
+    }
+    collect(costs, rows, cols);
+}
+
+void WeaponTargetAssigner::solveGreedy(const double *costs, size_t rows, size_t cols)
+{
+    if (rows > cols)
+    {
+        throw std::invalid_argument("WeaponTargetAssigner: more rows than columns");
+    }
+
+    budgetExceeded = false;
+    bids = 0;
+    ownerOfCol.assign(cols, -1);
+    colOfRow.assign(rows, -1);
+    greedyFill(costs, rows, cols);
+    collect(costs, rows, cols);
+}
+
+void WeaponTargetAssigner::greedyFill(const double *costs, size_t rows, size_t cols)
+{
+    for (size_t row = 0; row < rows; ++row)
+    {
+        if (colOfRow[row] >= 0)
+        {
+            continue;
+        }
+
+        const double *rowCosts = costs + row * cols;
+        long bestCol = -1;
+        for (size_t col = 0; col < cols; ++col)
+        {
+            if (ownerOfCol[col] < 0 && (bestCol < 0 || rowCosts[col] < rowCosts[bestCol]))
+            {
+                bestCol = static_cast<long>(col);
+            }
+        }
+        if (bestCol >= 0)
+        {
+            ownerOfCol[bestCol] = static_cast<long>(row);
+            colOfRow[row] = bestCol;
+        }
+    }
+}
+
+void WeaponTargetAssigner::collect(const double *costs, size_t rows, size_t cols)
+{
+    assignments.clear();
+    assignments.reserve(rows);
+    for (size_t row = 0; row < rows; ++row)
+    {
+        if (colOfRow[row] >= 0)
+        {
+            size_t col = static_cast<size_t>(colOfRow[row]);
+            assignments.push_back({row, col, costs[row * cols + col]});
+        }
+    }
+}
+
+double WeaponTargetAssigner::getTotalCost() const
+{
+    double total = 0.0;
+    for (const auto &assignment : assignments)
+    {
+        total += assignment.cost;
+    }
+    return total;
+}
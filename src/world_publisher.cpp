@@ -0,0 +1,194 @@
+#include "world_publisher.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace world_snapshot;
+
+namespace
+{
+    size_t align64(size_t bytes)
+    {
+        return (bytes + 63) & ~static_cast<size_t>(63);
+    }
+
+    size_t align8(size_t bytes)
+    {
+        return (bytes + 7) & ~static_cast<size_t>(7);
+    }
+
+    std::runtime_error publishError(const std::string &name, const std::string &message)
+    {
+        return std::runtime_error("world snapshot " + name + ": " + message);
+    }
+
+    template <size_t N>
+    void copyName(char (&out)[N], std::string_view name)
+    {
+        std::memset(out, 0, N);
+        std::memcpy(out, name.data(), std::min(name.size(), N - 1));
+    }
+
+    void fillInterceptor(InterceptorRecord &record, const Missile &missile, uint32_t state)
+    {
+        record.id = missile.getId();
+        record.targetEnemyId = state == INTERCEPTOR_IN_FLIGHT ? missile.getTargetEnemyId() : -1;
+        record.state = state;
+        record.damage = missile.getDamage();
+        copyName(record.name, missile.getName());
+        record.speed = missile.getSpeed();
+        record.flightProgress = state == INTERCEPTOR_IN_FLIGHT ? missile.getFlightProgress() : 0.0;
+        record.position = missile.getCurrentPosition();
+        record.flightTarget = state == INTERCEPTOR_IN_FLIGHT ? missile.getFlightTarget() : missile.getCurrentPosition();
+    }
+}
+
+WorldPublisher::WorldPublisher(const std::string &name, const GeodeticPosition &origin,
+                               const std::vector<Target> &targets, size_t trackCapacity, size_t interceptorCapacity)
+    : name(name)
+{
+    size_t targetsOffset = align64(sizeof(Header));
+    size_t frameBytes = align64(world_snapshot::frameBytes(trackCapacity, trackCapacity, interceptorCapacity));
+    size_t frameOffset = align64(targetsOffset + targets.size() * sizeof(TargetRecord));
+    size = frameOffset + 2 * frameBytes;
+
+    // A fresh object every time: readers of a previous run keep their old mapping
+    ::shm_unlink(name.c_str());
+    int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0)
+    {
+        throw publishError(name, std::string("cannot create: ") + std::strerror(errno));
+    }
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+    {
+        int error = errno;
+        ::close(fd);
+        ::shm_unlink(name.c_str());
+        throw publishError(name, std::string("cannot size: ") + std::strerror(error));
+    }
+    void *mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    int error = errno;
+    ::close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        ::shm_unlink(name.c_str());
+        throw publishError(name, std::string("mmap failed: ") + std::strerror(error));
+    }
+    base = static_cast<unsigned char *>(mapping);
+
+    Header *layout = new (base) Header();
+    layout->version = VERSION;
+    layout->headerBytes = sizeof(Header);
+    layout->writerPid = ::getpid();
+    layout->trackCapacity = trackCapacity;
+    layout->threatCapacity = trackCapacity;
+    layout->interceptorCapacity = interceptorCapacity;
+    layout->targetCount = targets.size();
+    layout->targetsOffset = targetsOffset;
+    layout->frameOffsets[0] = frameOffset;
+    layout->frameOffsets[1] = frameOffset + frameBytes;
+    layout->frameBytes = frameBytes;
+    layout->originLatitude = origin.latitude;
+    layout->originLongitude = origin.longitude;
+    layout->originAltitude = origin.altitude;
+
+    TargetRecord *targetRecords = reinterpret_cast<TargetRecord *>(base + targetsOffset);
+    for (size_t i = 0; i < targets.size(); ++i)
+    {
+        TargetRecord &record = targetRecords[i];
+        record.id = targets[i].id;
+        copyName(record.name, targets[i].name);
+        record.latitude = targets[i].location.latitude;
+        record.longitude = targets[i].location.longitude;
+        record.altitude = targets[i].location.altitude;
+        record.position = targets[i].position;
+    }
+    for (uint64_t offset : layout->frameOffsets)
+    {
+        new (base + offset) FrameHeader();
+    }
+
+    // Readers only trust the region once the magic is there
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(layout->magic, MAGIC, sizeof(MAGIC));
+}
+
+WorldPublisher::~WorldPublisher()
+{
+    ::munmap(base, size);
+    ::shm_unlink(name.c_str());
+}
+
+uint64_t WorldPublisher::getFramesPublished() const
+{
+    return reinterpret_cast<const Header *>(base)->published.load(std::memory_order_relaxed);
+}
+
+void WorldPublisher::publish(long tick, const TrackStore &tracks, const std::vector<ThreatReport> &threats,
+                             const std::vector<Missile> &inventory, const std::vector<Missile> &inFlight)
+{
+    Header &layout = header();
+    uint64_t published = layout.published.load(std::memory_order_relaxed);
+    // The frame readers are not on: the older of the two
+    FrameHeader &frame = *reinterpret_cast<FrameHeader *>(base + layout.frameOffsets[published & 1]);
+
+    uint64_t sequence = frame.sequence.load(std::memory_order_relaxed);
+    frame.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    unsigned char *records = reinterpret_cast<unsigned char *>(&frame) + align8(sizeof(FrameHeader));
+    TrackRecord *trackRecords = reinterpret_cast<TrackRecord *>(records);
+    records += align8(layout.trackCapacity * sizeof(TrackRecord));
+    ThreatRecord *threatRecords = reinterpret_cast<ThreatRecord *>(records);
+    records += align8(layout.threatCapacity * sizeof(ThreatRecord));
+    InterceptorRecord *interceptorRecords = reinterpret_cast<InterceptorRecord *>(records);
+
+    size_t trackCount = std::min<size_t>(tracks.size(), layout.trackCapacity);
+    const int *ids = tracks.idData();
+    const int *targetIds = tracks.targetIdData();
+    const double *speeds = tracks.speedData();
+    for (size_t i = 0; i < trackCount; ++i)
+    {
+        trackRecords[i] = {ids[i], targetIds[i], tracks.positionAt(i), tracks.targetAt(i), speeds[i]};
+    }
+
+    size_t threatCount = std::min<size_t>(threats.size(), layout.threatCapacity);
+    for (size_t i = 0; i < threatCount; ++i)
+    {
+        const ThreatReport &threat = threats[i];
+        threatRecords[i] = {threat.detectionId, threat.enemyId, threat.targetId, 0,
+                            threat.distanceToTarget, threat.calculatedSpeed, threat.timeToImpact,
+                            threat.enemyPosition, threat.enemyVelocity};
+    }
+
+    size_t interceptorCount = 0;
+    for (const Missile &missile : inventory)
+    {
+        if (interceptorCount < layout.interceptorCapacity)
+        {
+            fillInterceptor(interceptorRecords[interceptorCount++], missile, INTERCEPTOR_READY);
+        }
+    }
+    for (const Missile &missile : inFlight)
+    {
+        if (interceptorCount < layout.interceptorCapacity)
+        {
+            fillInterceptor(interceptorRecords[interceptorCount++], missile, INTERCEPTOR_IN_FLIGHT);
+        }
+    }
+
+    frame.tick = tick;
+    frame.trackCount = trackCount;
+    frame.threatCount = threatCount;
+    frame.interceptorCount = interceptorCount;
+    frame.truncated = trackCount < tracks.size() || threatCount < threats.size() ||
+                      interceptorCount < inventory.size() + inFlight.size();
+
+    frame.sequence.store(sequence + 2, std::memory_order_release);
+    layout.published.store(published + 1, std::memory_order_release);
+}
@@ -0,0 +1,130 @@
+#include "world_snapshot.h"
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+    size_t align8(size_t bytes)
+    {
+        return (bytes + 7) & ~static_cast<size_t>(7);
+    }
+
+    std::runtime_error snapshotError(const std::string &name, const std::string &message)
+    {
+        return std::runtime_error("world snapshot " + name + ": " + message);
+    }
+}
+
+size_t world_snapshot::frameBytes(uint64_t trackCapacity, uint64_t threatCapacity, uint64_t interceptorCapacity)
+{
+    return align8(sizeof(FrameHeader)) + align8(trackCapacity * sizeof(TrackRecord)) +
+           align8(threatCapacity * sizeof(ThreatRecord)) + align8(interceptorCapacity * sizeof(InterceptorRecord));
+}
+
+WorldSnapshotReader::WorldSnapshotReader(const std::string &name) : name(name)
+{
+    int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+    {
+        throw snapshotError(name, std::string("cannot open: ") + std::strerror(errno));
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(world_snapshot::Header))
+    {
+        ::close(fd);
+        throw snapshotError(name, "not set up yet");
+    }
+    size = static_cast<size_t>(info.st_size);
+    void *mapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        throw snapshotError(name, std::string("mmap failed: ") + std::strerror(errno));
+    }
+    base = static_cast<unsigned char *>(mapping);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const world_snapshot::Header &layout = header();
+    if (std::memcmp(layout.magic, world_snapshot::MAGIC, sizeof(layout.magic)) != 0)
+    {
+        ::munmap(base, size);
+        throw snapshotError(name, "not a world snapshot, or not set up yet");
+    }
+    if (layout.version != world_snapshot::VERSION)
+    {
+        ::munmap(base, size);
+        throw snapshotError(name, "unsupported version " + std::to_string(layout.version));
+    }
+    if (layout.frameOffsets[1] + layout.frameBytes > size)
+    {
+        ::munmap(base, size);
+        throw snapshotError(name, "truncated region");
+    }
+}
+
+WorldSnapshotReader::~WorldSnapshotReader()
+{
+    ::munmap(base, size);
+}
+
+const world_snapshot::TargetRecord *WorldSnapshotReader::targets() const
+{
+    return reinterpret_cast<const world_snapshot::TargetRecord *>(base + header().targetsOffset);
+}
+
+bool WorldSnapshotReader::writerAlive() const
+{
+    pid_t pid = static_cast<pid_t>(header().writerPid);
+    return ::kill(pid, 0) == 0 || errno == EPERM;
+}
+
+bool WorldSnapshotReader::begin(WorldSnapshotView &view, uint64_t &sequence)
+{
+    using namespace world_snapshot;
+
+    const Header &layout = header();
+    while (true)
+    {
+        uint64_t published = layout.published.load(std::memory_order_acquire);
+        if (published == 0)
+        {
+            return false;
+        }
+        frame = reinterpret_cast<const FrameHeader *>(base + layout.frameOffsets[(published - 1) & 1]);
+        sequence = frame->sequence.load(std::memory_order_acquire);
+        if (sequence & 1)
+        {
+            // The writer is already two frames on and refilling this one
+            ++retries;
+            continue;
+        }
+
+        const unsigned char *records = reinterpret_cast<const unsigned char *>(frame) + align8(sizeof(FrameHeader));
+        view.tick = static_cast<long>(frame->tick);
+        view.truncated = frame->truncated != 0;
+        // Counts are clamped so a torn read can't walk off the frame
+        view.trackCount = std::min<uint64_t>(frame->trackCount, layout.trackCapacity);
+        view.threatCount = std::min<uint64_t>(frame->threatCount, layout.threatCapacity);
+        view.interceptorCount = std::min<uint64_t>(frame->interceptorCount, layout.interceptorCapacity);
+        view.tracks = reinterpret_cast<const TrackRecord *>(records);
+        records += align8(layout.trackCapacity * sizeof(TrackRecord));
+        view.threats = reinterpret_cast<const ThreatRecord *>(records);
+        records += align8(layout.threatCapacity * sizeof(ThreatRecord));
+        view.interceptors = reinterpret_cast<const InterceptorRecord *>(records);
+        return true;
+    }
+}
+
+bool WorldSnapshotReader::validate(uint64_t sequence) const
+{
+    // Everything visit read happens before the second look at the counter
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return frame->sequence.load(std::memory_order_relaxed) == sequence;
+}
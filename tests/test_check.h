@@ -0,0 +1,38 @@
+#ifndef TEST_CHECK_H
+#define TEST_CHECK_H
+
+// Minimal assertions for the unit tests: a failed CHECK prints where and
+// what, the test keeps going, and TEST_RESULT() turns the tally into the
+// exit code ctest looks at. No external dependencies, like the bench harness.
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace test
+{
+    inline int &failures()
+    {
+        static int count = 0;
+        return count;
+    }
+
+    inline void check(bool ok, const char *expression, const char *file, int line)
+    {
+        if (!ok)
+        {
+            std::cerr << file << ":" << line << ": CHECK failed: " << expression << std::endl;
+            ++failures();
+        }
+    }
+
+    inline bool near(double a, double b, double tolerance = 1e-9)
+    {
+        return std::fabs(a - b) <= tolerance * std::max(1.0, std::max(std::fabs(a), std::fabs(b)));
+    }
+}
+
+#define CHECK(expression) test::check(static_cast<bool>(expression), #expression, __FILE__, __LINE__)
+#define TEST_RESULT() (test::failures() == 0 ? 0 : 1)
+
+#endif // TEST_CHECK_H
@@ -0,0 +1,135 @@
+// WGS-84 conversions: known points on the axes and at 45 degrees, geodetic
+// -> ECEF -> geodetic round trips from pole to pole and from below sea level
+// to orbit, and the local frame being an exact rotation of ECEF about its origin
+#include <cmath>
+#include "geodetic.h"
+#include "test_check.h"
+
+namespace
+{
+    // ECEF and local coordinates to a micrometre, angles to 1e-9 degrees (0.1 mm
+    // on the ground), altitude to a micrometre, unit vectors to 1e-12
+    const double METRES = 1e-6;
+    const double DEGREES = 1e-9;
+    const double UNIT = 1e-12;
+
+    const double POLAR_RADIUS = wgs84::SEMI_MAJOR_AXIS * (1.0 - wgs84::FLATTENING);
+
+    bool near(double a, double b, double tolerance)
+    {
+        return std::fabs(a - b) <= tolerance;
+    }
+
+    bool near(const Position &a, const Position &b, double tolerance)
+    {
+        return near(a.x, b.x, tolerance) && near(a.y, b.y, tolerance) && near(a.z, b.z, tolerance);
+    }
+
+    double distance(const Position &a, const Position &b)
+    {
+        return std::sqrt((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y) + (a.z - b.z) * (a.z - b.z));
+    }
+
+    void knownPoints()
+    {
+        const double a = wgs84::SEMI_MAJOR_AXIS;
+
+        // Equator on the prime meridian, at 90 east, and on the antimeridian
+        CHECK(near(geodeticToEcef({0.0, 0.0, 0.0}), {a, 0.0, 0.0}, METRES));
+        CHECK(near(geodeticToEcef({0.0, 90.0, 0.0}), {0.0, a, 0.0}, METRES));
+        CHECK(near(geodeticToEcef({0.0, 180.0, 0.0}), {-a, 0.0, 0.0}, METRES));
+        // Altitude is along the normal, which on the equator is radial
+        CHECK(near(geodeticToEcef({0.0, 0.0, 1000.0}), {a + 1000.0, 0.0, 0.0}, METRES));
+        // The poles sit on the semi-minor axis
+        CHECK(near(geodeticToEcef({90.0, 0.0, 0.0}), {0.0, 0.0, POLAR_RADIUS}, METRES));
+        CHECK(near(geodeticToEcef({-90.0, 0.0, 0.0}), {0.0, 0.0, -POLAR_RADIUS}, METRES));
+        // 45 N on the prime meridian, published WGS-84 values
+        CHECK(near(geodeticToEcef({45.0, 0.0, 0.0}), {4517590.878849, 0.0, 4487348.408866}, METRES));
+
+        GeodeticPosition origin = ecefToGeodetic({a, 0.0, 0.0});
+        CHECK(near(origin.latitude, 0.0, DEGREES) && near(origin.longitude, 0.0, DEGREES) &&
+              near(origin.altitude, 0.0, METRES));
+        GeodeticPosition east = ecefToGeodetic({0.0, a + 250.0, 0.0});
+        CHECK(near(east.latitude, 0.0, DEGREES) && near(east.longitude, 90.0, DEGREES) &&
+              near(east.altitude, 250.0, METRES));
+        // On the polar axis longitude is arbitrary; latitude and height are not
+        GeodeticPosition north = ecefToGeodetic({0.0, 0.0, POLAR_RADIUS + 500.0});
+        CHECK(near(north.latitude, 90.0, DEGREES) && near(north.altitude, 500.0, METRES));
+        GeodeticPosition south = ecefToGeodetic({0.0, 0.0, -POLAR_RADIUS});
+        CHECK(near(south.latitude, -90.0, DEGREES) && near(south.altitude, 0.0, METRES));
+        GeodeticPosition mid = ecefToGeodetic({4517590.878849, 0.0, 4487348.408866});
+        CHECK(near(mid.latitude, 45.0, DEGREES) && near(mid.longitude, 0.0, DEGREES) &&
+              near(mid.altitude, 0.0, METRES));
+    }
+
+    void roundTrips()
+    {
+        const double latitudes[] = {-89.9, -60.0, -33.3, -1e-7, 0.0, 12.5, 45.0, 71.0, 89.9};
+        const double longitudes[] = {-179.9, -120.0, -0.5, 0.0, 33.0, 97.5, 179.9};
+        const double altitudes[] = {-430.0, 0.0, 1500.0, 35000.0, 400000.0};
+        for (double latitude : latitudes)
+        {
+            for (double longitude : longitudes)
+            {
+                for (double altitude : altitudes)
+                {
+                    GeodeticPosition location = {latitude, longitude, altitude};
+                    GeodeticPosition back = ecefToGeodetic(geodeticToEcef(location));
+                    CHECK(near(back.latitude, latitude, DEGREES));
+                    CHECK(near(back.longitude, longitude, DEGREES));
+                    CHECK(near(back.altitude, altitude, METRES));
+                }
+            }
+        }
+    }
+
+    void localFrame()
+    {
+        GeodeticPosition origin = {38.8977, -77.0365, 18.0};
+        LocalFrame frame(origin);
+
+        // The origin is the frame's zero, straight up is +z
+        CHECK(near(frame.fromGeodetic(origin), {0.0, 0.0, 0.0}, METRES));
+        CHECK(near(frame.fromGeodetic({origin.latitude, origin.longitude, origin.altitude + 100.0}),
+                   {0.0, 0.0, 100.0}, METRES));
+        // Slightly north is +y, slightly east is +x, both nearly level
+        Position north = frame.fromGeodetic({origin.latitude + 0.01, origin.longitude, origin.altitude});
+        Position east = frame.fromGeodetic({origin.latitude, origin.longitude + 0.01, origin.altitude});
+        CHECK(north.y > 1000.0 && near(north.x, 0.0, METRES) && std::fabs(north.z) < 1.0);
+        CHECK(east.x > 800.0 && std::fabs(east.y) < 1.0 && std::fabs(east.z) < 1.0);
+
+        // Round trips through ECEF and through geodetic, near and 500 km out
+        const Position points[] = {{0.0, 0.0, 0.0}, {1234.5, -6789.0, 321.0}, {-250000.0, 400000.0, -15000.0}};
+        for (const Position &point : points)
+        {
+            CHECK(near(frame.fromEcef(frame.toEcef(point)), point, METRES));
+            CHECK(near(frame.fromGeodetic(frame.toGeodetic(point)), point, METRES));
+        }
+
+        // A rotation: distances in the frame are ECEF distances
+        GeodeticPosition far = {51.5, -0.12, 30.0};
+        Position nearEcef = geodeticToEcef(origin);
+        Position farEcef = geodeticToEcef(far);
+        CHECK(near(distance(frame.fromGeodetic(origin), frame.fromGeodetic(far)), distance(nearEcef, farEcef), METRES));
+
+        // The axes at the origin are the frame's own
+        LocalFrame::Axes axes = frame.axesAt(origin);
+        CHECK(near(axes.east, {1.0, 0.0, 0.0}, UNIT));
+        CHECK(near(axes.north, {0.0, 1.0, 0.0}, UNIT));
+        CHECK(near(axes.up, {0.0, 0.0, 1.0}, UNIT));
+
+        // The default frame sits on the equator at the prime meridian: east is ECEF +y, up is +x
+        LocalFrame equator;
+        CHECK(near(equator.toEcef({1.0, 0.0, 0.0}), {wgs84::SEMI_MAJOR_AXIS, 1.0, 0.0}, METRES));
+        CHECK(near(equator.toEcef({0.0, 1.0, 0.0}), {wgs84::SEMI_MAJOR_AXIS, 0.0, 1.0}, METRES));
+        CHECK(near(equator.toEcef({0.0, 0.0, 1.0}), {wgs84::SEMI_MAJOR_AXIS + 1.0, 0.0, 0.0}, METRES));
+    }
+}
+
+int main()
+{
+    knownPoints();
+    roundTrips();
+    localFrame();
+    return TEST_RESULT();
+}
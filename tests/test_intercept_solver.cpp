@@ -0,0 +1,171 @@
+// Intercept solver: closed-form times on hand-checked geometry, infinity
+// for pairs that can never meet or only meet once the track has hit its
+// target, and the batched kernels (AVX2 where the CPU
+// has it, scalar) agreeing bit for bit with each other and with solveIntercept
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+#include "intercept_solver.h"
+#include "test_check.h"
+
+namespace
+{
+    const double INF = std::numeric_limits<double>::infinity();
+
+    bool sameBits(double a, double b)
+    {
+        return std::memcmp(&a, &b, sizeof(double)) == 0;
+    }
+
+    void handCheckedGeometry()
+    {
+        // Standing target 100 m out, 10 m per tick
+        InterceptSolution still = solveIntercept({0, 0, 0}, 10.0, {100, 0, 0}, {0, 0, 0});
+        CHECK(still.reachable());
+        CHECK(test::near(still.timeToGo, 10.0));
+        CHECK(test::near(still.point.x, 100.0));
+
+        // Head-on at the same speed: they meet halfway
+        InterceptSolution headOn = solveIntercept({0, 0, 0}, 10.0, {100, 0, 0}, {-10, 0, 0});
+        CHECK(test::near(headOn.timeToGo, 5.0));
+        CHECK(test::near(headOn.point.x, 50.0));
+
+        // Crossing target 3-4-5: target at (0, 30) moving +x at 4, interceptor speed 5 meets it at t = 10
+        InterceptSolution crossing = solveIntercept({0, 0, 0}, 5.0, {0, 30, 0}, {4, 0, 0});
+        CHECK(test::near(crossing.timeToGo, 10.0));
+        CHECK(test::near(crossing.point.x, 40.0));
+        CHECK(test::near(crossing.point.y, 30.0));
+
+        // Already there
+        CHECK(solveIntercept({1, 2, 3}, 5.0, {1, 2, 3}, {7, 0, 0}).timeToGo == 0.0);
+    }
+
+    void unreachableIsInfinity()
+    {
+        // A slower interceptor behind a receding target never catches it
+        InterceptSolution behind = solveIntercept({0, 0, 0}, 5.0, {100, 0, 0}, {10, 0, 0});
+        CHECK(!behind.reachable());
+        CHECK(behind.timeToGo == INF);
+        CHECK(behind.point.x == 100.0 && behind.point.y == 0.0 && behind.point.z == 0.0);
+
+        // Equal speed, target running straight away
+        CHECK(solveIntercept({0, 0, 0}, 10.0, {100, 0, 0}, {10, 0, 0}).timeToGo == INF);
+
+        // Fast crossing target the slow interceptor can't cut off (no real root)
+        CHECK(solveIntercept({0, 0, 0}, 1.0, {0, 100, 0}, {50, 0, 0}).timeToGo == INF);
+    }
+
+    void nothingPastTheHorizon()
+    {
+        // Standing target reached at t = 10: a track that impacts first is gone by then
+        CHECK(test::near(solveIntercept({0, 0, 0}, 10.0, {100, 0, 0}, {0, 0, 0}, 10.5).timeToGo, 10.0));
+        InterceptSolution late = solveIntercept({0, 0, 0}, 10.0, {100, 0, 0}, {0, 0, 0}, 9.5);
+        CHECK(!late.reachable());
+        CHECK(late.point.x == 100.0);
+        CHECK(!solveIntercept({0, 0, 0}, 10.0, {100, 0, 0}, {0, 0, 0}, 10.0).reachable()); // At the horizon
+        // A track already on its target can't be intercepted even from right there
+        CHECK(!solveIntercept({1, 2, 3}, 5.0, {1, 2, 3}, {0, 0, 0}, 0.0).reachable());
+    }
+
+    void solutionsMeetTheTarget()
+    {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<double> coordinate(-5000.0, 5000.0);
+        std::uniform_real_distribution<double> velocity(-60.0, 60.0);
+        std::uniform_real_distribution<double> speed(20.0, 120.0);
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            Position from{coordinate(rng), coordinate(rng), coordinate(rng)};
+            Position target{coordinate(rng), coordinate(rng), coordinate(rng)};
+            Position v{velocity(rng), velocity(rng), velocity(rng)};
+            double s = speed(rng);
+            InterceptSolution solution = solveIntercept(from, s, target, v);
+            if (!solution.reachable())
+            {
+                continue;
+            }
+            CHECK(solution.timeToGo >= 0.0);
+            double dx = solution.point.x - from.x, dy = solution.point.y - from.y, dz = solution.point.z - from.z;
+            CHECK(test::near(std::sqrt(dx * dx + dy * dy + dz * dz), s * solution.timeToGo, 1e-6));
+        }
+    }
+
+    void kernelsAgree()
+    {
+        std::mt19937 rng(11);
+        std::uniform_real_distribution<double> coordinate(-5000.0, 5000.0);
+        std::uniform_real_distribution<double> velocity(-100.0, 100.0);
+        std::uniform_real_distribution<double> speed(20.0, 120.0);
+
+        // Column count not a multiple of four, so the vector loop's scalar tail runs too
+        const size_t cols = 37, rows = 25;
+        std::vector<Position> interceptors(cols);
+        std::vector<double> speeds(cols);
+        InterceptSolver scalar, automatic, avx2;
+        scalar.setKernel(InterceptSolver::Kernel::Scalar);
+        avx2.setKernel(InterceptSolver::Kernel::Avx2);
+        for (size_t col = 0; col < cols; ++col)
+        {
+            interceptors[col] = {coordinate(rng), coordinate(rng), coordinate(rng)};
+            speeds[col] = speed(rng);
+            for (InterceptSolver *solver : {&scalar, &automatic, &avx2})
+            {
+                solver->addInterceptor(interceptors[col], speeds[col]);
+            }
+        }
+
+        // Every other row has a horizon that cuts some of its solutions off
+        std::uniform_real_distribution<double> horizon(20.0, 200.0);
+        std::vector<Position> targets(rows), velocities(rows);
+        std::vector<double> horizons(rows);
+        for (size_t row = 0; row < rows; ++row)
+        {
+            targets[row] = {coordinate(rng), coordinate(rng), coordinate(rng)};
+            velocities[row] = {velocity(rng), velocity(rng), velocity(rng)};
+            horizons[row] = row % 2 ? horizon(rng) : INF;
+        }
+        targets[0] = interceptors[3]; // An already-there pair inside the vector loop
+
+        std::vector<double> scalarTimes(rows * cols), autoTimes(rows * cols), avx2Times(rows * cols);
+        scalar.solve(targets.data(), velocities.data(), horizons.data(), rows, scalarTimes.data());
+        automatic.solve(targets.data(), velocities.data(), horizons.data(), rows, autoTimes.data());
+        avx2.solve(targets.data(), velocities.data(), horizons.data(), rows, avx2Times.data());
+
+        size_t unreachable = 0;
+        for (size_t row = 0; row < rows; ++row)
+        {
+            for (size_t col = 0; col < cols; ++col)
+            {
+                size_t i = row * cols + col;
+                double single = solveIntercept(interceptors[col], speeds[col], targets[row], velocities[row],
+                                               horizons[row]).timeToGo;
+                CHECK(sameBits(scalarTimes[i], single));
+                CHECK(sameBits(autoTimes[i], scalarTimes[i]));
+                CHECK(sameBits(avx2Times[i], scalarTimes[i]));
+                unreachable += scalarTimes[i] == INF;
+            }
+        }
+        CHECK(scalarTimes[3] == 0.0);
+        // Fast targets and slow interceptors: both outcomes must be exercised
+        CHECK(unreachable > 0 && unreachable < rows * cols);
+
+        if (!InterceptSolver::avx2Available())
+        {
+            std::cout << "AVX2 not available, the Avx2 kernel fell back to scalar" << std::endl;
+        }
+    }
+}
+
+int main()
+{
+    handCheckedGeometry();
+    unreachableIsInfinity();
+    nothingPastTheHorizon();
+    solutionsMeetTheTarget();
+    kernelsAgree();
+    return TEST_RESULT();
+}
@@ -0,0 +1,93 @@
+// Monte Carlo runs are reproducible: the same seed gives the same replicates
+// and the same distributions on one worker and on four, and a different seed
+// gives a different sample
+#include <vector>
+#include "monte_carlo.h"
+#include "test_check.h"
+
+namespace
+{
+    MonteCarloConfig smallSweep(size_t workers, uint64_t seed)
+    {
+        MonteCarloConfig config;
+        config.replicates = 48;
+        config.ticks = 400;
+        config.seed = seed;
+        config.workers = workers;
+        config.maxAutoIntercept = 60;
+        return config;
+    }
+
+    bool sameReplicates(const MonteCarloReport &a, const MonteCarloReport &b)
+    {
+        if (a.replicates.size() != b.replicates.size())
+        {
+            return false;
+        }
+        for (size_t r = 0; r < a.replicates.size(); ++r)
+        {
+            const ReplicateResult &x = a.replicates[r];
+            const ReplicateResult &y = b.replicates[r];
+            if (x.leakers != y.leakers || x.expended != y.expended || x.destroyed != y.destroyed ||
+                x.survivors != y.survivors || x.ticks != y.ticks)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool sameSummary(const SampleSummary &a, const SampleSummary &b)
+    {
+        return a.mean == b.mean && a.stddev == b.stddev && a.min == b.min && a.p50 == b.p50 &&
+               a.p90 == b.p90 && a.p99 == b.p99 && a.max == b.max;
+    }
+
+    bool sameHistogram(const LatencyHistogram &a, const LatencyHistogram &b)
+    {
+        for (double quantile : {0.5, 0.9, 0.99})
+        {
+            if (a.percentile(quantile) != b.percentile(quantile))
+            {
+                return false;
+            }
+        }
+        return a.getCount() == b.getCount() && a.getMin() == b.getMin() && a.getMax() == b.getMax() &&
+               a.getMean() == b.getMean();
+    }
+
+    void workerCountDoesNotMatter()
+    {
+        // As many interceptors as tracks, so how many get through depends on the draw
+        Scenario scenario = Scenario::makeSalvo(60, 60, 7);
+        MonteCarloReport single = runMonteCarlo(scenario, smallSweep(1, 11));
+        MonteCarloReport pooled = runMonteCarlo(scenario, smallSweep(4, 11));
+
+        CHECK(single.replicates.size() == 48);
+        CHECK(sameReplicates(single, pooled));
+        CHECK(sameSummary(single.leakers(), pooled.leakers()));
+        CHECK(sameSummary(single.expended(), pooled.expended()));
+        CHECK(single.leakProbability() == pooled.leakProbability());
+        CHECK(sameHistogram(single.timeToEngage, pooled.timeToEngage));
+
+        // Not trivially equal: the raid is engaged and the replicates differ
+        CHECK(single.timeToEngage.getCount() > 0);
+        CHECK(single.expended().max > 0);
+        bool spread = false;
+        for (const ReplicateResult &result : single.replicates)
+        {
+            spread = spread || result.leakers != single.replicates[0].leakers ||
+                     result.destroyed != single.replicates[0].destroyed;
+        }
+        CHECK(spread);
+
+        MonteCarloReport reseeded = runMonteCarlo(scenario, smallSweep(4, 12));
+        CHECK(!sameReplicates(single, reseeded));
+    }
+}
+
+int main()
+{
+    workerCountDoesNotMatter();
+    return TEST_RESULT();
+}
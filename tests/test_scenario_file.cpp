@@ -0,0 +1,124 @@
+// Binary scenario files: a saved salvo maps back with the same tracks, and a
+// file whose ID index does not match its ID column is refused on load rather
+// than handed to the track store
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include "scenario.h"
+#include "scenario_file.h"
+#include "test_check.h"
+
+using namespace scenario_file;
+
+namespace
+{
+    const size_t TRACKS = 64;
+
+    Header readHeader(const std::string &path)
+    {
+        Header header;
+        std::ifstream in(path, std::ios::binary);
+        in.read(reinterpret_cast<char *>(&header), sizeof(header));
+        return header;
+    }
+
+    void writeInt(const std::string &path, uint64_t offset, int32_t value)
+    {
+        std::fstream out(path, std::ios::binary | std::ios::in | std::ios::out);
+        out.seekp(static_cast<std::streamoff>(offset));
+        out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+    int32_t readInt(const std::string &path, uint64_t offset)
+    {
+        int32_t value = 0;
+        std::ifstream in(path, std::ios::binary);
+        in.seekg(static_cast<std::streamoff>(offset));
+        in.read(reinterpret_cast<char *>(&value), sizeof(value));
+        return value;
+    }
+
+    uint64_t columnAt(const Header &header, int column, uint64_t entry)
+    {
+        return header.trackSectionOffset + header.columnOffsets[column] + entry * sizeof(int32_t);
+    }
+
+    bool loads(const std::string &path)
+    {
+        try
+        {
+            MappedScenarioFile file(path);
+            return true;
+        }
+        catch (const std::runtime_error &)
+        {
+            return false;
+        }
+    }
+
+    void roundTrip(const std::string &path)
+    {
+        Scenario saved = Scenario::makeSalvo(TRACKS, 4, 3);
+        saved.saveBinary(path);
+        Scenario loaded = Scenario::loadBinary(path);
+
+        CHECK(loaded.trackCount() == TRACKS);
+        TrackStore tracks;
+        tracks.adopt(loaded.trackFile->mapTracks());
+        CHECK(tracks.size() == TRACKS);
+        for (size_t i = 0; i < TRACKS; ++i)
+        {
+            const EnemyMissile &enemy = saved.enemies[i];
+            CHECK(tracks.indexOf(enemy.getId()) >= 0);
+            Position position = tracks.positionAt(static_cast<size_t>(tracks.indexOf(enemy.getId())));
+            const Position &start = enemy.getCurrentPosition();
+            CHECK(position.x == start.x && position.y == start.y && position.z == start.z);
+        }
+    }
+
+    // Each corruption on a fresh copy of the saved file; none may load
+    void corruptIndexRejected(const std::string &path)
+    {
+        Header header = readHeader(path);
+        CHECK(header.trackCount == TRACKS);
+        std::string copy = path + ".bad";
+        auto corrupt = [&](uint64_t offset, int32_t value)
+        {
+            std::filesystem::copy_file(path, copy, std::filesystem::copy_options::overwrite_existing);
+            writeInt(copy, offset, value);
+            return loads(copy);
+        };
+
+        int32_t firstId = readInt(path, columnAt(header, COLUMN_IDS, 0));
+        int32_t lastId = readInt(path, columnAt(header, COLUMN_IDS, TRACKS - 1));
+        CHECK(loads(path));
+
+        // ID past the end of the index, and negative
+        CHECK(!corrupt(columnAt(header, COLUMN_IDS, 0), static_cast<int32_t>(header.trackIndexSize)));
+        CHECK(!corrupt(columnAt(header, COLUMN_IDS, 0), -1));
+        // Two rows claiming one ID
+        CHECK(!corrupt(columnAt(header, COLUMN_IDS, 0), lastId));
+        // Index entry pointing a real ID at another row, or past the rows
+        CHECK(!corrupt(columnAt(header, COLUMN_INDEX_BY_ID, static_cast<uint64_t>(firstId)), 1));
+        CHECK(!corrupt(columnAt(header, COLUMN_INDEX_BY_ID, static_cast<uint64_t>(firstId)),
+                       static_cast<int32_t>(TRACKS)));
+        // A stray entry for an ID no track has (IDs below the first salvo ID are unused)
+        CHECK(firstId > 0);
+        CHECK(!corrupt(columnAt(header, COLUMN_INDEX_BY_ID, 0), 0));
+
+        std::remove(copy.c_str());
+    }
+}
+
+int main()
+{
+    std::string path = (std::filesystem::temp_directory_path() / "norad_test_scenario.nsc").string();
+
+    roundTrip(path);
+    corruptIndexRejected(path);
+
+    std::remove(path.c_str());
+    return TEST_RESULT();
+}
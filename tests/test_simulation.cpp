@@ -0,0 +1,172 @@
+// Whole-simulation behaviour: auto-intercept only spends interceptors that
+// arrive before their threat impacts, so every launch is a kill and a threat
+// nothing can catch in time is left alone; the event-driven core reports the
+// same stats as the tick core
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "simulation.h"
+#include "test_check.h"
+
+namespace
+{
+    void everyLaunchKills(MissileController::AssignmentMode mode)
+    {
+        Simulation sim(Scenario::makeSalvo(2000, 120));
+        MissileController &controller = sim.getController();
+        controller.setVerbose(false);
+        controller.setAssignmentMode(mode);
+        controller.setMaxAutoInterceptMissiles(120);
+
+        SimulationStats run = sim.runHeadless(1000);
+        CHECK(run.interceptsLaunched > 50);
+        CHECK(run.enemiesDestroyed == run.interceptsLaunched);
+    }
+
+    // Each default pad is a couple of kilometres from its city, so a big enough
+    // raid can use up every interceptor; global assignment must not stop at
+    // the most urgent threats when those are the ones nobody can reach anymore
+    void globalSpendsTheWholeMagazine()
+    {
+        Scenario scenario = Scenario::makeSalvo(5000, 300);
+        for (size_t i = 0; i < scenario.pads.size(); ++i)
+        {
+            Position pad = scenario.pads[i].position;
+            Position city = scenario.targets[i].position;
+            CHECK(std::hypot(pad.x - city.x, pad.y - city.y, pad.z - city.z) < 2500.0);
+        }
+
+        Simulation sim(scenario);
+        MissileController &controller = sim.getController();
+        controller.setVerbose(false);
+        controller.setAssignmentMode(MissileController::AssignmentMode::Global);
+        controller.setAssignmentLimits(controller.getMaxAssignmentPairs(), std::chrono::microseconds::max());
+        controller.setMaxAutoInterceptMissiles(300);
+
+        SimulationStats run = sim.runHeadless(1000);
+        CHECK(run.interceptsLaunched == 300);
+        CHECK(run.enemiesDestroyed == 300);
+    }
+
+    void noLaunchThatArrivesAfterImpact()
+    {
+        MissileController controller;
+        controller.setVerbose(false);
+        controller.setAutoIntercept(true);
+        controller.addMissile(Missile(1, 100, "Patriot", 80.0, {0, 0, 0}));
+
+        // 8000 m out and head-on: 50 ticks to go at 80 + 80 m per tick
+        ThreatReport threat{};
+        threat.detectionId = threat.enemyId = 7;
+        threat.targetId = -1;
+        threat.distanceToTarget = 100.0;
+        threat.enemyPosition = {8000, 0, 0};
+        threat.enemyVelocity = {-80, 0, 0};
+
+        // Impact in 40 ticks, before the interceptor could get there
+        threat.timeToImpact = 40.0;
+        std::vector<ThreatReport> threats{threat};
+        CHECK(controller.autoInterceptThreats(threats).empty());
+        CHECK(controller.getInFlightCount() == 0);
+
+        controller.setAssignmentMode(MissileController::AssignmentMode::Greedy);
+        CHECK(controller.autoInterceptThreats(threats).empty());
+        CHECK(controller.interceptThreat(threat) == -1);
+
+        // With 60 ticks left it is a fair shot
+        threats[0].timeToImpact = 60.0;
+        CHECK(controller.autoInterceptThreats(threats).size() == 1);
+        CHECK(controller.getInFlightCount() == 1);
+        CHECK(controller.getInFlightMissiles()[0].getFlightSteps() == 50);
+    }
+
+    // The event-driven core schedules each track's events with stepsUntilWithin
+    // and reports from stepAlong; both must match what moveAll really does
+    void predictionsFollowMoveAll()
+    {
+        Simulation sim(Scenario::makeSalvo(20000, 1, 1));
+        const TrackStore &start = sim.getEnemies();
+        TrackStore moved = start;
+        const long horizon = 600;
+        const double threshold = 2000.0;
+
+        std::vector<long> entry(start.size()), engage(start.size()), impact(start.size());
+        for (size_t i = 0; i < start.size(); ++i)
+        {
+            entry[i] = std::max(1L, start.stepsUntilWithin(i, DetectionSystem::THREAT_RANGE, false, horizon));
+            engage[i] = std::max(1L, start.stepsUntilWithin(i, threshold, true, horizon));
+            impact[i] = std::max(1L, start.stepsUntilWithin(i, 0.0, true, horizon));
+        }
+
+        size_t mismatches = 0, stepMismatches = 0;
+        std::vector<Position> stepped(start.size());
+        for (size_t i = 0; i < start.size(); ++i)
+        {
+            stepped[i] = start.positionAt(i);
+        }
+        for (long tick = 1; tick <= horizon; ++tick)
+        {
+            moved.moveAll();
+            for (size_t i = 0; i < moved.size(); ++i)
+            {
+                Position position = moved.positionAt(i);
+                Position target = moved.targetAt(i);
+                double dx = position.x - target.x, dy = position.y - target.y, dz = position.z - target.z;
+                double distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+                // The first tick each condition holds must be the predicted one
+                mismatches += (distance < DetectionSystem::THREAT_RANGE) != (tick >= entry[i]);
+                mismatches += (distance <= threshold) != (tick >= engage[i]);
+                mismatches += (distance <= 0.0) != (tick >= impact[i]);
+
+                stepped[i] = start.stepAlong(i, stepped[i], 1);
+                stepMismatches += stepped[i].x != position.x || stepped[i].y != position.y || stepped[i].z != position.z;
+            }
+        }
+        CHECK(mismatches == 0);
+        CHECK(stepMismatches == 0);
+    }
+
+    SimulationStats runCore(unsigned seed, MissileController::AssignmentMode mode, bool eventDriven)
+    {
+        Simulation sim(Scenario::makeSalvo(20000, 300, seed));
+        MissileController &controller = sim.getController();
+        controller.setVerbose(false);
+        controller.setAssignmentMode(mode);
+        controller.setMaxAutoInterceptMissiles(300);
+        // No time budget: a solve cut short by machine load would differ between the runs
+        controller.setAssignmentLimits(controller.getMaxAssignmentPairs(), std::chrono::microseconds::max());
+        return eventDriven ? sim.runEventDriven(1000) : sim.runHeadless(1000);
+    }
+
+    void coresAgree()
+    {
+        for (unsigned seed : {1u, 4u})
+        {
+            for (auto mode : {MissileController::AssignmentMode::Greedy, MissileController::AssignmentMode::Global})
+            {
+                SimulationStats ticked = runCore(seed, mode, false);
+                SimulationStats evented = runCore(seed, mode, true);
+                CHECK(ticked.ticks == evented.ticks);
+                CHECK(ticked.trackSteps == evented.trackSteps);
+                CHECK(ticked.threatReports == evented.threatReports);
+                CHECK(ticked.interceptsLaunched == evented.interceptsLaunched);
+                CHECK(ticked.enemiesDestroyed == evented.enemiesDestroyed);
+                CHECK(ticked.impacts == evented.impacts);
+                CHECK(evented.eventsProcessed > 0);
+            }
+        }
+    }
+}
+
+int main()
+{
+    everyLaunchKills(MissileController::AssignmentMode::Greedy);
+    everyLaunchKills(MissileController::AssignmentMode::Global);
+    globalSpendsTheWholeMagazine();
+    noLaunchThatArrivesAfterImpact();
+    predictionsFollowMoveAll();
+    coresAgree();
+    return TEST_RESULT();
+}
@@ -0,0 +1,81 @@
+// SlotMap: handles survive swap-and-pop removal of other values, and a
+// handle to a removed value never resolves again, even once its slot is reused
+#include <string>
+#include "slot_map.h"
+#include "test_check.h"
+
+namespace
+{
+    void handlesSurviveSwapAndPop()
+    {
+        SlotMap<std::string> map;
+        auto a = map.insert("a");
+        auto b = map.insert("b");
+        auto c = map.insert("c");
+
+        // Removing the first value moves the last one into its place
+        CHECK(map.erase(a));
+        CHECK(map.size() == 2);
+        CHECK(map.data()[0] == "c");
+        CHECK(map.get(b) && *map.get(b) == "b");
+        CHECK(map.get(c) && *map.get(c) == "c");
+        CHECK(map.handleAt(0) == c);
+        CHECK(map.handleAt(1) == b);
+    }
+
+    void removedHandlesStopResolving()
+    {
+        SlotMap<int> map;
+        auto first = map.insert(1);
+        CHECK(map.erase(first));
+        CHECK(!map.contains(first));
+        CHECK(map.get(first) == nullptr);
+        CHECK(!map.erase(first));
+
+        // The freed slot is reused under a new generation
+        auto second = map.insert(2);
+        CHECK(second.slot == first.slot);
+        CHECK(second.generation != first.generation);
+        CHECK(map.get(first) == nullptr);
+        CHECK(map.get(second) && *map.get(second) == 2);
+    }
+
+    void nullHandleNeverResolves()
+    {
+        SlotMap<int> map;
+        SlotMap<int>::Handle none;
+        CHECK(none.isNull());
+        map.insert(7);
+        CHECK(!map.contains(none));
+        CHECK(map.get(none) == nullptr);
+    }
+
+    void eraseDoesNotReallocate()
+    {
+        SlotMap<int> map;
+        std::vector<SlotMap<int>::Handle> handles;
+        for (int i = 0; i < 100; ++i)
+        {
+            handles.push_back(map.insert(i));
+        }
+        const int *storage = map.data().data();
+        for (size_t i = 0; i < handles.size(); i += 2)
+        {
+            CHECK(map.erase(handles[i]));
+        }
+        CHECK(map.data().data() == storage);
+        for (size_t i = 1; i < handles.size(); i += 2)
+        {
+            CHECK(map.get(handles[i]) && *map.get(handles[i]) == static_cast<int>(i));
+        }
+    }
+}
+
+int main()
+{
+    handlesSurviveSwapAndPop();
+    removedHandlesStopResolving();
+    nullHandleNeverResolves();
+    eraseDoesNotReallocate();
+    return TEST_RESULT();
+}
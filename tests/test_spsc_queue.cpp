@@ -0,0 +1,116 @@
+// SpscQueue: capacity rounding, full and empty edges, FIFO order across many
+// wraps of the ring, slots released on pop, and a producer/consumer thread
+// pair seeing every value exactly once and in order
+#include <memory>
+#include <thread>
+#include "spsc_queue.h"
+#include "test_check.h"
+
+namespace
+{
+    void capacityRoundsUpToPowerOfTwo()
+    {
+        CHECK(SpscQueue<int>(0).capacity() == 2);
+        CHECK(SpscQueue<int>(4).capacity() == 4);
+        CHECK(SpscQueue<int>(5).capacity() == 8);
+    }
+
+    void fullAndEmptyEdges()
+    {
+        SpscQueue<int> queue(4);
+        int value = -1;
+        CHECK(!queue.tryPop(value));
+        for (int i = 0; i < 4; ++i)
+        {
+            CHECK(queue.tryPush(i));
+        }
+        CHECK(!queue.tryPush(4));
+        CHECK(queue.tryPop(value) && value == 0);
+        CHECK(queue.tryPush(4)); // The freed slot is usable again
+        for (int expected = 1; expected <= 4; ++expected)
+        {
+            CHECK(queue.tryPop(value) && value == expected);
+        }
+        CHECK(!queue.tryPop(value));
+    }
+
+    void orderSurvivesWraparound()
+    {
+        // Uneven bursts so head and tail wrap the ring at every offset
+        SpscQueue<int> queue(8);
+        int next = 0, expected = 0, value;
+        for (int round = 0; round < 1000; ++round)
+        {
+            for (int i = 0; i < 1 + round % 8; ++i)
+            {
+                CHECK(queue.tryPush(next++));
+            }
+            while (queue.tryPop(value))
+            {
+                CHECK(value == expected++);
+            }
+        }
+        CHECK(expected == next);
+    }
+
+    void popReleasesTheSlot()
+    {
+        SpscQueue<std::shared_ptr<int>> queue(2);
+        auto value = std::make_shared<int>(1);
+        CHECK(queue.tryPush(value));
+        std::shared_ptr<int> out;
+        CHECK(queue.tryPop(out));
+        out.reset();
+        CHECK(value.use_count() == 1);
+    }
+
+    void twoThreads()
+    {
+        const long count = 1000000;
+        SpscQueue<long> queue(64);
+        auto produce = [&]()
+        {
+            for (long i = 0; i < count;)
+            {
+                if (queue.tryPush(i))
+                {
+                    ++i;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        };
+        std::thread producer(produce);
+
+        long expected = 0;
+        bool inOrder = true;
+        long value;
+        while (expected < count)
+        {
+            if (queue.tryPop(value))
+            {
+                inOrder = inOrder && value == expected;
+                ++expected;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+        producer.join();
+        CHECK(inOrder);
+        CHECK(!queue.tryPop(value));
+    }
+}
+
+int main()
+{
+    capacityRoundsUpToPowerOfTwo();
+    fullAndEmptyEdges();
+    orderSurvivesWraparound();
+    popReleasesTheSlot();
+    twoThreads();
+    return TEST_RESULT();
+}
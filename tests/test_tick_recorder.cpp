@@ -0,0 +1,112 @@
+// Record -> replay round trip: every replayed frame shows the tracks,
+// inventory and flights the simulation had after that tick, both read in
+// order and after seeking into the middle of the log
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "simulation.h"
+#include "tick_recorder.h"
+#include "test_check.h"
+
+namespace
+{
+    struct WorldState
+    {
+        std::vector<std::tuple<int, double, double, double>> tracks; // ID and position, by ID
+        std::vector<int> inventory;                                  // Missile IDs, sorted
+        std::vector<std::tuple<int, int, int>> flights;              // ID, target enemy, step; by ID
+
+        bool operator==(const WorldState &other) const
+        {
+            return tracks == other.tracks && inventory == other.inventory && flights == other.flights;
+        }
+    };
+
+    WorldState capture(const TrackStore &enemies, const MissileController &controller)
+    {
+        WorldState state;
+        for (size_t i = 0; i < enemies.size(); ++i)
+        {
+            Position position = enemies.positionAt(i);
+            state.tracks.emplace_back(enemies.idAt(i), position.x, position.y, position.z);
+        }
+        for (const Missile &missile : controller.getMissiles())
+        {
+            state.inventory.push_back(missile.getId());
+        }
+        for (const Missile &missile : controller.getInFlightMissiles())
+        {
+            state.flights.emplace_back(missile.getId(), missile.getTargetEnemyId(), missile.getFlightStep());
+        }
+        std::sort(state.tracks.begin(), state.tracks.end());
+        std::sort(state.inventory.begin(), state.inventory.end());
+        std::sort(state.flights.begin(), state.flights.end());
+        return state;
+    }
+}
+
+int main()
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "norad_test_tick_recorder.rec").string();
+    const long ticks = 60;
+
+    // A salvo big enough that interceptors launch, fly and arrive along the way
+    std::map<long, WorldState> recorded;
+    {
+        Simulation sim(Scenario::makeSalvo(200, 40));
+        MissileController &controller = sim.getController();
+        controller.setVerbose(false);
+        controller.setAutoIntercept(true);
+        controller.setMaxAutoInterceptMissiles(40);
+        sim.startRecording(path, 16);
+        for (long i = 0; i < ticks; ++i)
+        {
+            sim.tick();
+            recorded[sim.getStats().ticks] = capture(sim.getEnemies(), controller);
+        }
+        sim.stopRecording();
+    }
+
+    // The run must have exercised launches, flights and kills for the replay to prove anything
+    bool sawFlights = std::any_of(recorded.begin(), recorded.end(),
+                                  [](const auto &entry) { return !entry.second.flights.empty(); });
+    const WorldState &last = recorded.rbegin()->second;
+    CHECK(sawFlights);
+    CHECK(last.inventory.size() + last.flights.size() < 40);
+    CHECK(last.tracks.size() < recorded.begin()->second.tracks.size());
+
+    {
+        TickReplayer replayer(path);
+        CHECK(replayer.getFrameCount() == static_cast<size_t>(ticks));
+        CHECK(replayer.getKeyframeCount() > 1);
+
+        long frames = 0;
+        while (replayer.next())
+        {
+            ++frames;
+            auto expected = recorded.find(replayer.getTick());
+            CHECK(expected != recorded.end());
+            if (expected != recorded.end())
+            {
+                CHECK(capture(replayer.getEnemies(), replayer.getController()) == expected->second);
+            }
+        }
+        CHECK(frames == ticks);
+        CHECK(replayer.getTick() == replayer.getLastTick());
+
+        // Seeking lands on a keyframe before the tick and rolls forward to it
+        for (long tick : {replayer.getFirstTick() + 37, replayer.getFirstTick() + 5, replayer.getLastTick()})
+        {
+            replayer.seek(tick);
+            CHECK(replayer.getTick() == tick);
+            CHECK(capture(replayer.getEnemies(), replayer.getController()) == recorded[tick]);
+        }
+    }
+
+    std::remove(path.c_str());
+    return TEST_RESULT();
+}
@@ -0,0 +1,108 @@
+// WeaponTargetAssigner: on small matrices the auction's total matches the
+// brute-force optimum (integer costs, so the epsilon bound of cols * epsilon,
+// well below 1, leaves no room for a worse assignment), and every row gets a
+// distinct column
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "weapon_target_assignment.h"
+#include "test_check.h"
+
+namespace
+{
+    // Cheapest total over every way of giving each row its own column
+    double bruteForce(const std::vector<double> &costs, size_t rows, size_t cols)
+    {
+        std::vector<size_t> order(cols);
+        std::iota(order.begin(), order.end(), 0);
+        double best = std::numeric_limits<double>::max();
+        do
+        {
+            double total = 0.0;
+            for (size_t row = 0; row < rows; ++row)
+            {
+                total += costs[row * cols + order[row]];
+            }
+            best = std::min(best, total);
+        } while (std::next_permutation(order.begin(), order.end()));
+        return best;
+    }
+
+    bool isMatching(const WeaponTargetAssigner &assigner, size_t rows, size_t cols)
+    {
+        const auto &assignments = assigner.getAssignments();
+        if (assignments.size() != rows)
+        {
+            return false;
+        }
+        std::vector<bool> rowSeen(rows, false), colSeen(cols, false);
+        for (const auto &assignment : assignments)
+        {
+            if (assignment.row >= rows || assignment.col >= cols || rowSeen[assignment.row] || colSeen[assignment.col])
+            {
+                return false;
+            }
+            rowSeen[assignment.row] = colSeen[assignment.col] = true;
+        }
+        return true;
+    }
+
+    void auctionMatchesBruteForce()
+    {
+        std::mt19937 rng(12345);
+        std::uniform_int_distribution<int> cost(1, 100);
+        WeaponTargetAssigner assigner;
+
+        for (int trial = 0; trial < 300; ++trial)
+        {
+            size_t cols = 1 + trial % 7;
+            size_t rows = 1 + (trial / 7) % cols;
+            std::vector<double> costs(rows * cols);
+            for (double &c : costs)
+            {
+                c = cost(rng);
+            }
+
+            double optimum = bruteForce(costs, rows, cols);
+            assigner.solve(costs.data(), rows, cols, std::chrono::microseconds::max());
+            CHECK(!assigner.timedOut());
+            CHECK(isMatching(assigner, rows, cols));
+            CHECK(assigner.getTotalCost() == optimum);
+
+            assigner.solveGreedy(costs.data(), rows, cols);
+            CHECK(isMatching(assigner, rows, cols));
+            CHECK(assigner.getTotalCost() >= optimum);
+        }
+    }
+
+    void greedyIsNotOptimalWhereAuctionIs()
+    {
+        // Row 0 grabs column 0 greedily and leaves row 1 the expensive one
+        const double costs[] = {1, 2,
+                                1, 100};
+        WeaponTargetAssigner assigner;
+        assigner.solveGreedy(costs, 2, 2);
+        CHECK(assigner.getTotalCost() == 101);
+        assigner.solve(costs, 2, 2, std::chrono::microseconds::max());
+        CHECK(assigner.getTotalCost() == 3);
+    }
+
+    void emptyProblem()
+    {
+        WeaponTargetAssigner assigner;
+        double unused = 0;
+        assigner.solve(&unused, 0, 1, std::chrono::microseconds::max());
+        CHECK(assigner.getAssignments().empty());
+    }
+}
+
+int main()
+{
+    auctionMatchesBruteForce();
+    greedyIsNotOptimalWhereAuctionIs();
+    emptyProblem();
+    return TEST_RESULT();
+}
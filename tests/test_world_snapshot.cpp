@@ -0,0 +1,181 @@
+// Shared-memory world snapshot: a reader sees exactly what was published,
+// a writer that laps the reader (gets two frames ahead, back onto the frame
+// being read) forces a retry that lands on the newest frame, and a reader
+// racing a writer thread never returns a torn frame
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "world_publisher.h"
+#include "world_snapshot.h"
+#include "test_check.h"
+
+namespace
+{
+    const size_t TRACKS = 500;
+
+    // Every track starts at the origin and flies the same line at 1 m per
+    // tick, so in a consistent frame all positions equal the frame's tick
+    TrackStore lockstepTracks()
+    {
+        TrackStore tracks;
+        for (size_t i = 0; i < TRACKS; ++i)
+        {
+            tracks.add(EnemyMissile(static_cast<int>(i), {0, 0, 0}, {1e12, 0, 0}, 1.0));
+        }
+        return tracks;
+    }
+
+    bool consistent(const WorldSnapshotView &view)
+    {
+        if (view.trackCount != TRACKS)
+        {
+            return false;
+        }
+        for (size_t i = 0; i < view.trackCount; ++i)
+        {
+            if (view.tracks[i].position.x != static_cast<double>(view.tick))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::string regionName(const char *suffix)
+    {
+        return std::string("/norad-test-") + std::to_string(::getpid()) + "-" + suffix;
+    }
+
+    void readsWhatWasPublished()
+    {
+        TrackStore tracks = lockstepTracks();
+        std::vector<Target> targets;
+        std::vector<ThreatReport> threats;
+        std::vector<Missile> none;
+        WorldPublisher publisher(regionName("basic"), {0, 0, 0}, targets, TRACKS, 0);
+        WorldSnapshotReader reader(publisher.getName());
+
+        CHECK(!reader.read([](const WorldSnapshotView &) {}));
+
+        tracks.moveAll();
+        publisher.publish(1, tracks, threats, none, none);
+        long tick = -1;
+        bool ok = false;
+        CHECK(reader.read([&](const WorldSnapshotView &view)
+                          { tick = view.tick; ok = consistent(view) && !view.truncated; }));
+        CHECK(tick == 1 && ok);
+        CHECK(reader.framesPublished() == 1);
+        CHECK(reader.getRetries() == 0);
+    }
+
+    void writerLappingTheReaderForcesARetry()
+    {
+        TrackStore tracks = lockstepTracks();
+        std::vector<Target> targets;
+        std::vector<ThreatReport> threats;
+        std::vector<Missile> none;
+        WorldPublisher publisher(regionName("lap"), {0, 0, 0}, targets, TRACKS, 0);
+        WorldSnapshotReader reader(publisher.getName());
+        long tick = 0;
+        auto publishNext = [&]()
+        {
+            tracks.moveAll();
+            publisher.publish(++tick, tracks, threats, none, none);
+        };
+        publishNext();
+
+        // One frame during the read goes to the other buffer: nothing to retry
+        int visits = 0;
+        long seen = -1;
+        auto oneFrameBehind = [&](const WorldSnapshotView &view)
+        {
+            if (visits++ == 0)
+            {
+                publishNext();
+            }
+            seen = view.tick;
+        };
+        CHECK(reader.read(oneFrameBehind));
+        CHECK(visits == 1 && seen == 1);
+        CHECK(reader.getRetries() == 0);
+
+        // Two frames during the read overwrite the one being read: the
+        // sequence moved, the read starts over on the newest frame
+        visits = 0;
+        bool ok = false;
+        auto lapped = [&](const WorldSnapshotView &view)
+        {
+            if (visits++ == 0)
+            {
+                publishNext();
+                publishNext();
+            }
+            seen = view.tick;
+            ok = consistent(view);
+        };
+        CHECK(reader.read(lapped));
+        CHECK(visits == 2);
+        CHECK(seen == tick && ok);
+        CHECK(reader.getRetries() == 1);
+
+        // Many laps later the frame counters are still even and the reader follows
+        for (int i = 0; i < 1001; ++i)
+        {
+            publishNext();
+        }
+        CHECK(reader.read([&](const WorldSnapshotView &view) { seen = view.tick; }));
+        CHECK(seen == tick);
+        CHECK(reader.framesPublished() == static_cast<uint64_t>(tick));
+    }
+
+    void concurrentReaderNeverSeesATornFrame()
+    {
+        TrackStore tracks = lockstepTracks();
+        std::vector<Target> targets;
+        std::vector<ThreatReport> threats;
+        std::vector<Missile> none;
+        WorldPublisher publisher(regionName("race"), {0, 0, 0}, targets, TRACKS, 0);
+        WorldSnapshotReader reader(publisher.getName());
+        tracks.moveAll();
+        publisher.publish(1, tracks, threats, none, none);
+
+        std::atomic<bool> done{false};
+        auto write = [&]()
+        {
+            for (long tick = 2; tick <= 20000; ++tick)
+            {
+                tracks.moveAll();
+                publisher.publish(tick, tracks, threats, none, none);
+            }
+            done = true;
+        };
+        std::thread writer(write);
+
+        long reads = 0, torn = 0, last = 0, backwards = 0;
+        while (!done)
+        {
+            long tick = 0;
+            bool ok = false;
+            reader.read([&](const WorldSnapshotView &view)
+                        { tick = view.tick; ok = consistent(view); });
+            ++reads;
+            torn += !ok;
+            backwards += tick < last;
+            last = tick;
+        }
+        writer.join();
+        CHECK(reads > 0);
+        CHECK(torn == 0);
+        CHECK(backwards == 0);
+    }
+}
+
+int main()
+{
+    readsWhatWasPublished();
+    writerLappingTheReaderForcesARetry();
+    concurrentReaderNeverSeesATornFrame();
+    return TEST_RESULT();
+}
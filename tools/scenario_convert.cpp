@@ -0,0 +1,34 @@
+// Converts a text scenario (see Scenario::loadText) into the binary format
+// the simulator maps at startup.
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include "scenario.h"
+
+int main(int argc, char *argv[])
+{
+    if (argc != 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <scenario.txt> <scenario.nsc>\n";
+        return 1;
+    }
+
+    try
+    {
+        auto start = std::chrono::steady_clock::now();
+        Scenario scenario = Scenario::loadText(argv[1]);
+        scenario.saveBinary(argv[2]);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "Wrote " << argv[2] << ": " << scenario.pads.size() << " pads, "
+                  << scenario.interceptors.size() << " interceptors, "
+                  << scenario.targets.size() << " targets, "
+                  << scenario.trackCount() << " tracks (" << seconds << " s)\n";
+    }
+    catch (const std::exception &error)
+    {
+        std::cerr << "Error: " << error.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
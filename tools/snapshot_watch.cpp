@@ -0,0 +1,181 @@
+// Sample consumer of the shared-memory world snapshot: maps the region a
+// simulator run with --publish writes, and prints a one-line summary of the
+// newest tick at a fixed interval until the simulator exits. Links only the
+// snapshot reader library, not the simulation core.
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include "world_snapshot.h"
+
+namespace
+{
+    // What one sample prints, derived inside the read callback
+    struct Summary
+    {
+        long tick = 0;
+        size_t tracks = 0;
+        size_t threats = 0;
+        size_t ready = 0;
+        size_t inFlight = 0;
+        bool truncated = false;
+        int soonestThreat = -1;
+        int soonestTarget = -1;
+        double soonestTime = std::numeric_limits<double>::infinity();
+    };
+
+    Summary summarize(const WorldSnapshotView &view)
+    {
+        Summary summary;
+        summary.tick = view.tick;
+        summary.tracks = view.trackCount;
+        summary.threats = view.threatCount;
+        summary.truncated = view.truncated;
+        for (size_t i = 0; i < view.threatCount; ++i)
+        {
+            const world_snapshot::ThreatRecord &threat = view.threats[i];
+            if (threat.timeToImpact < summary.soonestTime)
+            {
+                summary.soonestTime = threat.timeToImpact;
+                summary.soonestThreat = threat.detectionId;
+                summary.soonestTarget = threat.targetId;
+            }
+        }
+        for (size_t i = 0; i < view.interceptorCount; ++i)
+        {
+            if (view.interceptors[i].state == world_snapshot::INTERCEPTOR_IN_FLIGHT)
+            {
+                ++summary.inFlight;
+            }
+            else
+            {
+                ++summary.ready;
+            }
+        }
+        return summary;
+    }
+
+    std::string targetName(const WorldSnapshotReader &reader, int id)
+    {
+        for (size_t i = 0; i < reader.targetCount(); ++i)
+        {
+            if (reader.targets()[i].id == id)
+            {
+                return reader.targets()[i].name;
+            }
+        }
+        return "unknown target";
+    }
+
+    // The simulator may not have created the region yet
+    std::unique_ptr<WorldSnapshotReader> open(const std::string &name, std::chrono::seconds patience)
+    {
+        auto deadline = std::chrono::steady_clock::now() + patience;
+        while (true)
+        {
+            try
+            {
+                return std::make_unique<WorldSnapshotReader>(name);
+            }
+            catch (const std::runtime_error &)
+            {
+                if (std::chrono::steady_clock::now() >= deadline)
+                {
+                    throw;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            }
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::string name = world_snapshot::DEFAULT_NAME;
+    long intervalMs = 500;
+    long maxSamples = -1;
+    for (int i = 1; i < argc; ++i)
+    {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--interval") == 0 && hasValue)
+        {
+            intervalMs = std::atol(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--samples") == 0 && hasValue)
+        {
+            maxSamples = std::atol(argv[++i]);
+        }
+        else if (argv[i][0] == '/')
+        {
+            name = argv[i];
+        }
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [/shm-name] [--interval MS] [--samples N]\n"
+                      << "  Default name " << world_snapshot::DEFAULT_NAME << ", interval 500 ms, until the simulator exits\n";
+            return 1;
+        }
+    }
+
+    try
+    {
+        std::unique_ptr<WorldSnapshotReader> reader = open(name, std::chrono::seconds(10));
+        const world_snapshot::Header &header = reader->header();
+        std::cout << "Watching " << name << " (pid " << header.writerPid << "): " << reader->targetCount()
+                  << " targets, room for " << header.trackCapacity << " tracks and "
+                  << header.interceptorCapacity << " interceptors, origin " << std::fixed << std::setprecision(4)
+                  << header.originLatitude << ", " << header.originLongitude << "\n";
+
+        long lastTick = -1;
+        for (long samples = 0; maxSamples < 0 || samples < maxSamples; ++samples)
+        {
+            Summary summary;
+            bool alive = reader->writerAlive();
+            if (reader->read([&](const WorldSnapshotView &view)
+                             { summary = summarize(view); }) &&
+                summary.tick != lastTick)
+            {
+                lastTick = summary.tick;
+                std::cout << "tick " << std::setw(6) << summary.tick
+                          << "  tracks " << std::setw(9) << summary.tracks
+                          << "  threats " << std::setw(9) << summary.threats
+                          << "  interceptors " << summary.ready << " ready, " << summary.inFlight << " in flight";
+                if (summary.soonestThreat >= 0)
+                {
+                    std::cout << "  next impact: threat #" << summary.soonestThreat << " on "
+                              << targetName(*reader, summary.soonestTarget) << " in ";
+                    if (std::isfinite(summary.soonestTime))
+                    {
+                        std::cout << std::setprecision(1) << summary.soonestTime << " ticks";
+                    }
+                    else
+                    {
+                        std::cout << "never";
+                    }
+                }
+                std::cout << (summary.truncated ? "  (truncated)" : "") << "\n";
+            }
+            // Print the final tick before giving up on a simulator that exited
+            if (!alive)
+            {
+                std::cout << "Simulator exited after " << reader->framesPublished() << " frames\n";
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+        }
+        std::cout << "Reads retried: " << reader->getRetries() << "\n";
+    }
+    catch (const std::exception &error)
+    {
+        std::cerr << "Error: " << error.what() << "\n";
+        return 1;
+    }
+    return 0;
+}